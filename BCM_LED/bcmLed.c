@@ -0,0 +1,69 @@
+//===========================================================================================
+// Project: ATmega32A Eight Dimmed LEDs with Binary Code Modulation
+// Compiler: avr-gcc
+// Target microcontroller: ATmega32A
+// Description: Eight LEDs on PORTB show a bright spot with a fading tail that sweeps back and
+//              forth. Every pin gets its own 8-bit brightness from bcm.h: Timer0 raises eight
+//              compare interrupts per frame, each writing one precomputed PORTB byte, so the
+//              CPU cost does not depend on how many pins are dimmed. The main loop only
+//              recomputes the pattern; the frame counter doubles as its clock.
+// Date created: 2026-10-16
+//===========================================================================================
+
+//============================================Libraries========================================
+#include <avr/io.h>        // Provides definitions for ATmega32A I/O registers
+#include <avr/interrupt.h> // Provides definitions for interrupt handling
+
+//============================================Defines========================================
+#define F_CPU 8000000UL      // CPU frequency set to 8 MHz
+#define framesPerStep 20     // Frames between two positions of the spot (about 80 ms)
+
+#include "../Library/bcm.h" // Bit-plane PWM on PORTB
+
+//============================================Global Variables========================================
+// Brightness of the spot and its tail, by distance from the spot
+static const uint8_t tail[8] = { 255, 96, 32, 10, 3, 1, 0, 0 };
+
+//============================================Interrupt Service Routines (ISRs)========================================
+// Timer0 Compare Match ISR, once per bit-plane
+ISR(TIMER0_COMP_vect) {
+    bcmTick();
+}
+
+//============================================Main Code========================================
+int main(void)
+{
+    uint8_t levels[8];
+    uint8_t position = 0;
+    int8_t direction = 1;
+    uint16_t next;
+
+    bcmInit(); // All eight pins dark
+    sei();     // Enable global interrupts
+
+    next = bcmFrames;
+    while (1)
+    {
+        // bcmFrames is 16 bits and written by the ISR: read it with interrupts off
+        cli();
+        uint16_t now = bcmFrames;
+        sei();
+        if ((int16_t)(now - next) < 0) {
+            continue;
+        }
+        next += framesPerStep;
+
+        for (uint8_t pin = 0; pin < 8; pin++) {
+            uint8_t distance = pin > position ? pin - position : position - pin;
+            levels[pin] = tail[distance];
+        }
+        while (!bcmSet(levels)) {
+            // Previous pattern not shown yet; at most one frame
+        }
+
+        if ((position == 7 && direction > 0) || (position == 0 && direction < 0)) {
+            direction = -direction;
+        }
+        position += direction;
+    }
+}
@@ -9,25 +9,22 @@
 //==========================================================================================
 #define F_CPU 1000000UL  // Define CPU frequency as 1 MHz
 
-// Define memory-mapped I/O addresses for PORTB and DDRB
-#define PORTB (*(volatile unsigned char *)0x38)  // Data Register for Port B
-#define DDRB  (*(volatile unsigned char *)0x37)  // Data Direction Register for Port B
+// Memory-mapped I/O registers come from <avr/io.h>:
+// PORTB is at 0x38 and DDRB at 0x37 (data-space addresses)
+#include <avr/io.h>
+#include "../Library/delay.h"  // Cycle-exact delays computed from F_CPU
+#include "../Library/pin.h"    // Compile-time pins: single sbi/cbi instructions
 
-// Software delay function in milliseconds (approximate)
-void delay_ms(unsigned int time){
-    for(unsigned int i = 0; i < time; i++) {
-        for(volatile unsigned int j = 0; j < 50; j++);  // Inner loop creates the delay
-    }
-}
+PIN_DEFINE(Led, B, 1) // LED on PB1
 
 int main(void){
 
-    DDRB |= (1 << 1);     // Set pin PB1 as output
+    LedOutput();          // Set pin PB1 as output (sbi DDRB, 1)
     PORTB = 0x00;         // Clear all pins on PORTB (initial state: all LOW)
 
     while(1) {            // Infinite loop
-        PORTB ^= (1 << 1);    // Toggle the state of PB1 (HIGH -> LOW or LOW -> HIGH)
-        delay_ms(500);        // Delay for ~500 milliseconds
+        LedToggle();          // Toggle the state of PB1 (HIGH -> LOW or LOW -> HIGH)
+        delayMs(500);         // Delay for exactly 500 ms (500000 cycles at 1 MHz)
     }
 
     return 0; // This line will never be reached
@@ -0,0 +1,28 @@
+//===========================================================================================
+// Project: ATmega32A Host HAL
+// Compiler: gcc (host, C99)
+// Target microcontroller: none (Linux host standing in for the ATmega32A)
+// Description: Host stand-in for <avr/interrupt.h>. ISR(vector) defines an ordinary function
+//              named after the vector, which hostAdvance() calls; sei() and cli() set and clear
+//              the I bit of the virtual SREG.
+// Date created: 2026-10-16
+//===========================================================================================
+#ifndef HOST_AVR_INTERRUPT_H
+#define HOST_AVR_INTERRUPT_H
+
+//============================================Libraries========================================
+#include <avr/io.h>
+
+//============================================Defines========================================
+#define ISR(vector, ...)           \
+    void vector(void);             \
+    void vector(void)
+#define EMPTY_INTERRUPT(vector) ISR(vector) {}
+#define ISR_BLOCK
+#define ISR_NOBLOCK
+
+#define sei()  (SREG |= (1 << SREG_I))
+#define cli()  (SREG &= ~(1 << SREG_I))
+#define reti() return
+
+#endif // HOST_AVR_INTERRUPT_H
@@ -0,0 +1,22 @@
+//===========================================================================================
+// Project: ATmega32A Host HAL
+// Compiler: gcc (host, C99)
+// Target microcontroller: none (Linux host standing in for the ATmega32A)
+// Description: Host stand-in for <avr/pgmspace.h>: the host has one address space, so
+//              PROGMEM data is ordinary const data and the readers are plain loads.
+// Date created: 2026-10-16
+//===========================================================================================
+#ifndef HOST_AVR_PGMSPACE_H
+#define HOST_AVR_PGMSPACE_H
+
+//============================================Libraries========================================
+#include <stdint.h>
+
+//============================================Defines========================================
+#define PROGMEM
+#define PSTR(s)             (s)
+#define pgm_read_byte(addr)  (*(const uint8_t*)(addr))
+#define pgm_read_word(addr)  (*(const uint16_t*)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t*)(addr))
+
+#endif // HOST_AVR_PGMSPACE_H
@@ -0,0 +1,34 @@
+//===========================================================================================
+// Project: ATmega32A Host HAL
+// Compiler: gcc (host, C99)
+// Target microcontroller: none (Linux host standing in for the ATmega32A)
+// Description: Host stand-in for <avr/sleep.h>. The mode bits go to the virtual MCUCR;
+//              sleep_cpu() lets virtual time pass until an interrupt has been serviced.
+// Date created: 2026-10-16
+//===========================================================================================
+#ifndef HOST_AVR_SLEEP_H
+#define HOST_AVR_SLEEP_H
+
+//============================================Libraries========================================
+#include <avr/io.h>
+
+//============================================Defines========================================
+#define SLEEP_MODE_IDLE         0
+#define SLEEP_MODE_ADC          (1 << SM0)
+#define SLEEP_MODE_PWR_DOWN     (1 << SM1)
+#define SLEEP_MODE_PWR_SAVE     ((1 << SM0) | (1 << SM1))
+#define SLEEP_MODE_STANDBY      ((1 << SM1) | (1 << SM2))
+#define SLEEP_MODE_EXT_STANDBY  ((1 << SM0) | (1 << SM1) | (1 << SM2))
+
+#define set_sleep_mode(mode) (MCUCR = (MCUCR & ~((1 << SM0) | (1 << SM1) | (1 << SM2))) | (mode))
+#define sleep_enable()       (MCUCR |= (1 << SE))
+#define sleep_disable()      (MCUCR &= ~(1 << SE))
+#define sleep_cpu()          hostSleep()
+#define sleep_mode()                                                                    \
+    do {                                                                                \
+        sleep_enable();                                                                 \
+        sleep_cpu();                                                                    \
+        sleep_disable();                                                                \
+    } while (0)
+
+#endif // HOST_AVR_SLEEP_H
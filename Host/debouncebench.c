@@ -0,0 +1,204 @@
+//===========================================================================================
+// Project: ATmega32A Host HAL
+// Compiler: gcc (host, C99)
+// Target microcontroller: none (Linux host standing in for the ATmega32A)
+// Description: Debounce microbenchmark. Compiles deBouncd_Button.c natively against the host
+//              HAL and feeds it a synthetic button, 1 ms per sample: a press every 300 ms, held
+//              for 120 ms, with 5 ms of random bounce on both edges. Three figures, each the
+//              best of several runs:
+//
+//                updateButton()        the example's debouncer called directly
+//                portDebounceUpdate()  Library/portdebounce.h on the same samples (bit 6)
+//                TIMER0_COMP_vect      the whole 1 ms tick (debounce, gestures, event queue)
+//                                      reached through hostAdvance() and the host Timer0
+//
+//              along with the presses each one detected, so a change to the algorithm shows
+//              its speed and its verdict side by side before it is tried on the target (and
+//              with exact cycle counts in Simulator/bouncebench).
+// Usage:   ./debouncebench [-n updates] [-t ticks] [-r runs] [-s seed]   (make bench)
+// Date created: 2026-10-16
+//===========================================================================================
+
+//============================================Libraries========================================
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// The example as it is; its main() never returns, so the harness drives it instead
+#define main firmwareMain
+#include "../deBounce_Button/deBouncd_Button.c"
+#undef main
+#include "../Library/portdebounce.h"
+
+//============================================Defines========================================
+#define PERIOD_MS 300 // One press per period
+#define HOLD_MS   120 // Held this long, bounce included
+#define BOUNCE_MS 5   // Random samples after each edge
+#define PATTERN   (PERIOD_MS * 64) // Samples generated, replayed as often as needed
+
+struct BenchResult
+{
+    double seconds;    // Best host time
+    unsigned long presses;
+};
+
+//============================================Functions========================================
+static void usage(const char* prog)
+{
+    fprintf(stderr, "usage: %s [-n updates] [-t ticks] [-r runs] [-s seed]\n"
+                    "defaults: 20000000 updates, 1000000 ticks, best of 3 runs\n", prog);
+    exit(2);
+}
+
+static double hostSeconds(void)
+{
+    struct timespec t;
+
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+// Button level per millisecond (1 = pressed), bouncing for BOUNCE_MS after every edge
+static void makeInput(uint8_t* in, uint64_t seed)
+{
+    uint64_t rng = seed | 1;
+
+    for (int i = 0; i < PATTERN; i++) {
+        int t = i % PERIOD_MS;
+        uint8_t level = t < HOLD_MS;
+
+        if ((t < BOUNCE_MS) || (t >= HOLD_MS && t < HOLD_MS + BOUNCE_MS)) {
+            rng ^= rng << 13; // xorshift64
+            rng ^= rng >> 7;
+            rng ^= rng << 17;
+            level = rng & 1;
+        }
+        in[i] = level;
+    }
+}
+
+static unsigned long runUpdateButton(const uint8_t* in, unsigned long n)
+{
+    unsigned long presses = 0;
+    unsigned long now = 0;
+    int j = 0;
+
+    initButton(&Button1, delayTime);
+    while (now < n) {
+        presses += updateButton(&Button1, in[j], now) == BUTTON_PRESSED;
+        now++;
+        if (++j == PATTERN) {
+            j = 0;
+        }
+    }
+    return presses;
+}
+
+static unsigned long runPortDebounce(const uint8_t* in, unsigned long n)
+{
+    struct PortDebouncer deb;
+    unsigned long presses = 0;
+    int j = 0;
+
+    portDebounceInit(&deb, 0);
+    for (unsigned long i = 0; i < n; i++) {
+        portDebounceUpdate(&deb, (uint8_t)(in[j] << PD6));
+        presses += deb.pressed != 0;
+        if (++j == PATTERN) {
+            j = 0;
+        }
+    }
+    return presses;
+}
+
+// The firmware's own start-up, minus the USART trace, then one hostAdvance() per millisecond
+static unsigned long runTicks(const uint8_t* in, unsigned long n)
+{
+    unsigned long presses = 0;
+    uint8_t events;
+    int j = 0;
+
+    hostReset();
+    memset(&ButtonEvents, 0, sizeof(ButtonEvents));
+    millisCounter = 0;
+    initTimer0();
+    ButtonInputPullup();
+    initButton(&Button1, delayTime);
+    gestureInit(&Button1Gesture, &ButtonTiming);
+    LedOutput();
+    LedLow();
+    sei();
+    for (unsigned long i = 0; i < n; i++) {
+        hostSetPin('D', PD6, !in[j]); // Active-low
+        hostAdvance(F_CPU / 1000);
+        while (eventQueuePop(&ButtonEvents, &events)) {
+            presses += (events & GESTURE_PRESS) != 0;
+        }
+        if (++j == PATTERN) {
+            j = 0;
+        }
+    }
+    return presses;
+}
+
+static struct BenchResult best(unsigned long (*run)(const uint8_t*, unsigned long),
+                               const uint8_t* in, unsigned long n, int runs)
+{
+    struct BenchResult r = { -1, 0 };
+
+    for (int i = 0; i < runs; i++) {
+        double start = hostSeconds();
+        unsigned long presses = run(in, n);
+        double t = hostSeconds() - start;
+
+        if (r.seconds < 0 || t < r.seconds) {
+            r.seconds = t;
+        }
+        r.presses = presses;
+    }
+    if (r.seconds < 1e-9) {
+        r.seconds = 1e-9;
+    }
+    return r;
+}
+
+static void report(const char* name, struct BenchResult r, unsigned long n)
+{
+    printf("%-22s %10lu %8.3f %11.1f %9lu\n", name, n, r.seconds, n / r.seconds * 1e-6,
+           r.presses);
+}
+
+int main(int argc, char** argv)
+{
+    static uint8_t in[PATTERN];
+    unsigned long updates = 20000000;
+    unsigned long ticks = 1000000;
+    uint64_t seed = 1;
+    int runs = 3;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:t:r:s:")) != -1) {
+        switch (opt) {
+        case 'n': updates = strtoul(optarg, NULL, 0); break;
+        case 't': ticks = strtoul(optarg, NULL, 0); break;
+        case 'r': runs = atoi(optarg); break;
+        case 's': seed = strtoull(optarg, NULL, 0); break;
+        default: usage(argv[0]);
+        }
+    }
+    if (optind != argc || runs < 1) {
+        usage(argv[0]);
+    }
+
+    makeInput(in, seed);
+    printf("%lu presses per %lu samples, %d ms bounce, seed %llu\n", updates / PERIOD_MS,
+           updates, BOUNCE_MS, (unsigned long long)seed);
+    printf("%-22s %10s %8s %11s %9s\n", "benchmark", "updates", "host s", "M updates/s",
+           "presses");
+    report("updateButton()", best(runUpdateButton, in, updates, runs), updates);
+    report("portDebounceUpdate()", best(runPortDebounce, in, updates, runs), updates);
+    report("TIMER0_COMP_vect", best(runTicks, in, ticks, runs), ticks);
+    return 0;
+}
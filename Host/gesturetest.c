@@ -0,0 +1,238 @@
+//===========================================================================================
+// Project: ATmega32A Host HAL
+// Compiler: gcc (host, C99)
+// Target microcontroller: none (Linux host standing in for the ATmega32A)
+// Description: Gesture timing test. Compiles deBouncd_Button.c natively against the host HAL
+//              and replays bounce waveforms on PD6: edge lists with microsecond times, in the
+//              shape of scope captures of a tactile switch (bursts of sub-millisecond bounce,
+//              glitches). The pin changes between the 1 ms ticks and the firmware's own
+//              TIMER0_COMP_vect samples it, debounces it (updateButton(), 50 ms), runs the
+//              gesture engine (Library/gesture.h) and posts to the event queue. Every event
+//              must come out with the expected GESTURE_* bits at the expected millisCounter
+//              value, to the millisecond.
+//
+//              The expected times follow from the sampling instants: with TCNT0 cleared at
+//              start-up, OCF0 is set on the timer clock that clears TCNT0 (as on the
+//              hardware), so tick k runs at exactly k ms and stores k in millisCounter. An edge
+//              is debounced 50 ticks after the last tick that saw the level change, and the
+//              gesture events are counted in ticks from there (ButtonTiming: long press 600,
+//              double-click window 250, repeat 400 shortened by 50 down to 50).
+// Usage:   ./gesturetest   (make test); exit status 1 on any mismatch
+// Date created: 2026-10-16
+//===========================================================================================
+
+//============================================Libraries========================================
+#include <stdio.h>
+#include <string.h>
+
+// The example as it is; its main() never returns, so the harness drives it instead
+#define main firmwareMain
+#include "../deBounce_Button/deBouncd_Button.c"
+#undef main
+
+//============================================Defines========================================
+#define END UINT32_MAX // Terminates edge and event lists
+#define MAX_EVENTS 64
+
+struct WaveEdge
+{
+    uint32_t us;     // Time since reset in microseconds
+    uint8_t pressed; // Level from then on (1 = pressed, PD6 low)
+};
+
+struct Expected
+{
+    uint32_t ms;     // millisCounter of the tick that posts the event
+    uint8_t events;  // GESTURE_* bits
+};
+
+struct Scenario
+{
+    const char* name;
+    const struct WaveEdge* wave;
+    const struct Expected* expect;
+    uint32_t endMs;  // Replay length
+};
+
+//============================================Waveforms========================================
+// Short press. Ticks 101 and 102 (at 101 and 102 ms) see the bounce released again. The last
+// bounce edge comes 4 us before tick 103, which sees the press: PRESS at 103 + 50. A tick one
+// timer clock (8 us) early would only see it at 104. The release bounce ends before tick 252:
+// RELEASE at 302, and CLICK when the double-click window runs out 250 ms later.
+static const struct WaveEdge clickWave[] = {
+    { 100500, 1 }, { 100800, 0 }, { 101200, 1 }, { 101900, 0 }, { 102996, 1 },
+    { 250500, 0 }, { 250700, 1 }, { 251300, 0 },
+    { END, 0 }
+};
+static const struct Expected clickExpect[] = {
+    { 153, GESTURE_PRESS },
+    { 302, GESTURE_RELEASE },
+    { 552, GESTURE_CLICK },
+    { END, 0 }
+};
+
+// Two presses. The first is sampled pressed from tick 1001 on. The second one is first seen
+// by tick 1203 (its bounce releases at 1200.6 ms and settles at 1202.5 ms), so it is accepted
+// at 1253, 102 ms into the double-click window, and its release completes the double click.
+static const struct WaveEdge doubleWave[] = {
+    { 1000500, 1 }, { 1001300, 0 }, { 1001700, 1 },
+    { 1100500, 0 },
+    { 1200500, 1 }, { 1200600, 0 }, { 1202500, 1 },
+    { 1300500, 0 },
+    { END, 0 }
+};
+static const struct Expected doubleExpect[] = {
+    { 1051, GESTURE_PRESS },
+    { 1151, GESTURE_RELEASE },
+    { 1253, GESTURE_PRESS },
+    { 1351, GESTURE_RELEASE | GESTURE_DOUBLE_CLICK },
+    { END, 0 }
+};
+
+// Held for 2.5 s. A 200 us glitch between two ticks is never sampled; the one from 2400.9 to
+// 2401.1 ms is (by tick 2401 at 2401 ms) but lasts one tick, far short of the debounce delay. LONG_PRESS 600 ms after the
+// press, then REPEAT after 400, 350, ... 100 ms and every 50 ms from there until the release.
+static const struct WaveEdge holdWave[] = {
+    { 2000500, 1 },
+    { 2300500, 0 }, { 2300700, 1 },
+    { 2400900, 0 }, { 2401100, 1 },
+    { 4480500, 0 },
+    { END, 0 }
+};
+static const struct Expected holdExpect[] = {
+    { 2051, GESTURE_PRESS },
+    { 2651, GESTURE_LONG_PRESS },
+    { 3051, GESTURE_REPEAT },
+    { 3401, GESTURE_REPEAT },
+    { 3701, GESTURE_REPEAT },
+    { 3951, GESTURE_REPEAT },
+    { 4151, GESTURE_REPEAT },
+    { 4301, GESTURE_REPEAT },
+    { 4401, GESTURE_REPEAT },
+    { 4451, GESTURE_REPEAT },
+    { 4501, GESTURE_REPEAT },
+    { 4531, GESTURE_RELEASE },
+    { END, 0 }
+};
+
+// Contact chatter: 40 ms of edges every 1.5 ms, then released. The level never stays put for
+// 50 ms, so nothing is reported.
+static const struct WaveEdge chatterWave[] = {
+    { 300200, 1 }, { 301700, 0 }, { 303200, 1 }, { 304700, 0 }, { 306200, 1 }, { 307700, 0 },
+    { 309200, 1 }, { 310700, 0 }, { 312200, 1 }, { 313700, 0 }, { 315200, 1 }, { 316700, 0 },
+    { 318200, 1 }, { 319700, 0 }, { 321200, 1 }, { 322700, 0 }, { 324200, 1 }, { 325700, 0 },
+    { 327200, 1 }, { 328700, 0 }, { 330200, 1 }, { 331700, 0 }, { 333200, 1 }, { 334700, 0 },
+    { 336200, 1 }, { 337700, 0 }, { 339200, 1 }, { 340700, 0 },
+    { END, 0 }
+};
+static const struct Expected chatterExpect[] = {
+    { END, 0 }
+};
+
+static const struct Scenario scenarios[] = {
+    { "click", clickWave, clickExpect, 800 },
+    { "double-click", doubleWave, doubleExpect, 1800 },
+    { "long press, repeat", holdWave, holdExpect, 5000 },
+    { "chatter", chatterWave, chatterExpect, 600 },
+};
+
+//============================================Functions========================================
+// The firmware's own start-up, minus the USART trace, with the button released
+static void startFirmware(void)
+{
+    hostReset();
+    hostSetPin('D', PD6, 1);
+    memset(&ButtonEvents, 0, sizeof(ButtonEvents));
+    millisCounter = 0;
+    initTimer0();
+    ButtonInputPullup();
+    initButton(&Button1, delayTime);
+    gestureInit(&Button1Gesture, &ButtonTiming);
+    LedOutput();
+    LedLow();
+    sei();
+}
+
+// Replay one waveform, a millisecond at a time, and collect the events with their tick
+static int replay(const struct Scenario* s, struct Expected* got)
+{
+    const struct WaveEdge* edge = s->wave;
+    const uint64_t cyclesPerUs = F_CPU / 1000000;
+    int count = 0;
+    uint8_t events;
+
+    startFirmware();
+    for (uint32_t ms = 0; ms < s->endMs; ms++) {
+        uint64_t end = (uint64_t)(ms + 1) * (F_CPU / 1000);
+
+        while (edge->us != END && edge->us * cyclesPerUs <= end) {
+            hostAdvance((uint32_t)(edge->us * cyclesPerUs - hostCycles));
+            hostSetPin('D', PD6, !edge->pressed); // Active-low
+            edge++;
+        }
+        hostAdvance((uint32_t)(end - hostCycles));
+
+        // At most one tick per millisecond, so millisCounter is the tick that posted
+        while (eventQueuePop(&ButtonEvents, &events)) {
+            if (count < MAX_EVENTS) {
+                got[count].ms = (uint32_t)millisCounter;
+                got[count].events = events;
+            }
+            count++;
+        }
+    }
+    return count;
+}
+
+static int check(const struct Scenario* s)
+{
+    struct Expected got[MAX_EVENTS];
+    int count = replay(s, got);
+    int expected = 0;
+    int failed = 0;
+
+    while (s->expect[expected].ms != END) {
+        expected++;
+    }
+    for (int i = 0; i < count || i < expected; i++) {
+        const struct Expected* e = i < expected ? &s->expect[i] : NULL;
+        const struct Expected* g = i < count && i < MAX_EVENTS ? &got[i] : NULL;
+
+        if (e && g && e->ms == g->ms && e->events == g->events) {
+            continue;
+        }
+        if (!failed) {
+            printf("FAIL %s\n", s->name);
+        }
+        failed = 1;
+        printf("  event %d: expected ", i);
+        if (e) {
+            printf("0x%02x at %u ms", e->events, e->ms);
+        } else {
+            printf("none");
+        }
+        printf(", got ");
+        if (g) {
+            printf("0x%02x at %u ms\n", g->events, g->ms);
+        } else {
+            printf("none\n");
+        }
+    }
+    if (!failed) {
+        printf("ok   %s (%d events)\n", s->name, count);
+    }
+    return failed;
+}
+
+int main(void)
+{
+    int failed = 0;
+
+    for (size_t i = 0; i < sizeof(scenarios) / sizeof(scenarios[0]); i++) {
+        failed += check(&scenarios[i]);
+    }
+    if (failed) {
+        printf("%d of %zu scenarios failed\n", failed, sizeof(scenarios) / sizeof(scenarios[0]));
+    }
+    return failed ? 1 : 0;
+}
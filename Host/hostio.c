@@ -0,0 +1,149 @@
+//===========================================================================================
+// Project: ATmega32A Host HAL
+// Compiler: gcc (host, C99)
+// Target microcontroller: none (Linux host standing in for the ATmega32A)
+// Description: Virtual registers, virtual clock and interrupt dispatch of the host HAL. The
+//              interrupt handlers are weak references: a firmware that defines
+//              ISR(TIMER0_COMP_vect) gets it called, one that does not still links.
+// Date created: 2026-10-16
+//===========================================================================================
+
+//============================================Libraries========================================
+#include <string.h>
+#include <avr/io.h>
+#include "hostio.h"
+
+//============================================Defines========================================
+#define SLEEP_MAX_CYCLES (1UL << 20) // An idle sleep with no wake-up source gives up here
+
+//============================================Global Variables========================================
+volatile uint8_t hostIo[HOST_IO_SIZE];
+uint64_t hostCycles;
+uint64_t hostInterrupts;
+
+static uint32_t prescalerCount; // CPU cycles since the last Timer0 clock
+
+// Defined by ISR() in the firmware, if at all
+void TIMER0_COMP_vect(void) __attribute__((weak));
+void TIMER0_OVF_vect(void) __attribute__((weak));
+void USART_UDRE_vect(void) __attribute__((weak));
+
+//============================================Helpers========================================
+// Call one handler the way the CPU would: I cleared on entry, set again by RETI
+static void callIsr(void (*isr)(void))
+{
+    SREG &= ~(1 << SREG_I);
+    isr();
+    SREG |= (1 << SREG_I);
+    hostInterrupts++;
+}
+
+// Service every pending, enabled interrupt in vector order
+static void serviceIrqs(void)
+{
+    int udre = 0;
+
+    while (SREG & (1 << SREG_I)) {
+        if ((TIFR & (1 << OCF0)) && (TIMSK & (1 << OCIE0)) && TIMER0_COMP_vect) {
+            TIFR &= ~(1 << OCF0); // Cleared by hardware when the vector is taken
+            callIsr(TIMER0_COMP_vect);
+        } else if ((TIFR & (1 << TOV0)) && (TIMSK & (1 << TOIE0)) && TIMER0_OVF_vect) {
+            TIFR &= ~(1 << TOV0);
+            callIsr(TIMER0_OVF_vect);
+        } else if ((UCSRB & (1 << UDRIE)) && USART_UDRE_vect && udre++ < 256) {
+            callIsr(USART_UDRE_vect); // UDR is always empty; the ISR stops itself when done
+        } else {
+            break;
+        }
+    }
+}
+
+// One Timer0 clock: count, clear on compare match in CTC mode, raise the flags. As on the
+// ATmega32A (and in Simulator/timer0.c), OCF0 is set on the clock after the one that made
+// TCNT0 equal to OCR0, which in CTC mode is the clock that clears the counter.
+static void timer0Clock(void)
+{
+    uint8_t ctc = (TCCR0 & ((1 << WGM01) | (1 << WGM00))) == (1 << WGM01);
+    uint8_t match = TCNT0 == OCR0; // Seen by the comparator during the clock that ends now
+
+    if (ctc && match) {
+        TCNT0 = 0;
+    } else if (++TCNT0 == 0) {
+        TIFR |= (1 << TOV0);
+    }
+    if (match) {
+        TIFR |= (1 << OCF0);
+    }
+}
+
+// Timer1 as a free-running 16-bit counter; it only counts when it selects Timer0's tap
+static void timer1Clock(void)
+{
+    uint16_t count = (uint16_t)(((TCNT1H << 8) | TCNT1L) + 1);
+
+    TCNT1L = (uint8_t)count;
+    TCNT1H = (uint8_t)(count >> 8);
+}
+
+//============================================Functions========================================
+void hostReset(void)
+{
+    memset((void*)hostIo, 0, sizeof(hostIo));
+    UCSRA = (1 << UDRE); // Transmitter idle
+    hostCycles = 0;
+    hostInterrupts = 0;
+    prescalerCount = 0;
+}
+
+void hostSetPin(char port, uint8_t bit, uint8_t level)
+{
+    static const uint8_t pinAddr[4] = { 0x39, 0x36, 0x33, 0x30 }; // PINA..PIND
+    volatile uint8_t* pin;
+
+    if (port >= 'a' && port <= 'd') {
+        port -= 'a' - 'A';
+    }
+    if (port < 'A' || port > 'D' || bit > 7) {
+        return;
+    }
+    pin = &hostIo[pinAddr[port - 'A']];
+    *pin = level ? (*pin | (1 << bit)) : (*pin & ~(1 << bit));
+}
+
+void hostAdvance(uint32_t cycles)
+{
+    static const uint16_t prescaler[8] = { 0, 1, 8, 64, 256, 1024, 0, 0 }; // 6, 7: T0 pin
+    uint16_t div;
+
+    serviceIrqs(); // Anything left pending by sei() or the caller
+    hostCycles += cycles;
+    div = prescaler[TCCR0 & 7];
+    if (!div) {
+        return; // Stopped or clocked from T0, which the host does not drive
+    }
+    prescalerCount += cycles;
+    while (prescalerCount >= div) {
+        prescalerCount -= div;
+        timer0Clock();
+        if ((TCCR1B & 7) == (TCCR0 & 7)) {
+            timer1Clock();
+        }
+        serviceIrqs();
+        div = prescaler[TCCR0 & 7]; // An ISR may have changed the clock
+        if (!div) {
+            prescalerCount = 0;
+            break;
+        }
+    }
+}
+
+void hostSleep(void)
+{
+    uint64_t before = hostInterrupts;
+    uint32_t slept = 0;
+
+    while (hostInterrupts == before && slept < SLEEP_MAX_CYCLES) {
+        hostAdvance(8);
+        slept += 8;
+    }
+}
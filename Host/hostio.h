@@ -0,0 +1,46 @@
+//===========================================================================================
+// Project: ATmega32A Host HAL
+// Compiler: gcc (host, C99)
+// Target microcontroller: none (Linux host standing in for the ATmega32A)
+// Description: Virtual register file and clock behind the <avr/...> headers of this directory,
+//              so firmware sources and Library headers compile and run natively. Every I/O
+//              register is a byte of hostIo[] at its ATmega32A data address. Nothing moves by
+//              itself: the harness drives input pins with hostSetPin() and time with
+//              hostAdvance(), which runs Timer0 (normal and CTC modes, prescalers 1..1024) and
+//              calls the firmware's TIMER0_COMP_vect, TIMER0_OVF_vect and USART_UDRE_vect when
+//              their flags and enables say so. UDR accepts every byte at once.
+//
+//              This is for logic and speed, not timing: Timer0 and interrupts are modelled per
+//              timer tick, not per cycle (use Simulator/ for exact cycles), and 'unsigned long'
+//              is 64 bits on x86-64, so 32-bit millis() wrap-around is not reproduced.
+// Usage:   gcc -I../Host firmware.c ../Host/hostio.c   (see Host/Makefile)
+// Date created: 2026-10-16
+//===========================================================================================
+#ifndef HOSTIO_H
+#define HOSTIO_H
+
+//============================================Libraries========================================
+#include <stdint.h>
+
+//============================================Defines========================================
+#define HOST_IO_SIZE 0x60 // Registers and I/O space; SRAM is ordinary host memory
+
+//============================================Global Variables========================================
+extern volatile uint8_t hostIo[HOST_IO_SIZE]; // Virtual registers by data address
+extern uint64_t hostCycles;                   // Virtual CPU clock
+extern uint64_t hostInterrupts;               // Interrupt handlers called so far
+
+//============================================Functions========================================
+// Clear every register and the clock, as after a power-on reset
+void hostReset(void);
+
+// Drive input pin 'bit' of port 'A'..'D' to 'level' (what PINx reads)
+void hostSetPin(char port, uint8_t bit, uint8_t level);
+
+// Let 'cycles' CPU cycles pass: Timer0 counts and due interrupts are serviced
+void hostAdvance(uint32_t cycles);
+
+// SLEEP: let time pass until an interrupt has been serviced (at most 2^20 cycles)
+void hostSleep(void);
+
+#endif // HOSTIO_H
@@ -0,0 +1,37 @@
+//===========================================================================================
+// Project: ATmega32A Host HAL
+// Compiler: gcc (host, C99)
+// Target microcontroller: none (Linux host standing in for the ATmega32A)
+// Description: Host stand-in for <util/setbaud.h>, same rule as avr-libc: the 16x divider
+//              unless its rate is off by more than BAUD_TOL percent, then the 8x divider (U2X).
+// Date created: 2026-10-16
+//===========================================================================================
+#ifndef HOST_UTIL_SETBAUD_H
+#define HOST_UTIL_SETBAUD_H
+
+//============================================Defines========================================
+#ifndef F_CPU
+#error "F_CPU must be defined before including <util/setbaud.h>"
+#endif
+#ifndef BAUD
+#error "BAUD must be defined before including <util/setbaud.h>"
+#endif
+#ifndef BAUD_TOL
+#define BAUD_TOL 2
+#endif
+
+#define UBRR_VALUE_16X (((F_CPU) + 8UL * (BAUD)) / (16UL * (BAUD)) - 1UL)
+
+#if 100 * (F_CPU) > (16 * ((UBRR_VALUE_16X) + 1)) * (100 * (BAUD) + (BAUD) * (BAUD_TOL)) \
+    || 100 * (F_CPU) < (16 * ((UBRR_VALUE_16X) + 1)) * (100 * (BAUD) - (BAUD) * (BAUD_TOL))
+#define USE_2X     1
+#define UBRR_VALUE (((F_CPU) + 4UL * (BAUD)) / (8UL * (BAUD)) - 1UL)
+#else
+#define USE_2X     0
+#define UBRR_VALUE UBRR_VALUE_16X
+#endif
+
+#define UBRRL_VALUE (UBRR_VALUE & 0xFF)
+#define UBRRH_VALUE (UBRR_VALUE >> 8)
+
+#endif // HOST_UTIL_SETBAUD_H
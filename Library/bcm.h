@@ -0,0 +1,156 @@
+//===========================================================================================
+// Project: ATmega32A Binary Code Modulation on PORTB
+// Compiler: avr-gcc
+// Target microcontroller: ATmega32A
+// Description: 8-bit brightness on all eight PORTB pins with one Timer0 interrupt per bit.
+//              A frame is split into eight bit-planes lasting 1, 2, 4 .. 128 time units;
+//              plane b holds bit b of every pin's brightness, precomputed as one PORTB byte.
+//              The compare ISR writes that byte and sets OCR0 to the length of the plane, so a
+//              frame costs 8 interrupts whatever the brightness values are. Timer0 runs in
+//              CTC mode: the counter restarts in hardware at each match, so the plane lengths
+//              stay exact even though the ISR starts a few cycles after the match.
+//
+//              The shortest plane is one unit, so the whole ISR (response, prologue, PORTB and
+//              OCR0 writes, epilogue, RETI: about 72 cycles) must fit in one unit, otherwise
+//              the next match is taken late and plane 0 grows. A unit is one or two timer
+//              ticks (plane 7 = 128 units must fit the 8-bit OCR0); bcm.h picks the shortest
+//              prescaler x ticks combination of at least BCM_MIN_UNIT_CYCLES (default 96):
+//
+//                  unit = 64 x 2 = 128 cycles, frame = 255 units = 32640 cycles
+//                  F_CPU 8 MHz: 245 Hz refresh, 8 ISRs per frame = 1.7% CPU
+//                  F_CPU 1 MHz: 31 Hz refresh, visible flicker; one interrupt per plane is
+//                               too slow at 1 MHz, the short planes would have to be timed
+//                               with cycle delays inside the ISR
+//
+//              bcmSet() fills a back buffer; the ISR switches buffers only at the start of a
+//              frame, so a new pattern never shows half old and half new bits.
+//              Timer0 is fully taken: do not combine with timebase.h or ledpwm.h.
+// Usage:   #include "../Library/bcm.h" (header-only), bcmInit(), call bcmTick() from
+//          ISR(TIMER0_COMP_vect), then bcmSet() whenever the brightness changes.
+// Date created: 2026-10-16
+//===========================================================================================
+#ifndef BCM_H
+#define BCM_H
+
+//============================================Libraries========================================
+#include <stdint.h>
+#include <avr/io.h>
+#include <avr/pgmspace.h>
+
+//============================================Defines========================================
+#ifndef BCM_MIN_UNIT_CYCLES
+#define BCM_MIN_UNIT_CYCLES 96 // Shortest plane in CPU cycles; must exceed the ISR cost
+#endif
+
+// Prescaler and timer ticks per unit, shortest unit first
+#if BCM_MIN_UNIT_CYCLES <= 8
+#define BCM_PRESCALER 8
+#define BCM_UNIT_TICKS 1
+#elif BCM_MIN_UNIT_CYCLES <= 16
+#define BCM_PRESCALER 8
+#define BCM_UNIT_TICKS 2
+#elif BCM_MIN_UNIT_CYCLES <= 64
+#define BCM_PRESCALER 64
+#define BCM_UNIT_TICKS 1
+#elif BCM_MIN_UNIT_CYCLES <= 128
+#define BCM_PRESCALER 64
+#define BCM_UNIT_TICKS 2
+#elif BCM_MIN_UNIT_CYCLES <= 256
+#define BCM_PRESCALER 256
+#define BCM_UNIT_TICKS 1
+#elif BCM_MIN_UNIT_CYCLES <= 512
+#define BCM_PRESCALER 256
+#define BCM_UNIT_TICKS 2
+#elif BCM_MIN_UNIT_CYCLES <= 1024
+#define BCM_PRESCALER 1024
+#define BCM_UNIT_TICKS 1
+#else
+#define BCM_PRESCALER 1024
+#define BCM_UNIT_TICKS 2
+#endif
+
+#if BCM_PRESCALER == 8
+#define BCM_CS_BITS (1 << CS01)
+#elif BCM_PRESCALER == 64
+#define BCM_CS_BITS ((1 << CS01) | (1 << CS00))
+#elif BCM_PRESCALER == 256
+#define BCM_CS_BITS (1 << CS02)
+#else
+#define BCM_CS_BITS ((1 << CS02) | (1 << CS00))
+#endif
+
+#define BCM_UNIT_CYCLES (BCM_PRESCALER * BCM_UNIT_TICKS)
+#define BCM_FRAME_CYCLES (255UL * BCM_UNIT_CYCLES) // One full 8-plane frame
+
+// OCR0 of plane b: 2^b units in CTC mode (period = OCR0 + 1 ticks)
+#define BCM_TOP(b) ((BCM_UNIT_TICKS << (b)) - 1)
+
+//============================================Global Variables========================================
+static uint8_t bcmPlanes[2][8];       // Front/back bit-plane buffers, PORTB byte per bit
+static volatile uint8_t bcmFront = 0; // Buffer the ISR is showing
+static volatile uint8_t bcmSwap = 0;  // Set by bcmSet(), cleared by the ISR at frame start
+static uint8_t bcmBit = 0;            // Plane shown next
+static volatile uint16_t bcmFrames = 0; // Frames shown, wraps; usable as a coarse clock
+
+// OCR0 of each plane (a table, because a variable shift is a loop on the AVR); in flash,
+// it never changes and would otherwise take SRAM and a copy at startup
+static const uint8_t bcmTop[8] PROGMEM = {
+    BCM_TOP(0), BCM_TOP(1), BCM_TOP(2), BCM_TOP(3), BCM_TOP(4), BCM_TOP(5), BCM_TOP(6), BCM_TOP(7)
+};
+
+//============================================Functions========================================
+// Start Timer0 in CTC mode with all pins dark
+static inline void bcmInit(void)
+{
+    DDRB = 0xFF;
+    PORTB = 0x00;
+    OCR0 = BCM_TOP(0);
+    TCNT0 = 0;
+    TCCR0 = (1 << WGM01) | BCM_CS_BITS;
+    TIMSK |= (1 << OCIE0);
+}
+
+// Show the next bit-plane; call from ISR(TIMER0_COMP_vect)
+static inline void bcmTick(void)
+{
+    uint8_t bit = bcmBit;
+    const uint8_t* planes = bcmPlanes[bcmFront];
+
+    PORTB = planes[bit];
+    OCR0 = pgm_read_byte(&bcmTop[bit]); // Plane lasts 2^bit units from the match that started it
+
+    if (++bit == 8) {
+        bit = 0;
+        bcmFrames++;
+        if (bcmSwap) { // Switch only between frames
+            bcmFront ^= 1;
+            bcmSwap = 0;
+        }
+    }
+    bcmBit = bit;
+}
+
+// Load new brightness values (levels[n] for PBn, 0..255); returns 0 while the previous
+// pattern is still waiting for its frame boundary
+static inline uint8_t bcmSet(const uint8_t levels[8])
+{
+    uint8_t* planes;
+
+    if (bcmSwap) {
+        return 0;
+    }
+    planes = bcmPlanes[bcmFront ^ 1];
+    for (uint8_t bit = 0; bit < 8; bit++) {
+        uint8_t plane = 0;
+        for (uint8_t pin = 0; pin < 8; pin++) {
+            if (levels[pin] & (1 << bit)) {
+                plane |= 1 << pin;
+            }
+        }
+        planes[bit] = plane;
+    }
+    bcmSwap = 1;
+    return 1;
+}
+
+#endif // BCM_H
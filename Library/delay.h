@@ -0,0 +1,109 @@
+//===========================================================================================
+// Project: ATmega32A Cycle-Exact Delays
+// Compiler: avr-gcc
+// Target microcontroller: ATmega32A
+// Description: Busy-wait delays whose length is fixed in cycles at compile time from F_CPU.
+//              The whole wait is one inline assembly block: three LDI load a 24-bit count and
+//              a SUBI/SBCI/SBCI/BRNE loop burns 5 cycles per pass, the remainder is padded
+//              with NOPs. The compiler never sees a loop it could reorder, unroll or drop, so
+//              the delay is the same at -O0, -O1, -O2 and -Os.
+//
+//              delayCycles(n)  exactly n cycles, n a constant, 0 .. DELAY_MAX_CYCLES
+//              delayUs(us)     us rounded to the nearest cycle: error <= 0.5 cycle
+//                              (62.5 ns at 8 MHz, 500 ns at 1 MHz)
+//              delayMs(ms)     same for milliseconds
+//              delayMsVar(ms)  run-time count: ms * (F_CPU / 1000) - 1 cycles, plus the few
+//                              cycles the compiler spends loading 'ms' (and the call when it
+//                              is not inlined at -O0); F_CPU / 1000 rounding adds < 1 us/ms
+//
+//              Interrupts that fire during a delay lengthen it by the ISR time.
+//              Arguments of delayCycles/delayUs/delayMs must be compile-time constants; the
+//              build fails if they exceed the 24-bit loop (about 10 s at 8 MHz).
+//
+//              The counter lives in r18..r20, declared as clobbered rather than as an asm
+//              output, so there is nothing for -O0 to store back to the stack afterwards.
+//              'make delaytest' in Simulator/ builds Simulator/delaytest/delays.c at each -O
+//              level and checks every delay cycle for cycle on the simulator.
+// Usage:   #include "../Library/delay.h" (header-only)
+// Date created: 2026-10-16
+//===========================================================================================
+#ifndef DELAY_H
+#define DELAY_H
+
+//============================================Libraries========================================
+#include <stdint.h>
+
+//============================================Defines========================================
+#ifndef F_CPU
+#error "F_CPU must be defined before including delay.h"
+#endif
+
+#define DELAY_LOOP_CYCLES 5                                   // SUBI + SBCI + SBCI + BRNE
+#define DELAY_SETUP_CYCLES 2                                  // 3 x LDI, minus the final BRNE not taken
+#define DELAY_MAX_CYCLES (0xFFFFFFUL * DELAY_LOOP_CYCLES + DELAY_SETUP_CYCLES)
+
+// Split n cycles into loop passes and padding NOPs; short delays are NOPs only
+#define DELAY_PASSES(n) ((n) < 7 ? 0 : ((n) - DELAY_SETUP_CYCLES) / DELAY_LOOP_CYCLES)
+#define DELAY_PADDING(n) ((n) < 7 ? (n) : ((n) - DELAY_SETUP_CYCLES) % DELAY_LOOP_CYCLES)
+
+// Compile-time range check usable inside an expression
+#define DELAY_CHECK(n) ((void)sizeof(char[(n) <= DELAY_MAX_CYCLES ? 1 : -1]))
+
+// Busy-wait exactly n CPU cycles
+#define delayCycles(n)                                                             \
+    do {                                                                           \
+        DELAY_CHECK(n);                                                            \
+        __asm__ __volatile__(                                                      \
+            ".if %[passes] > 0"                 "\n\t"                             \
+            "ldi r18, lo8(%[passes])"           "\n\t"                             \
+            "ldi r19, hi8(%[passes])"           "\n\t"                             \
+            "ldi r20, hlo8(%[passes])"          "\n\t"                             \
+            "1: subi r18, 1"                    "\n\t"                             \
+            "sbci r19, 0"                       "\n\t"                             \
+            "sbci r20, 0"                       "\n\t"                             \
+            "brne 1b"                           "\n\t"                             \
+            ".endif"                            "\n\t"                             \
+            ".rept %[padding]"                  "\n\t"                             \
+            "nop"                               "\n\t"                             \
+            ".endr"                                                                \
+            :                                                                      \
+            : [passes] "i" (DELAY_PASSES(n)), [padding] "i" (DELAY_PADDING(n))      \
+            : "r18", "r19", "r20");                                                \
+    } while (0)
+
+// Microseconds / milliseconds, rounded to the nearest cycle
+#define DELAY_US_CYCLES(us) (((uint64_t)(us) * F_CPU + 500000UL) / 1000000UL)
+#define DELAY_MS_CYCLES(ms) (((uint64_t)(ms) * F_CPU + 500UL) / 1000UL)
+
+#define delayUs(us) delayCycles(DELAY_US_CYCLES(us))
+#define delayMs(ms) delayCycles(DELAY_MS_CYCLES(ms))
+
+// Cycles of one delayMsVar() pass, excluding its own SBIW + BRNE
+#define DELAY_MS_INNER ((F_CPU + 500UL) / 1000UL - 4)
+
+//============================================Functions========================================
+// Run-time millisecond delay; every pass is exactly F_CPU / 1000 cycles
+static inline void delayMsVar(uint16_t ms)
+{
+    if (ms == 0) {
+        return;
+    }
+    __asm__ __volatile__(
+        "2: ldi r18, lo8(%[passes])"        "\n\t"
+        "ldi r19, hi8(%[passes])"           "\n\t"
+        "ldi r20, hlo8(%[passes])"          "\n\t"
+        "1: subi r18, 1"                    "\n\t"
+        "sbci r19, 0"                       "\n\t"
+        "sbci r20, 0"                       "\n\t"
+        "brne 1b"                           "\n\t"
+        ".rept %[padding]"                  "\n\t"
+        "nop"                               "\n\t"
+        ".endr"                             "\n\t"
+        "sbiw %[ms], 1"                     "\n\t"
+        "brne 2b"
+        : [ms] "+w" (ms)
+        : [passes] "i" (DELAY_PASSES(DELAY_MS_INNER)), [padding] "i" (DELAY_PADDING(DELAY_MS_INNER))
+        : "r18", "r19", "r20");
+}
+
+#endif // DELAY_H
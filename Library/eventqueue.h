@@ -0,0 +1,74 @@
+//===========================================================================================
+// Project: ATmega32A Single-Producer/Single-Consumer Event Queue
+// Compiler: avr-gcc
+// Target microcontroller: ATmega32A
+// Description: Lock-free byte queue between one ISR (producer) and the main loop (consumer).
+//              The producer only writes 'head' and the consumer only writes 'tail'; both are
+//              single bytes, so every access is atomic on the AVR and neither side ever has to
+//              disable interrupts. The size must be a power of two so wrapping is a mask.
+//              One slot is kept free to tell a full queue from an empty one.
+// Usage:   #include "../Library/eventqueue.h" (header-only)
+// Date created: 2026-10-16
+//===========================================================================================
+#ifndef EVENTQUEUE_H
+#define EVENTQUEUE_H
+
+//============================================Libraries========================================
+#include <stdint.h>
+
+//============================================Defines========================================
+#ifndef EVENT_QUEUE_SIZE
+#define EVENT_QUEUE_SIZE 16 // Number of slots, must be a power of two (holds SIZE - 1 events)
+#endif
+
+#if (EVENT_QUEUE_SIZE & (EVENT_QUEUE_SIZE - 1)) != 0 || EVENT_QUEUE_SIZE > 128
+#error "EVENT_QUEUE_SIZE must be a power of two no larger than 128"
+#endif
+
+#define EVENT_QUEUE_MASK (EVENT_QUEUE_SIZE - 1)
+
+//============================================Types========================================
+struct EventQueue
+{
+    volatile uint8_t head;                    // Next slot to write, owned by the producer
+    volatile uint8_t tail;                    // Next slot to read, owned by the consumer
+    volatile uint8_t buffer[EVENT_QUEUE_SIZE];
+    volatile uint8_t dropped;                 // Events lost because the queue was full
+};
+
+//============================================Functions========================================
+// Producer side (ISR): append an event, returns 0 and counts a drop if the queue is full
+static inline uint8_t eventQueuePush(struct EventQueue* q, uint8_t event)
+{
+    uint8_t head = q->head;
+    uint8_t next = (head + 1) & EVENT_QUEUE_MASK;
+
+    if (next == q->tail) {
+        q->dropped++;
+        return 0;
+    }
+    q->buffer[head] = event; // Store the event before publishing it through 'head'
+    q->head = next;
+    return 1;
+}
+
+// Consumer side (main loop): true when nothing is waiting
+static inline uint8_t eventQueueEmpty(const struct EventQueue* q)
+{
+    return q->head == q->tail;
+}
+
+// Consumer side (main loop): take the oldest event, returns 0 if the queue is empty
+static inline uint8_t eventQueuePop(struct EventQueue* q, uint8_t* event)
+{
+    uint8_t tail = q->tail;
+
+    if (q->head == tail) {
+        return 0;
+    }
+    *event = q->buffer[tail]; // Read the slot before handing it back through 'tail'
+    q->tail = (tail + 1) & EVENT_QUEUE_MASK;
+    return 1;
+}
+
+#endif // EVENTQUEUE_H
@@ -0,0 +1,169 @@
+//===========================================================================================
+// Project: ATmega32A Button Gesture Engine
+// Compiler: avr-gcc
+// Target microcontroller: ATmega32A
+// Description: Turns a debounced button level into press, release, click, double-click,
+//              long-press and hold-repeat events. gestureUpdate() is called once per 1 ms
+//              tick; it detects the edge, bumps one millisecond counter and looks up one
+//              row of a transition table, so every button costs the same few cycles per tick
+//              whatever it is doing.
+//
+//              IDLE  --press-->  DOWN1  --release-->  UP1  --press-->  DOWN2 --release--> IDLE
+//                                  |                   |                 |   (DOUBLE_CLICK)
+//                                  | longPressMs       | doubleClickMs   | longPressMs
+//                                  v                   v (CLICK)         v
+//                                 HELD  <--------------------------------+
+//                                  |  repeat interval: repeatStartMs, shortened by
+//                                  |  repeatStepMs after each REPEAT down to repeatMinMs
+//                                  +--release--> IDLE
+//
+//              Several events can come out of one tick (RELEASE | DOUBLE_CLICK), so the result
+//              is a bit mask. A CLICK is only reported once doubleClickMs has passed without a
+//              second press; applications that do not need double-clicks set it to 0.
+// Usage:   #include "../Library/gesture.h" (header-only); feed the debounced level (1 = pressed)
+//          to gestureUpdate(), or the debouncer's edges (GESTURE_EDGE_*) to gestureEdge()
+// Date created: 2026-10-16
+//===========================================================================================
+#ifndef GESTURE_H
+#define GESTURE_H
+
+//============================================Libraries========================================
+#include <stdint.h>
+
+//============================================Defines========================================
+// Event bits returned by gestureUpdate()
+#define GESTURE_PRESS        0x01 // Button went down
+#define GESTURE_RELEASE      0x02 // Button went up
+#define GESTURE_CLICK        0x04 // Short press with no second press inside doubleClickMs
+#define GESTURE_DOUBLE_CLICK 0x08 // Second short press released inside the window
+#define GESTURE_LONG_PRESS   0x10 // Held for longPressMs
+#define GESTURE_REPEAT       0x20 // Still held after a long press, at the repeat rate
+
+// Edges from a debouncer that reports them itself (gestureEdge())
+#define GESTURE_EDGE_NONE    0
+#define GESTURE_EDGE_PRESS   1
+#define GESTURE_EDGE_RELEASE 2
+
+// States
+#define GESTURE_IDLE  0 // Released, nothing pending
+#define GESTURE_DOWN1 1 // First press, waiting for release or long press
+#define GESTURE_UP1   2 // Released after a short press, waiting for a second press
+#define GESTURE_DOWN2 3 // Second press
+#define GESTURE_HELD  4 // Long press, repeating
+#define GESTURE_STATES 5
+
+// Table inputs
+#define GESTURE_IN_PRESS   0
+#define GESTURE_IN_RELEASE 1
+#define GESTURE_IN_TIMEOUT 2
+#define GESTURE_INPUTS     3
+
+//============================================Types========================================
+// Timing shared by all buttons of the same kind (milliseconds)
+struct GestureConfig
+{
+    uint16_t longPressMs;   // Hold time before LONG_PRESS
+    uint16_t doubleClickMs; // Window for the second press
+    uint16_t repeatStartMs; // First REPEAT interval after LONG_PRESS
+    uint16_t repeatMinMs;   // Fastest REPEAT interval
+    uint16_t repeatStepMs;  // Interval reduction after every REPEAT
+};
+
+struct GestureTransition
+{
+    uint8_t next;   // State to enter
+    uint8_t events; // GESTURE_* bits to report
+};
+
+struct Gesture
+{
+    const struct GestureConfig* config;
+    uint8_t state;     // GESTURE_IDLE .. GESTURE_HELD
+    uint8_t level;     // Last debounced level seen
+    uint16_t elapsed;  // Milliseconds spent in the current state
+    uint16_t limit;    // Timeout of the current state, 0 = none
+    uint16_t repeat;   // Current repeat interval
+};
+
+//============================================Global Variables========================================
+// Transition table [state][input]; an input that cannot happen in a state keeps the state
+static const struct GestureTransition gestureTable[GESTURE_STATES][GESTURE_INPUTS] = {
+    //  press                                 release                                       timeout
+    { { GESTURE_DOWN1, GESTURE_PRESS },  { GESTURE_IDLE, 0 },                              { GESTURE_IDLE, 0 } },                  // IDLE
+    { { GESTURE_DOWN1, 0 },              { GESTURE_UP1, GESTURE_RELEASE },                 { GESTURE_HELD, GESTURE_LONG_PRESS } }, // DOWN1
+    { { GESTURE_DOWN2, GESTURE_PRESS },  { GESTURE_UP1, 0 },                               { GESTURE_IDLE, GESTURE_CLICK } },      // UP1
+    { { GESTURE_DOWN2, 0 },              { GESTURE_IDLE, GESTURE_RELEASE | GESTURE_DOUBLE_CLICK }, { GESTURE_HELD, GESTURE_LONG_PRESS } }, // DOWN2
+    { { GESTURE_HELD, 0 },               { GESTURE_IDLE, GESTURE_RELEASE },                { GESTURE_HELD, GESTURE_REPEAT } },     // HELD
+};
+
+//============================================Functions========================================
+// Start a button in the released state
+static inline void gestureInit(struct Gesture* g, const struct GestureConfig* config)
+{
+    g->config = config;
+    g->state = GESTURE_IDLE;
+    g->level = 0;
+    g->elapsed = 0;
+    g->limit = 0;
+    g->repeat = config->repeatStartMs;
+}
+
+// Advance one millisecond with the debouncer's edge of this tick (GESTURE_EDGE_*);
+// returns GESTURE_* bits
+static inline uint8_t gestureEdge(struct Gesture* g, uint8_t edge)
+{
+    const struct GestureConfig* c = g->config;
+    const struct GestureTransition* t;
+    uint8_t input;
+
+    if (edge != GESTURE_EDGE_NONE) {
+        g->level = edge == GESTURE_EDGE_PRESS;
+        input = g->level ? GESTURE_IN_PRESS : GESTURE_IN_RELEASE;
+    } else if (g->limit && ++g->elapsed >= g->limit) {
+        input = GESTURE_IN_TIMEOUT;
+    } else {
+        return 0;
+    }
+
+    t = &gestureTable[g->state][input];
+    g->state = t->next;
+    g->elapsed = 0;
+
+    // Timeout of the state just entered
+    switch (t->next) {
+    case GESTURE_DOWN1:
+    case GESTURE_DOWN2:
+        g->limit = c->longPressMs;
+        break;
+    case GESTURE_UP1:
+        g->limit = c->doubleClickMs ? c->doubleClickMs : 1;
+        break;
+    case GESTURE_HELD:
+        if (t->events & GESTURE_LONG_PRESS) {
+            g->repeat = c->repeatStartMs;
+        } else if (g->repeat > c->repeatMinMs + c->repeatStepMs) {
+            g->repeat -= c->repeatStepMs; // Accelerate after each REPEAT
+        } else {
+            g->repeat = c->repeatMinMs;
+        }
+        g->limit = g->repeat;
+        break;
+    default:
+        g->limit = 0;
+        break;
+    }
+    return t->events;
+}
+
+// Advance one millisecond with the debounced level (1 = pressed); returns GESTURE_* bits
+static inline uint8_t gestureUpdate(struct Gesture* g, uint8_t level)
+{
+    uint8_t edge = GESTURE_EDGE_NONE;
+
+    if (level != g->level) {
+        edge = level ? GESTURE_EDGE_PRESS : GESTURE_EDGE_RELEASE;
+    }
+    return gestureEdge(g, edge);
+}
+
+#endif // GESTURE_H
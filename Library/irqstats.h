@@ -0,0 +1,167 @@
+//===========================================================================================
+// Project: ATmega32A Interrupt Latency and Masking Statistics
+// Compiler: avr-gcc
+// Target microcontroller: ATmega32A
+// Description: Optional on-target measurement of how late the 1 ms tick interrupt runs and
+//              how long interrupts stay disabled. Timer0 clears TCNT0 at the compare match
+//              (CTC), so TCNT0 read at the top of ISR(TIMER0_COMP_vect) is the time since the
+//              match: the entry latency, in timer ticks of TIMER0_PRESCALER cycles.
+//
+//              A tick held off past the next match is lost: both matches merge into the one
+//              OCF0 flag, which the CPU clears on entry, and TCNT0 only counts since the last
+//              match. So overruns are counted against Timer1, which irqStatsInit() starts
+//              free-running on the same prescaler tap. TCNT1 steps in lock with TCNT0, and
+//              TCNT1 - latency at entry is the time of the match being serviced. Matches
+//              further apart than one period mean ticks were lost in between. This holds for
+//              gaps up to 65535 timer ticks (0.5 s at 8 MHz).
+//
+//              Interrupts-disabled windows are timed the same way, from TCNT0 at
+//              irqStatsMaskBegin() to TCNT0 at irqStatsMaskEnd(). Wrap the body of every ISR
+//              and every cli() section of interest in these (irqStatsCli()/irqStatsSei() do
+//              both at once). A window that crosses a tick is still measured correctly; one
+//              that starts while a tick is already pending (another ISR holding the tick off)
+//              can only be measured modulo one tick.
+//
+//              The resolution is one timer tick (64 cycles at 8 MHz); avrsim reports the same
+//              figures cycle-exact. With IRQ_STATS 0 (the default) every call compiles to
+//              nothing, or to plain cli()/sei().
+// Usage:   #define IRQ_STATS 1, #include "../Library/irqstats.h" (header-only, after F_CPU),
+//          irqStatsInit() once (it takes Timer1), irqStatsTickEntry() first and
+//          irqStatsMaskEnd() last in ISR(TIMER0_COMP_vect), then irqStatsTake() from the main
+//          loop to read and restart the statistics.
+// Date created: 2026-10-16
+//===========================================================================================
+#ifndef IRQSTATS_H
+#define IRQSTATS_H
+
+//============================================Libraries========================================
+#include <stdint.h>
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include "timebase.h"
+
+//============================================Defines========================================
+#ifndef IRQ_STATS
+#define IRQ_STATS 0 // 1 to compile the measurements in
+#endif
+
+#ifndef IRQSTATS_BINS
+#define IRQSTATS_BINS 8 // Latency histogram bins of one timer tick; the last one also counts longer
+#endif
+
+#define IRQSTATS_TICK_CYCLES TIMER0_PRESCALER       // CPU cycles per TCNT0 step
+#define IRQSTATS_PERIOD_TICKS (TIMER0_OCR0 + 1)     // TCNT0 steps per tick interrupt
+
+//============================================Types========================================
+struct IrqStats
+{
+    uint8_t minLatency;                 // Tick ISR entry latency in timer ticks
+    uint8_t maxLatency;
+    uint16_t histogram[IRQSTATS_BINS];  // Entries per latency (in timer ticks)
+    uint16_t entries;                   // Tick interrupts measured
+    uint16_t overruns;                  // Ticks lost: held off past the next compare match
+    uint16_t maxMasked;                 // Longest interrupts-disabled window in timer ticks
+};
+
+#if IRQ_STATS
+//============================================Global Variables========================================
+static struct IrqStats irqStats = { 0xFF, 0, { 0 }, 0, 0, 0 }; // Written with interrupts off
+static uint8_t irqStatsMaskStart;    // TCNT0 when the current window began
+static uint8_t irqStatsMaskPending;  // OCF0 was already set when it began
+static uint16_t irqStatsLastMatch;   // TCNT1 at the match serviced last
+static uint8_t irqStatsStarted;      // irqStatsLastMatch is valid
+
+//============================================Functions========================================
+// Start Timer1 free-running (Normal mode) on the Timer0 prescaler tap as the overrun reference.
+// CS12:CS10 use the same encoding as CS02:CS00, and both timers share the prescaler.
+static inline void irqStatsInit(void)
+{
+    TCCR1A = 0;
+    TCCR1B = TIMER0_CS_BITS;
+}
+
+// Start an interrupts-disabled window; call with interrupts already off
+static inline void irqStatsMaskBegin(void)
+{
+    irqStatsMaskStart = TCNT0;
+    irqStatsMaskPending = TIFR & (1 << OCF0);
+}
+
+// End the window started by irqStatsMaskBegin(); call before interrupts are enabled again
+static inline void irqStatsMaskEnd(void)
+{
+    uint8_t now = TCNT0;
+    uint16_t ticks = (uint8_t)(now - irqStatsMaskStart);
+
+    // A match during the window (OCF0 newly set) or a counter that went backwards means it
+    // crossed one tick boundary
+    if ((!irqStatsMaskPending && (TIFR & (1 << OCF0))) || now < irqStatsMaskStart) {
+        ticks = now + IRQSTATS_PERIOD_TICKS - irqStatsMaskStart;
+    }
+    if (ticks > irqStats.maxMasked) {
+        irqStats.maxMasked = ticks;
+    }
+}
+
+// Record the entry latency; call first in ISR(TIMER0_COMP_vect), which then ends with
+// irqStatsMaskEnd()
+static inline void irqStatsTickEntry(void)
+{
+    uint8_t latency = TCNT0;
+    uint8_t low = TCNT1L; // Low byte first: it latches the high byte
+    uint16_t match = (((uint16_t)TCNT1H << 8) | low) - latency;
+    uint16_t gap = match - irqStatsLastMatch;
+
+    irqStatsMaskBegin(); // The ISR body is an interrupts-disabled window as well
+
+    // A timer tick may pass between the TCNT0 and TCNT1 reads, so round to whole periods
+    if (irqStatsStarted && gap >= IRQSTATS_PERIOD_TICKS + IRQSTATS_PERIOD_TICKS / 2) {
+        irqStats.overruns += (gap + IRQSTATS_PERIOD_TICKS / 2) / IRQSTATS_PERIOD_TICKS - 1;
+    }
+    irqStatsLastMatch = match;
+    irqStatsStarted = 1;
+    if (latency < irqStats.minLatency) {
+        irqStats.minLatency = latency;
+    }
+    if (latency > irqStats.maxLatency) {
+        irqStats.maxLatency = latency;
+    }
+    irqStats.histogram[latency < IRQSTATS_BINS ? latency : IRQSTATS_BINS - 1]++;
+    irqStats.entries++;
+}
+
+// cli() and start a window
+static inline void irqStatsCli(void)
+{
+    cli();
+    irqStatsMaskBegin();
+}
+
+// End the window and sei()
+static inline void irqStatsSei(void)
+{
+    irqStatsMaskEnd();
+    sei();
+}
+
+// Copy the statistics gathered since the last call and start over
+static inline void irqStatsTake(struct IrqStats* out)
+{
+    uint8_t sreg = SREG;
+
+    cli();
+    *out = irqStats;
+    irqStats = (struct IrqStats){ 0xFF, 0, { 0 }, 0, 0, 0 };
+    SREG = sreg;
+}
+
+#else
+static inline void irqStatsInit(void) {}
+static inline void irqStatsMaskBegin(void) {}
+static inline void irqStatsMaskEnd(void) {}
+static inline void irqStatsTickEntry(void) {}
+static inline void irqStatsCli(void) { cli(); }
+static inline void irqStatsSei(void) { sei(); }
+#endif // IRQ_STATS
+
+#endif // IRQSTATS_H
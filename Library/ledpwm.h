@@ -0,0 +1,164 @@
+//===========================================================================================
+// Project: ATmega32A Hardware PWM LED Driver
+// Compiler: avr-gcc
+// Target microcontroller: ATmega32A
+// Description: Drives an LED on OC0 (PB3) from Timer0 in Fast PWM (default) or Phase Correct
+//              PWM mode. The compare unit switches the pin in hardware, so holding a brightness
+//              costs no CPU time; software only writes OCR0 when the brightness changes (the
+//              PWM modes double buffer OCR0, so a new value never produces a glitched period).
+//
+//              Timer0 can only run one waveform mode, so the 1 ms tick of timebase.h is derived
+//              from the overflow interrupt instead of the CTC compare match: every overflow
+//              adds the cycles of one PWM period to an accumulator and millisCounter advances
+//              by one for each F_CPU / 1000 cycles collected. millis() keeps its long-term
+//              accuracy (no error when F_CPU is a multiple of 1000) but steps by whole PWM
+//              periods:
+//
+//                  8 MHz, prescaler 64, Fast PWM:          period 2.048 ms (488 Hz),
+//                                                          millis() steps by 2 or 3
+//                  8 MHz, prescaler 8,  Fast PWM:          period 0.256 ms (3.9 kHz),
+//                                                          one ISR every 2048 cycles
+//                  8 MHz, prescaler 64, Phase Correct PWM: period 4.080 ms (245 Hz)
+//
+//              Brightness 0 disconnects OC0 and drives PB3 low, because Fast PWM with
+//              OCR0 = 0 still emits a one-tick spike every period. ledGamma[] (PROGMEM) maps
+//              a perceived brightness to a duty with gamma 2.2.
+// Usage:   #include "../Library/ledpwm.h" (header-only, includes timebase.h), call ledPwmInit()
+//          instead of timebaseInit() and ledPwmTick() from ISR(TIMER0_OVF_vect).
+// Date created: 2026-10-16
+//===========================================================================================
+#ifndef LEDPWM_H
+#define LEDPWM_H
+
+//============================================Libraries========================================
+#include <stdint.h>
+#include <avr/pgmspace.h>
+#include "timebase.h"
+
+//============================================Defines========================================
+#ifndef LEDPWM_PRESCALER
+#define LEDPWM_PRESCALER 64 // 1, 8, 64, 256 or 1024
+#endif
+
+#if LEDPWM_PRESCALER == 1
+#define LEDPWM_CS_BITS (1 << CS00)
+#elif LEDPWM_PRESCALER == 8
+#define LEDPWM_CS_BITS (1 << CS01)
+#elif LEDPWM_PRESCALER == 64
+#define LEDPWM_CS_BITS ((1 << CS01) | (1 << CS00))
+#elif LEDPWM_PRESCALER == 256
+#define LEDPWM_CS_BITS (1 << CS02)
+#elif LEDPWM_PRESCALER == 1024
+#define LEDPWM_CS_BITS ((1 << CS02) | (1 << CS00))
+#else
+#error "LEDPWM_PRESCALER must be 1, 8, 64, 256 or 1024"
+#endif
+
+// Waveform mode and timer clocks per PWM period (one overflow interrupt each)
+#ifdef LEDPWM_PHASE_CORRECT
+#define LEDPWM_WGM_BITS (1 << WGM00)
+#define LEDPWM_PERIOD_TICKS 510UL // Up 0..255 and down again, TOV0 at BOTTOM
+#else
+#define LEDPWM_WGM_BITS ((1 << WGM01) | (1 << WGM00))
+#define LEDPWM_PERIOD_TICKS 256UL
+#endif
+
+#define LEDPWM_PERIOD_CYCLES (LEDPWM_PERIOD_TICKS * LEDPWM_PRESCALER) // CPU cycles per overflow
+#define LEDPWM_MS_CYCLES (F_CPU / 1000UL)                              // CPU cycles per millisecond
+
+#if LEDPWM_PERIOD_CYCLES + LEDPWM_MS_CYCLES > 65535UL
+#error "PWM period too long for the 16-bit millisecond accumulator"
+#endif
+
+#define LEDPWM_PIN 3 // OC0 = PB3
+
+//============================================Global Variables========================================
+static uint16_t ledPwmCycles = 0; // CPU cycles not yet turned into milliseconds, ISR only
+
+// Perceived brightness (0..255) to PWM duty, gamma 2.2
+static const uint8_t ledGamma[256] PROGMEM = {
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   1,
+      1,   1,   1,   1,   1,   1,   1,   1,   1,   2,   2,   2,   2,   2,   2,   2,
+      3,   3,   3,   3,   3,   4,   4,   4,   4,   5,   5,   5,   5,   6,   6,   6,
+      6,   7,   7,   7,   8,   8,   8,   9,   9,   9,  10,  10,  11,  11,  11,  12,
+     12,  13,  13,  13,  14,  14,  15,  15,  16,  16,  17,  17,  18,  18,  19,  19,
+     20,  20,  21,  22,  22,  23,  23,  24,  25,  25,  26,  26,  27,  28,  28,  29,
+     30,  30,  31,  32,  33,  33,  34,  35,  35,  36,  37,  38,  39,  39,  40,  41,
+     42,  43,  43,  44,  45,  46,  47,  48,  49,  49,  50,  51,  52,  53,  54,  55,
+     56,  57,  58,  59,  60,  61,  62,  63,  64,  65,  66,  67,  68,  69,  70,  71,
+     73,  74,  75,  76,  77,  78,  79,  81,  82,  83,  84,  85,  87,  88,  89,  90,
+     91,  93,  94,  95,  97,  98,  99, 100, 102, 103, 105, 106, 107, 109, 110, 111,
+    113, 114, 116, 117, 119, 120, 121, 123, 124, 126, 127, 129, 130, 132, 133, 135,
+    137, 138, 140, 141, 143, 145, 146, 148, 149, 151, 153, 154, 156, 158, 159, 161,
+    163, 165, 166, 168, 170, 172, 173, 175, 177, 179, 181, 182, 184, 186, 188, 190,
+    192, 194, 196, 197, 199, 201, 203, 205, 207, 209, 211, 213, 215, 217, 219, 221,
+    223, 225, 227, 229, 231, 234, 236, 238, 240, 242, 244, 246, 248, 251, 253, 255,
+};
+
+//============================================Functions========================================
+// Start Timer0 in PWM mode with OC0 disconnected (LED off) and the overflow tick enabled
+static inline void ledPwmInit(void)
+{
+    DDRB |= (1 << LEDPWM_PIN);
+    PORTB &= ~(1 << LEDPWM_PIN);
+    OCR0 = 0;
+    TCNT0 = 0;
+    TCCR0 = LEDPWM_WGM_BITS | LEDPWM_CS_BITS;
+    TIMSK = (TIMSK & ~(1 << OCIE0)) | (1 << TOIE0); // The tick moves from OCF0 to TOV0
+}
+
+// Advance millisCounter; call from ISR(TIMER0_OVF_vect)
+static inline void ledPwmTick(void)
+{
+    uint16_t cycles = ledPwmCycles + LEDPWM_PERIOD_CYCLES;
+
+    while (cycles >= LEDPWM_MS_CYCLES) {
+        cycles -= LEDPWM_MS_CYCLES;
+        millisCounter++;
+    }
+    ledPwmCycles = cycles;
+}
+
+// Set the raw duty: 0 = off, 255 = fully on
+static inline void ledPwmSetDuty(uint8_t duty)
+{
+    if (duty == 0) {
+        TCCR0 &= ~((1 << COM01) | (1 << COM00)); // PB3 follows PORTB3 (low)
+        return;
+    }
+#ifdef LEDPWM_PHASE_CORRECT
+    OCR0 = duty;     // Duty = OCR0 / 255
+#else
+    OCR0 = duty == 255 ? 255 : duty - 1; // Duty = (OCR0 + 1) / 256; 255 is fully on
+#endif
+    TCCR0 |= (1 << COM01); // Non-inverting: clear OC0 on compare match
+}
+
+// Set a perceived brightness through the gamma table
+static inline void ledPwmSetBrightness(uint8_t level)
+{
+    ledPwmSetDuty(pgm_read_byte(&ledGamma[level]));
+}
+
+// Perceived brightness of a breathing cycle of 'periodMs' at time 'now' (triangle wave);
+// feed it to ledPwmSetBrightness() whenever convenient, the PWM runs on its own in between.
+// Periods below 2 ms are taken as 2 ms (a triangle needs a rising and a falling step).
+static inline uint8_t ledPwmBreath(unsigned long now, uint16_t periodMs)
+{
+    if (periodMs < 2) {
+        periodMs = 2;
+    }
+
+    uint16_t phase = now % periodMs;
+    uint16_t half = periodMs / 2;
+
+    if (phase >= half) {
+        phase = periodMs - phase; // Falling half
+        if (phase > half) {
+            phase = half; // Odd period: the extra millisecond stays at the peak
+        }
+    }
+    return (uint8_t)(((uint32_t)phase * 255 + half / 2) / half);
+}
+
+#endif // LEDPWM_H
@@ -0,0 +1,48 @@
+//===========================================================================================
+// Project: ATmega32A Compile-Time GPIO Pins
+// Compiler: avr-gcc
+// Target microcontroller: ATmega32A
+// Description: PIN_DEFINE(Name, Port, Bit) generates a family of static inline functions for
+//              one pin whose port and bit are compile-time constants. Because PORTx, DDRx and
+//              PINx of ports A..D sit in the low I/O space, avr-gcc turns every call into a
+//              single instruction with optimization enabled (-O1 and up):
+//
+//                  NameHigh()   sbi  PORTx, bit   (2 cycles)
+//                  NameLow()    cbi  PORTx, bit   (2 cycles)
+//                  NameOutput() sbi  DDRx, bit
+//                  NameInput()  cbi  DDRx, bit
+//                  NameRead()   sbis/sbic PINx, bit when used in a condition
+//                  NameToggle() in/eor/out on PORTx (the ATmega32A cannot toggle through PINx,
+//                               so this one is 3 instructions and not atomic against ISRs
+//                               that write the same port)
+//
+//              A pointer-based pin (struct with volatile unsigned char* fields) instead needs
+//              the pointer loaded from RAM and the bit mask built with a shift loop on every
+//              access: updateButton() in the shipped deBouncd_Button.hex spends about 50 cycles
+//              and 30 bytes of flash reading PD6 through 'pin' and 'buttonPin'.
+//
+// Usage:   PIN_DEFINE(Led, B, 1)   then   LedOutput(); LedHigh(); if (LedRead()) ...
+// Date created: 2026-10-16
+//===========================================================================================
+#ifndef PIN_H
+#define PIN_H
+
+//============================================Libraries========================================
+#include <avr/io.h>
+
+//============================================Defines========================================
+// Define the inline accessors of pin 'bit' of port 'port' (A..D) under the prefix 'name'
+#define PIN_DEFINE(name, port, bit)                                                     \
+    static inline void name##Output(void) { DDR##port |= (1 << (bit)); }               \
+    static inline void name##Input(void) { DDR##port &= ~(1 << (bit)); }               \
+    static inline void name##InputPullup(void)                                         \
+    {                                                                                   \
+        DDR##port &= ~(1 << (bit));                                                     \
+        PORT##port |= (1 << (bit));                                                     \
+    }                                                                                   \
+    static inline void name##High(void) { PORT##port |= (1 << (bit)); }                \
+    static inline void name##Low(void) { PORT##port &= ~(1 << (bit)); }                \
+    static inline void name##Toggle(void) { PORT##port ^= (1 << (bit)); }              \
+    static inline unsigned char name##Read(void) { return (PIN##port & (1 << (bit))) != 0; }
+
+#endif // PIN_H
@@ -0,0 +1,61 @@
+//===========================================================================================
+// Project: ATmega32A Parallel Port Debouncer
+// Compiler: avr-gcc
+// Target microcontroller: ATmega32A
+// Description: Debounces all 8 pins of a port at once with a vertical (bit-sliced) counter.
+//              Each pin owns one bit in cnt0 and one bit in cnt1, forming a 2-bit counter per
+//              pin. A pin's counter advances on every sample that differs from its debounced
+//              state and is cleared by any sample that agrees, so a pin only changes state after
+//              four consecutive identical samples. One update is a handful of AND/XOR/COM
+//              instructions no matter how many pins are in use.
+//
+//              Debounce time = 4 * sample period, e.g. call every 12 ms for ~50 ms.
+// Usage:   #include "../Library/portdebounce.h" (header-only)
+// Date created: 2026-10-16
+//===========================================================================================
+#ifndef PORTDEBOUNCE_H
+#define PORTDEBOUNCE_H
+
+//============================================Libraries========================================
+#include <stdint.h>
+
+//============================================Types========================================
+// Debounce state of one 8-bit port
+struct PortDebouncer
+{
+    uint8_t state;    // Debounced level of each pin (1 = active)
+    uint8_t cnt0;     // Vertical counter, bit 0 of every pin's counter
+    uint8_t cnt1;     // Vertical counter, bit 1 of every pin's counter
+    uint8_t pressed;  // Pins that became active in the last update
+    uint8_t released; // Pins that became inactive in the last update
+};
+
+//============================================Functions========================================
+// Start from a known level so no edges are reported for pins that are already held
+static inline void portDebounceInit(struct PortDebouncer* deb, uint8_t initial)
+{
+    deb->state = initial;
+    deb->cnt0 = 0;
+    deb->cnt1 = 0;
+    deb->pressed = 0;
+    deb->released = 0;
+}
+
+// Feed one sample of the port (1 = active; pass ~PINx for active-low buttons).
+// Returns the mask of pins whose debounced state changed; see deb->pressed/released.
+static inline uint8_t portDebounceUpdate(struct PortDebouncer* deb, uint8_t sample)
+{
+    uint8_t delta = sample ^ deb->state;       // Pins that disagree with the debounced state
+    uint8_t toggle;
+
+    deb->cnt1 = (deb->cnt1 ^ deb->cnt0) & delta; // Increment counters of disagreeing pins,
+    deb->cnt0 = (uint8_t)~deb->cnt0 & delta;     // clear the counters of agreeing pins
+    toggle = delta & (uint8_t)~(deb->cnt0 | deb->cnt1); // Counter wrapped 3 -> 0: 4th sample
+
+    deb->state ^= toggle;
+    deb->pressed = toggle & deb->state;
+    deb->released = toggle & (uint8_t)~deb->state;
+    return toggle;
+}
+
+#endif // PORTDEBOUNCE_H
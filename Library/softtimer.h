@@ -0,0 +1,166 @@
+//===========================================================================================
+// Project: ATmega32A Cooperative Soft Timers
+// Compiler: avr-gcc
+// Target microcontroller: ATmega32A
+// Description: One-shot and periodic software timers driven by the timebase.h 1 ms tick.
+//              Timers sit in a hashed timing wheel of SOFT_TIMER_SLOTS lists indexed by
+//              (deadline & mask). softTimerPoll() walks one slot per elapsed millisecond, so the
+//              cost per tick is the number of timers hashed to that slot, independent of how
+//              many timers are armed in total; start and stop are O(1) list operations.
+//
+//              TIMER0_COMP_vect only advances millisCounter as before. Callbacks run from
+//              softTimerPoll() in the main loop, so a slow callback delays other timers but
+//              never the tick itself. The lateness of every dispatch (millis() at the call
+//              minus the deadline) is tracked in softTimerMaxLatency.
+//
+//              A callback may start or stop any timer, including itself. A periodic timer is
+//              re-armed at deadline + period before its callback runs, so its phase does not
+//              drift with dispatch latency; stopping it from the callback ends it.
+// Usage:   #include "../Library/softtimer.h" after timebase.h (header-only),
+//          softTimerInit() once, then call softTimerPoll() (and softTimerIdle()) from main().
+// Date created: 2026-10-16
+//===========================================================================================
+#ifndef SOFTTIMER_H
+#define SOFTTIMER_H
+
+//============================================Libraries========================================
+#include <stdint.h>
+#include "timebase.h"
+
+//============================================Defines========================================
+#ifndef SOFT_TIMER_SLOTS
+#define SOFT_TIMER_SLOTS 16 // Wheel size, must be a power of two no larger than 256
+#endif
+
+#if (SOFT_TIMER_SLOTS & (SOFT_TIMER_SLOTS - 1)) != 0 || SOFT_TIMER_SLOTS > 256
+#error "SOFT_TIMER_SLOTS must be a power of two no larger than 256"
+#endif
+
+#define SOFT_TIMER_MASK (SOFT_TIMER_SLOTS - 1)
+
+//============================================Types========================================
+struct SoftTimer;
+typedef void (*SoftTimerCallback)(struct SoftTimer* timer);
+
+struct SoftTimer
+{
+    struct SoftTimer* next;     // Next timer in the same list
+    struct SoftTimer** link;    // Pointer that points at this timer (list head or prev->next)
+    unsigned long deadline;     // millis() value at which the timer is due
+    unsigned long period;       // Reload in milliseconds, 0 for a one-shot timer
+    SoftTimerCallback callback; // Called from softTimerPoll() when due
+};
+
+//============================================Global Variables========================================
+static struct SoftTimer* softTimerSlots[SOFT_TIMER_SLOTS]; // Wheel lists, indexed by deadline & mask
+static struct SoftTimer* softTimerPending;                 // Slot being dispatched
+static unsigned long softTimerNow;                         // Last millisecond dispatched
+static unsigned long softTimerMaxLatency;                  // Worst dispatch lateness in milliseconds
+static unsigned long softTimerDispatched;                  // Callbacks run since softTimerInit()
+
+//============================================Functions========================================
+// Put a timer at the head of a list
+static inline void softTimerLink(struct SoftTimer** head, struct SoftTimer* t)
+{
+    t->next = *head;
+    if (t->next) {
+        t->next->link = &t->next;
+    }
+    t->link = head;
+    *head = t;
+}
+
+// Take a timer out of whatever list holds it
+static inline void softTimerUnlink(struct SoftTimer* t)
+{
+    *t->link = t->next;
+    if (t->next) {
+        t->next->link = t->link;
+    }
+    t->link = 0;
+}
+
+// Start dispatching from the current millisecond; timers must not be armed yet
+static inline void softTimerInit(void)
+{
+    softTimerNow = millis();
+    softTimerMaxLatency = 0;
+    softTimerDispatched = 0;
+}
+
+// True while the timer is armed
+static inline uint8_t softTimerActive(const struct SoftTimer* t)
+{
+    return t->link != 0;
+}
+
+// Disarm a timer; harmless if it is not armed
+static inline void softTimerStop(struct SoftTimer* t)
+{
+    if (t->link) {
+        softTimerUnlink(t);
+    }
+}
+
+// Arm a timer 'delay' ms (at least 1) from now; 'period' = 0 makes it one-shot.
+// Restarting an armed timer moves its deadline.
+static inline void softTimerStart(struct SoftTimer* t, unsigned long delay, unsigned long period,
+                                  SoftTimerCallback callback)
+{
+    softTimerStop(t);
+    t->deadline = millis() + (delay ? delay : 1);
+    t->period = period;
+    t->callback = callback;
+    softTimerLink(&softTimerSlots[(uint8_t)t->deadline & SOFT_TIMER_MASK], t);
+}
+
+// Run the callbacks of every millisecond that elapsed since the last call
+static inline void softTimerPoll(void)
+{
+    unsigned long now = millis();
+
+    while (softTimerNow != now) {
+        struct SoftTimer** slot;
+        struct SoftTimer* t;
+
+        softTimerNow++;
+        slot = &softTimerSlots[(uint8_t)softTimerNow & SOFT_TIMER_MASK];
+
+        // Move the slot aside; timers for a later lap go back, due timers fire. A callback
+        // can stop a timer still waiting here because each one knows the list it is in.
+        softTimerPending = 0;
+        if (*slot) {
+            softTimerPending = *slot;
+            softTimerPending->link = &softTimerPending;
+            *slot = 0;
+        }
+        while ((t = softTimerPending) != 0) {
+            softTimerUnlink(t);
+            if (t->deadline != softTimerNow) {
+                softTimerLink(slot, t);
+                continue;
+            }
+            if (now - t->deadline > softTimerMaxLatency) {
+                softTimerMaxLatency = now - t->deadline;
+            }
+            if (t->period) {
+                t->deadline += t->period;
+                softTimerLink(&softTimerSlots[(uint8_t)t->deadline & SOFT_TIMER_MASK], t);
+            }
+            softTimerDispatched++;
+            t->callback(t);
+        }
+    }
+}
+
+// Idle until the next tick unless one arrived since the last softTimerPoll()
+static inline void softTimerIdle(void)
+{
+    cli();
+    if (millisCounter == softTimerNow) {
+        timebaseIdle(); // Returns with interrupts enabled
+    }
+    sei();
+}
+
+#endif // SOFTTIMER_H
@@ -0,0 +1,97 @@
+//===========================================================================================
+// Project: ATmega32A Millisecond Timebase
+// Compiler: avr-gcc
+// Target microcontroller: ATmega32A
+// Description: Timer0 CTC millisecond tick with a lock-free millis(). The 32-bit counter is
+//              only ever written by TIMER0_COMP_vect, so the main loop reads it twice and
+//              retries until both copies agree instead of masking interrupts. Because the tick
+//              ISR cannot run twice during the few cycles of two reads, two equal copies are
+//              always an untorn value. millis() never touches the I flag, so it is safe to call
+//              with interrupts disabled and from inside other ISRs.
+//
+//              timebaseSleepUntil() waits for a deadline in SLEEP_MODE_IDLE instead of
+//              spinning: the core only wakes for the 1 ms compare interrupt (or any other
+//              enabled interrupt) and goes straight back to sleep until the deadline is due.
+//
+// Usage:   #include "../Library/timebase.h" in the example (header-only, one translation unit),
+//          call timebaseTick() from ISR(TIMER0_COMP_vect) and timebaseInit() before sei().
+// Date created: 2026-10-16
+//===========================================================================================
+#ifndef TIMEBASE_H
+#define TIMEBASE_H
+
+//============================================Libraries========================================
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+
+//============================================Defines========================================
+#ifndef F_CPU
+#error "F_CPU must be defined before including timebase.h"
+#endif
+
+#define TIMER0_TICK_HZ 1000     // millis() counts 1 ms ticks
+#include "timer0config.h"       // Prescaler and OCR0 chosen from F_CPU at compile time
+
+//============================================Global Variables========================================
+static volatile unsigned long millisCounter = 0; // Milliseconds since timebaseInit(), written only by the ISR
+
+//============================================Functions========================================
+// Configure Timer0 in CTC mode for a 1 ms compare match interrupt
+static inline void timebaseInit(void)
+{
+    TCCR0 = (1 << WGM01) | TIMER0_CS_BITS; // CTC, prescaler from timer0config.h
+    OCR0 = TIMER0_OCR0;
+    TCNT0 = 0;
+    TIMSK |= (1 << OCIE0);                            // Enable compare match interrupt
+}
+
+// Advance the timebase; call from ISR(TIMER0_COMP_vect)
+static inline void timebaseTick(void)
+{
+    millisCounter++;
+}
+
+// Get current time in milliseconds without disabling interrupts.
+// A read interrupted by the tick differs from the next read, so loop until two agree.
+static inline unsigned long millis(void)
+{
+    unsigned long first;
+    unsigned long second;
+
+    do {
+        first = millisCounter;
+        __asm__ __volatile__("timebase_millis_retry_%=:" ::); // Names the loop for wcet bounds
+        second = millisCounter;
+    } while (first != second);
+
+    return second;
+}
+
+// Sleep in idle mode until the next interrupt; Timer0 keeps running in idle, so the
+// wait is at most one tick. Leaves global interrupts enabled.
+static inline void timebaseIdle(void)
+{
+    set_sleep_mode(SLEEP_MODE_IDLE);
+    sleep_enable();
+    sei();       // The instruction after SEI always executes first, so no interrupt
+    sleep_cpu(); // can slip in between the check made by the caller and the SLEEP
+    sleep_disable();
+}
+
+// Sleep until millis() reaches 'deadline' (wrap-around safe).
+// The deadline is checked with interrupts off so a tick arriving just before SLEEP
+// cannot be missed; interrupts are enabled again on return.
+static inline void timebaseSleepUntil(unsigned long deadline)
+{
+    for (;;) {
+        cli();
+        if ((long)(millisCounter - deadline) >= 0) {
+            break;
+        }
+        timebaseIdle();
+    }
+    sei();
+}
+
+#endif // TIMEBASE_H
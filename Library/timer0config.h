@@ -0,0 +1,105 @@
+//===========================================================================================
+// Project: ATmega32A Timer0 CTC Configuration Generator
+// Compiler: avr-gcc
+// Target microcontroller: ATmega32A
+// Description: Picks the Timer0 prescaler and OCR0 value for a CTC tick at compile time from
+//              F_CPU and the wanted tick rate, so changing the crystal cannot leave a stale
+//              hard-coded OCR0 behind. Every prescaler tap (1, 8, 64, 256, 1024) whose rounded
+//              count fits in 8 bits is tried; the one with the smallest tick-rate error wins,
+//              ties going to the smaller prescaler. The build fails if no tap fits or if the
+//              best error is above TIMER0_MAX_ERROR_PPM.
+//
+// Inputs:  F_CPU                CPU clock in Hz (required)
+//          TIMER0_TICK_HZ       Wanted compare match rate in Hz (default 1000)
+//          TIMER0_MAX_ERROR_PPM Largest accepted rate error in ppm (default 100)
+// Outputs: TIMER0_PRESCALER     Selected clock divider
+//          TIMER0_CS_BITS       Matching CS02:CS00 value for TCCR0
+//          TIMER0_OCR0          Compare value (TOP) for CTC mode
+//          TIMER0_ERROR_PPM     Tick rate error of the selected pair in ppm
+//
+// Example: F_CPU 8 MHz, 1000 Hz  -> /64,   OCR0 = 124, 0 ppm
+//          F_CPU 1 MHz, 1000 Hz  -> /8,    OCR0 = 124, 0 ppm
+//          F_CPU 16 MHz, 1000 Hz -> /64,   OCR0 = 249, 0 ppm
+// Date created: 2026-10-16
+//===========================================================================================
+#ifndef TIMER0CONFIG_H
+#define TIMER0CONFIG_H
+
+//============================================Defines========================================
+#ifndef F_CPU
+#error "F_CPU must be defined before including timer0config.h"
+#endif
+
+#ifndef TIMER0_TICK_HZ
+#define TIMER0_TICK_HZ 1000
+#endif
+
+#ifndef TIMER0_MAX_ERROR_PPM
+#define TIMER0_MAX_ERROR_PPM 100
+#endif
+
+// Timer clocks per tick with prescaler n, rounded to nearest
+#define T0CFG_COUNTS(n) ((F_CPU + (n) * TIMER0_TICK_HZ / 2) / ((n) * TIMER0_TICK_HZ))
+
+// A tap is usable when its count fits the 8-bit counter (OCR0 = count - 1)
+#define T0CFG_VALID(n) (T0CFG_COUNTS(n) >= 1 && T0CFG_COUNTS(n) <= 256)
+
+// Rate error in ppm: |n * count * tick - F_CPU| / F_CPU
+#define T0CFG_ERROR(n)                                                          \
+    (((n) * T0CFG_COUNTS(n) * TIMER0_TICK_HZ > F_CPU                            \
+          ? (n) * T0CFG_COUNTS(n) * TIMER0_TICK_HZ - F_CPU                      \
+          : F_CPU - (n) * T0CFG_COUNTS(n) * TIMER0_TICK_HZ) * 1000000 / F_CPU)
+
+// Walk the taps from the finest to the coarsest, keeping the best one so far
+#define TIMER0_PRESCALER 0
+
+#if T0CFG_VALID(1)
+#undef TIMER0_PRESCALER
+#define TIMER0_PRESCALER 1
+#endif
+
+#if T0CFG_VALID(8) && (TIMER0_PRESCALER == 0 || T0CFG_ERROR(8) < T0CFG_ERROR(TIMER0_PRESCALER))
+#undef TIMER0_PRESCALER
+#define TIMER0_PRESCALER 8
+#endif
+
+#if T0CFG_VALID(64) && (TIMER0_PRESCALER == 0 || T0CFG_ERROR(64) < T0CFG_ERROR(TIMER0_PRESCALER))
+#undef TIMER0_PRESCALER
+#define TIMER0_PRESCALER 64
+#endif
+
+#if T0CFG_VALID(256) && (TIMER0_PRESCALER == 0 || T0CFG_ERROR(256) < T0CFG_ERROR(TIMER0_PRESCALER))
+#undef TIMER0_PRESCALER
+#define TIMER0_PRESCALER 256
+#endif
+
+#if T0CFG_VALID(1024) && (TIMER0_PRESCALER == 0 || T0CFG_ERROR(1024) < T0CFG_ERROR(TIMER0_PRESCALER))
+#undef TIMER0_PRESCALER
+#define TIMER0_PRESCALER 1024
+#endif
+
+#if TIMER0_PRESCALER == 0
+#error "No Timer0 prescaler reaches TIMER0_TICK_HZ with an 8-bit OCR0 at this F_CPU"
+#endif
+
+// Register values for the selected tap
+#if TIMER0_PRESCALER == 1
+#define TIMER0_CS_BITS (1 << CS00)
+#elif TIMER0_PRESCALER == 8
+#define TIMER0_CS_BITS (1 << CS01)
+#elif TIMER0_PRESCALER == 64
+#define TIMER0_CS_BITS ((1 << CS01) | (1 << CS00))
+#elif TIMER0_PRESCALER == 256
+#define TIMER0_CS_BITS (1 << CS02)
+#else
+#define TIMER0_CS_BITS ((1 << CS02) | (1 << CS00))
+#endif
+
+#define TIMER0_OCR0      (T0CFG_COUNTS(TIMER0_PRESCALER) - 1)
+#define TIMER0_ERROR_PPM T0CFG_ERROR(TIMER0_PRESCALER)
+
+#if TIMER0_ERROR_PPM > TIMER0_MAX_ERROR_PPM
+#error "Timer0 tick rate error exceeds TIMER0_MAX_ERROR_PPM for this F_CPU"
+#endif
+
+#endif // TIMER0CONFIG_H
@@ -0,0 +1,104 @@
+//===========================================================================================
+// Project: ATmega32A Binary Event Trace over the USART
+// Compiler: avr-gcc
+// Target microcontroller: ATmega32A
+// Description: Writes compact time-stamped records (traceformat.h) to the interrupt-driven
+//              USART of uart.h. Timestamps are deltas from the previous record in milliseconds,
+//              and both the delta and the argument use the fewest bytes that hold them, so a
+//              typical record is 2 or 3 bytes: at 38400 baud about 1300 events per second fit
+//              on the line. traceEvent() never blocks; records that do not fit in the transmit
+//              buffer are dropped whole and show up in uartDropped.
+// Usage:   #include "../Library/trace.h" after timebase.h (header-only), traceInit() once,
+//          then traceEvent() from the main loop only. Decode with Simulator/tracedump.
+// Date created: 2026-10-16
+//===========================================================================================
+#ifndef TRACE_H
+#define TRACE_H
+
+//============================================Libraries========================================
+#include <stdint.h>
+#include "traceformat.h"
+#include "timebase.h"
+#include "uart.h"
+#include "irqstats.h"
+
+//============================================Global Variables========================================
+static unsigned long traceLast = 0; // millis() of the last record sent
+
+//============================================Functions========================================
+// Size code of the smallest field that holds 'value'
+static inline uint8_t traceSizeCode(uint32_t value)
+{
+    if (value == 0) {
+        return 0;
+    }
+    if (value <= 0xFF) {
+        return 1;
+    }
+    return value <= 0xFFFF ? 2 : 3;
+}
+
+// Append 'code' little-endian bytes of value
+static inline uint8_t* tracePut(uint8_t* p, uint32_t value, uint8_t code)
+{
+    for (uint8_t i = TRACE_SIZE(code); i > 0; i--) {
+        *p++ = (uint8_t)value;
+        value >>= 8;
+    }
+    return p;
+}
+
+// Queue one record; returns 0 if it was dropped
+static inline uint8_t traceEvent(uint8_t id, uint32_t arg)
+{
+    uint8_t record[TRACE_MAX_RECORD];
+    unsigned long now = millis();
+    uint32_t delta = now - traceLast;
+    uint8_t deltaCode = traceSizeCode(delta);
+    uint8_t argCode = traceSizeCode(arg);
+    uint8_t* p = record;
+
+    *p++ = (deltaCode << TRACE_DELTA_SHIFT) | (argCode << TRACE_ARG_SHIFT) | (id & TRACE_ID_MASK);
+    p = tracePut(p, delta, deltaCode);
+    p = tracePut(p, arg, argCode);
+    if (!uartWrite(record, p - record)) {
+        return 0; // Keep traceLast so the next delta still covers this gap
+    }
+    traceLast = now;
+    return 1;
+}
+
+// Send the interrupt statistics gathered since the last call (irqstats.h) and restart them.
+// Latencies and windows go out in CPU cycles; does nothing unless IRQ_STATS is 1.
+static inline void traceIrqStats(void)
+{
+#if IRQ_STATS
+    struct IrqStats stats;
+
+    irqStatsTake(&stats);
+    if (stats.entries == 0) {
+        return;
+    }
+    traceEvent(TRACE_LAT_MIN, (uint32_t)stats.minLatency * IRQSTATS_TICK_CYCLES);
+    traceEvent(TRACE_LAT_MAX, (uint32_t)stats.maxLatency * IRQSTATS_TICK_CYCLES);
+    for (uint8_t bin = 0; bin < IRQSTATS_BINS; bin++) {
+        if (stats.histogram[bin]) {
+            traceEvent(TRACE_LAT_BIN, ((uint32_t)bin * IRQSTATS_TICK_CYCLES << 16) | stats.histogram[bin]);
+        }
+    }
+    traceEvent(TRACE_MASKED, (uint32_t)stats.maxMasked * IRQSTATS_TICK_CYCLES);
+    if (stats.overruns) {
+        traceEvent(TRACE_OVERRUNS, stats.overruns);
+    }
+#endif
+}
+
+// Start the USART and the stream with a SYNC record holding the absolute time
+static inline void traceInit(void)
+{
+    uartInit();
+    traceLast = millis();
+    traceEvent(TRACE_SYNC, traceLast);
+}
+
+#endif // TRACE_H
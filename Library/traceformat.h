@@ -0,0 +1,49 @@
+//===========================================================================================
+// Project: ATmega32A Binary Trace Record Format
+// Compiler: avr-gcc / host gcc
+// Target microcontroller: ATmega32A (records are decoded on the host by Simulator/tracedump)
+// Description: Layout of the records trace.h sends over the USART. Shared by the target and
+//              the host decoder, so it has no AVR dependencies.
+//
+//              header   bits 7..6  size of the time delta: 0, 1, 2 or 4 bytes
+//                       bits 5..4  size of the argument:   0, 1, 2 or 4 bytes
+//                       bits 3..0  event id
+//              delta    milliseconds since the previous record, little-endian (0 if absent)
+//              argument event-specific value, little-endian (0 if absent)
+//
+//              A button event 3 ms after the previous record is 3 bytes: header, delta, arg.
+//              TRACE_SYNC starts every stream and carries the absolute millis() value, so the
+//              decoder can print absolute times from the deltas that follow. The LAT_* /
+//              MASKED / OVERRUNS records carry the irqstats.h figures of one report period.
+// Date created: 2026-10-16
+//===========================================================================================
+#ifndef TRACEFORMAT_H
+#define TRACEFORMAT_H
+
+//============================================Defines========================================
+// Event ids, name and meaning of the argument
+#define TRACE_EVENTS(X)                                                               \
+    X(0, SYNC)     /* absolute millis() at the start of the stream */                 \
+    X(1, BUTTON)   /* GESTURE_* bits from gesture.h */                                \
+    X(2, LOOPS)    /* main loop passes during the last report period */               \
+    X(3, DROPPED)  /* bytes the USART buffer had to discard so far */                 \
+    X(4, USER)     /* application defined */                                          \
+    X(5, LAT_MIN)  /* shortest tick ISR entry latency, CPU cycles (irqstats.h) */     \
+    X(6, LAT_MAX)  /* longest tick ISR entry latency, CPU cycles */                   \
+    X(7, LAT_BIN)  /* latency histogram bin: first latency in cycles << 16 | count */ \
+    X(8, MASKED)   /* longest interrupts-disabled window, CPU cycles */               \
+    X(9, OVERRUNS) /* ticks lost: tick ISR held off past the next match */
+
+#define TRACE_ID_ENUM(id, name) TRACE_##name = id,
+enum { TRACE_EVENTS(TRACE_ID_ENUM) };
+#undef TRACE_ID_ENUM
+
+#define TRACE_ID_MASK 0x0F
+#define TRACE_ARG_SHIFT 4
+#define TRACE_DELTA_SHIFT 6
+#define TRACE_MAX_RECORD 9 // Header + 4-byte delta + 4-byte argument
+
+// Size code (0..3) to byte count
+#define TRACE_SIZE(code) ((code) == 3 ? 4 : (code))
+
+#endif // TRACEFORMAT_H
@@ -0,0 +1,107 @@
+//===========================================================================================
+// Project: ATmega32A Interrupt-Driven USART Transmitter
+// Compiler: avr-gcc
+// Target microcontroller: ATmega32A
+// Description: Non-blocking serial output. uartWrite() copies bytes into a power-of-two ring
+//              buffer and enables the Data Register Empty interrupt; USART_UDRE_vect moves one
+//              byte per interrupt into UDR and switches itself off when the buffer runs dry.
+//              The main loop never waits for the line: when the buffer is full the bytes are
+//              dropped and counted in uartDropped, so a slow baud rate cannot stall the
+//              application or the 1 ms tick.
+//
+//              Like eventqueue.h, 'head' is only written by the producer (main loop) and
+//              'tail' only by the ISR, both single bytes, so no interrupts are masked.
+//              The baud rate divider and U2X are chosen at compile time by <util/setbaud.h>
+//              from F_CPU and UART_BAUD (default 38400: UBRR 25 with U2X at 8 MHz, 0.2%).
+// Usage:   #include "../Library/uart.h" (header-only), uartInit(), call uartUdreIsr() from
+//          ISR(USART_UDRE_vect), then uartWrite() from the main loop only.
+// Date created: 2026-10-16
+//===========================================================================================
+#ifndef UART_H
+#define UART_H
+
+//============================================Libraries========================================
+#include <stdint.h>
+#include <avr/io.h>
+
+//============================================Defines========================================
+#ifndef F_CPU
+#error "F_CPU must be defined before including uart.h"
+#endif
+
+#ifndef UART_BAUD
+#define UART_BAUD 38400UL
+#endif
+
+#ifndef UART_TX_SIZE
+#define UART_TX_SIZE 64 // Bytes, must be a power of two no larger than 256 (holds SIZE - 1)
+#endif
+
+#if (UART_TX_SIZE & (UART_TX_SIZE - 1)) != 0 || UART_TX_SIZE > 256
+#error "UART_TX_SIZE must be a power of two no larger than 256"
+#endif
+
+#define UART_TX_MASK (UART_TX_SIZE - 1)
+
+#define BAUD UART_BAUD     // setbaud.h expands BAUD inside its results, so it stays defined
+#include <util/setbaud.h> // UBRRH_VALUE, UBRRL_VALUE, USE_2X
+
+//============================================Global Variables========================================
+static volatile uint8_t uartHead = 0;             // Next slot to fill, written by the main loop
+static volatile uint8_t uartTail = 0;             // Next slot to send, written by the ISR
+static volatile uint8_t uartBuffer[UART_TX_SIZE];
+static uint16_t uartDropped = 0;                  // Bytes discarded because the buffer was full
+
+//============================================Functions========================================
+// 8N1 transmitter at UART_BAUD; the receiver stays off
+static inline void uartInit(void)
+{
+    UBRRH = UBRRH_VALUE;
+    UBRRL = UBRRL_VALUE;
+#if USE_2X
+    UCSRA |= (1 << U2X);
+#else
+    UCSRA &= ~(1 << U2X);
+#endif
+    UCSRC = (1 << URSEL) | (1 << UCSZ1) | (1 << UCSZ0); // URSEL selects UCSRC over UBRRH
+    UCSRB = (1 << TXEN);
+}
+
+// Free slots in the transmit buffer
+static inline uint8_t uartFree(void)
+{
+    return (uint8_t)(uartTail - uartHead - 1) & UART_TX_MASK;
+}
+
+// Queue 'len' bytes; all or nothing, returns 0 (and counts a drop) if they do not fit
+static inline uint8_t uartWrite(const uint8_t* data, uint8_t len)
+{
+    uint8_t head = uartHead;
+
+    if (len > uartFree()) {
+        uartDropped += len;
+        return 0;
+    }
+    while (len--) {
+        uartBuffer[head] = *data++;
+        head = (head + 1) & UART_TX_MASK;
+    }
+    uartHead = head;          // Publish the bytes before enabling the interrupt
+    UCSRB |= (1 << UDRIE);
+    return 1;
+}
+
+// Send the next byte; call from ISR(USART_UDRE_vect)
+static inline void uartUdreIsr(void)
+{
+    uint8_t tail = uartTail;
+
+    if (tail == uartHead) {
+        UCSRB &= ~(1 << UDRIE); // Nothing left: stop the interrupt until uartWrite()
+        return;
+    }
+    UDR = uartBuffer[tail];
+    uartTail = (tail + 1) & UART_TX_MASK;
+}
+
+#endif // UART_H
@@ -0,0 +1,45 @@
+//===========================================================================================
+// Project: ATmega32A Breathing LED on Timer0 Hardware PWM
+// Compiler: avr-gcc
+// Target microcontroller: ATmega32A
+// Description: An LED on OC0 (PB3) breathes with a 3 s period. Timer0 runs in Fast PWM, so
+//              the pin is switched by the compare unit and the CPU only writes a new OCR0
+//              once per 20 ms step; the brightness goes through the gamma table in flash so
+//              the fade looks even. The millisecond tick comes from the Timer0 overflow
+//              interrupt (see ledpwm.h) and the core idles between ticks.
+// Date created: 2026-10-16
+//===========================================================================================
+
+//============================================Libraries========================================
+#include <avr/io.h>        // Provides definitions for ATmega32A I/O registers
+#include <avr/interrupt.h> // Provides definitions for interrupt handling
+
+//============================================Defines========================================
+#define F_CPU 8000000UL      // CPU frequency set to 8 MHz
+#define breathPeriod 3000    // Milliseconds for one full fade in and out
+#define stepPeriod 20        // Milliseconds between brightness updates
+
+#include "../Library/ledpwm.h" // Timer0 PWM on OC0, overflow tick, gamma table
+
+//============================================Interrupt Service Routines (ISRs)========================================
+// Timer0 Overflow ISR, once per PWM period; keeps millis() running
+ISR(TIMER0_OVF_vect) {
+    ledPwmTick();
+}
+
+//============================================Main Code========================================
+int main(void)
+{
+    unsigned long next;
+
+    ledPwmInit(); // Fast PWM on PB3, LED off
+    sei();        // Enable global interrupts
+
+    next = millis();
+    while (1)
+    {
+        timebaseSleepUntil(next); // Idle until the next step is due
+        ledPwmSetBrightness(ledPwmBreath(next, breathPeriod));
+        next += stepPeriod;
+    }
+}
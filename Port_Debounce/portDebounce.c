@@ -0,0 +1,59 @@
+//===========================================================================================
+// Project: ATmega32A Debounced Key Port with Timer0
+// Compiler: avr-gcc
+// Target microcontroller: ATmega32A
+// Description: Eight active-low keys on PORTD (internal pull-ups) each toggle the LED on the
+//              matching PORTB pin. All eight keys are debounced together by the vertical
+//              counter in portdebounce.h: one update per 12 ms sample costs the same whether
+//              one key or all eight are wired, instead of one updateButton() call (and three
+//              millis() reads) per key.
+// Date created: 2026-10-16
+//===========================================================================================
+
+//============================================Libraries========================================
+#include <avr/io.h>        // Provides definitions for ATmega32A I/O registers
+#include <avr/interrupt.h> // Provides definitions for interrupt handling
+
+//============================================Defines========================================
+#define F_CPU 8000000UL      // CPU frequency set to 8 MHz
+#define samplePeriod 12      // Milliseconds between samples; 4 samples = ~50 ms debounce
+
+#include "../Library/timebase.h"     // Timer0 1 ms tick and lock-free millis()
+#include "../Library/portdebounce.h" // Vertical counter debouncer
+
+//============================================Global Variables========================================
+struct PortDebouncer Keys; // Debounce state of the eight keys on PORTD
+
+//============================================Interrupt Service Routines (ISRs)========================================
+// Timer0 Compare Match ISR, triggered every 1 ms
+ISR(TIMER0_COMP_vect) {
+    timebaseTick();
+}
+
+//============================================Main Code========================================
+int main(void)
+{
+    unsigned long previous;
+
+    DDRD = 0x00;  // All PORTD pins are key inputs
+    PORTD = 0xFF; // Enable the pull-ups (keys pull the pins low)
+    DDRB = 0xFF;  // All PORTB pins drive LEDs
+    PORTB = 0x00; // LEDs off
+
+    portDebounceInit(&Keys, (uint8_t)~PIND); // Keys already held at reset are not "pressed"
+    timebaseInit();
+    sei(); // Enable global interrupts
+
+    previous = millis();
+    while (1)
+    {
+        if (millis() - previous >= samplePeriod) {
+            previous += samplePeriod;
+
+            // Active-low keys: invert so a pressed key samples as 1
+            if (portDebounceUpdate(&Keys, (uint8_t)~PIND)) {
+                PORTB ^= Keys.pressed; // Toggle the LED of every newly pressed key
+            }
+        }
+    }
+}
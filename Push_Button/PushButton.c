@@ -8,38 +8,89 @@
 // This code is for an ATmega32A microcontroller
 // by [mobin Alijani]
 // Date: 2023-10-01
-
+//
+// Input modes (BUTTON_MODE):
+//   BUTTON_MODE_POLL  button on PD7, the loop polls PIND continuously (default)
+//   BUTTON_MODE_INT0  button on PD2 (INT0), the core sleeps until the pin changes;
+//                     build with -DBUTTON_MODE=1 and move the button to PD2
+// In both modes PORTB is only written when the button state changes.
+//
+// INT0 mode uses SLEEP_MODE_IDLE: INT0 edge detection needs the I/O clock, and Power-down
+// could only wake on a LOW level, which is the released state of this active-high button.
 //==========================================================================================
 
 
 #define F_CPU 1000000UL  // Define CPU frequency as 1 MHz
 
-// Define memory-mapped I/O registers
-#define PORTB (*(volatile unsigned char *)0x38)  // Data Register for Port B
-#define DDRB  (*(volatile unsigned char *)0x37)  // Data Direction Register for Port B
+#define BUTTON_MODE_POLL 0
+#define BUTTON_MODE_INT0 1
+#ifndef BUTTON_MODE
+#define BUTTON_MODE BUTTON_MODE_POLL
+#endif
+
+// Memory-mapped I/O registers come from <avr/io.h>:
+// PORTB 0x38, DDRB 0x37, PIND 0x30, DDRD 0x31 (data-space addresses)
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+#include "../Library/pin.h" // Compile-time pins: single sbi/cbi/sbis instructions
 
-#define PIND  (*(volatile unsigned char *)0x30)  // Input Pins Register for Port D
-#define DDRD  (*(volatile unsigned char *)0x31)  // Data Direction Register for Port D
+#if BUTTON_MODE == BUTTON_MODE_INT0
+PIN_DEFINE(Button, D, 2) // Push button on PD2 (INT0), HIGH when pressed
+
+// INT0 only has to end the SLEEP; main() reads the pin itself
+EMPTY_INTERRUPT(INT0_vect)
+#else
+PIN_DEFINE(Button, D, 7) // Push button on PD7, HIGH when pressed
+#endif
+
+// Drive all of PORTB from the button state
+static inline void showButton(unsigned char pressed)
+{
+    PORTB = pressed ? 0xFF : 0x00; // All outputs on while pressed, off otherwise
+}
 
 int main(void) {
+    unsigned char shown = 0; // Button state currently shown on PORTB
 
     DDRB = 0xFF;   // Configure all PORTB pins as output
-    DDRD = 0x00;   // Configure all PORTD pins as input
+    ButtonInput(); // Configure the button pin as input
     PORTB = 0x00;  // Initialize PORTB to LOW (all outputs off)
 
+#if BUTTON_MODE == BUTTON_MODE_INT0
+    MCUCR |= (1 << ISC00);  // INT0 on any logical change of PD2
+    GICR |= (1 << INT0);    // Enable INT0
+    set_sleep_mode(SLEEP_MODE_IDLE);
+    sei();
+#endif
+
     while (1) {
-        // Check if PD7 (pin 7 of Port D) is HIGH (e.g., button pressed)
-        if (PIND & (1 << 7)) {
-            PORTB = 0xFF;  // Set all PORTB pins HIGH (turn on all connected outputs)
-        } else {
-            PORTB = 0x00;  // Set all PORTB pins LOW (turn off all outputs)
-        }        
+        // Only touch PORTB when the button state changed
+        if (ButtonRead() != shown) { // Compiles to a single sbis/sbic on PIND
+            shown = !shown;
+            showButton(shown);
+        }
+
+#if BUTTON_MODE == BUTTON_MODE_INT0
+        // Sleep until INT0 reports an edge. The pin is checked again with interrupts off so
+        // an edge between the read above and SLEEP cannot be missed: SEI delays the
+        // interrupt by one instruction, so it wakes the SLEEP instead of running before it.
+        cli();
+        if (ButtonRead() == shown) {
+            sleep_enable();
+            sei();
+            sleep_cpu();
+            sleep_disable();
+        }
+        sei();
+#endif
     }
 
     return 0; // This line is never reached
 }
 
-// Note: Assumes button is on PD7 and goes HIGH when pressed.
+// Note: Assumes button goes HIGH when pressed (PD2 in INT0 mode, PD7 in polling mode).
 // Ensure button wiring and Vcc/GND are correct.
-// Loop checks button state and updates PORTB accordingly.
+// Loop checks button state and updates PORTB only when it changes.
 // 'volatile' ensures accurate access to memory-mapped registers.
+// ButtonRead() resolves to one sbis/sbic instruction because port and bit are constants.
@@ -0,0 +1,1192 @@
+//===========================================================================================
+// Project: ATmega32A Host-Side Simulator
+// Compiler: gcc (host, C99)
+// Target microcontroller: ATmega32A (simulated)
+// Description: Instruction decoder and executor of the AVR core. Every instruction is charged
+//              the cycle count documented in the AVR instruction set manual for the classic
+//              (ATmega32A) core, interrupts are vectored with the 4-cycle response time, and
+//              CALL/RET and interrupt/RETI pairs are tracked on a shadow stack so cycles can be
+//              attributed to functions and ISRs.
+//
+//              Instructions are not decoded on every execution: each flash word is translated
+//              once, the first time it runs, into a handler pointer with its operands already
+//              extracted (avr->ops), and avrRun() calls those handlers back to back between
+//              peripheral events, interrupts and sleeps.
+// Date created: 2026-10-16
+//===========================================================================================
+
+//============================================Libraries========================================
+#include <stdlib.h>
+#include <string.h>
+#include "avrsim.h"
+
+//============================================Defines========================================
+#define REG(n) (avr->data[(n)])
+#define SREG   (avr->data[AVR_SREG])
+#define BIT(v, n) (((v) >> (n)) & 1)
+
+// Opcode field extractors
+#define RD5(op)  (((op) >> 4) & 0x1F)                  // d in ...d dddd ....
+#define RR5(op)  ((((op) >> 5) & 0x10) | ((op) & 0x0F)) // r in ..r. .... rrrr
+#define RD4(op)  (16 + (((op) >> 4) & 0x0F))           // d in r16..r31
+#define K8(op)   ((((op) >> 4) & 0xF0) | ((op) & 0x0F))
+#define IOA6(op) ((((op) >> 5) & 0x30) | ((op) & 0x0F))
+#define Q6(op)   ((((op) >> 8) & 0x20) | (((op) >> 7) & 0x18) | ((op) & 0x07))
+
+#define IDLE_FIRST_BACKOFF 3 // A loop is first probed for idleness on its 8th back edge
+
+//============================================Vector names========================================
+static const char* const vectorNames[AVR_VECTOR_COUNT] = {
+    "RESET", "INT0", "INT1", "INT2", "TIMER2_COMP", "TIMER2_OVF", "TIMER1_CAPT",
+    "TIMER1_COMPA", "TIMER1_COMPB", "TIMER1_OVF", "TIMER0_COMP", "TIMER0_OVF",
+    "SPI_STC", "USART_RXC", "USART_UDRE", "USART_TXC", "ADC", "EE_RDY",
+    "ANA_COMP", "TWI", "SPM_RDY"
+};
+
+const char* avrVectorName(uint8_t vector)
+{
+    return vector < AVR_VECTOR_COUNT ? vectorNames[vector] : "?";
+}
+
+// Histogram bin of an interrupt latency: 0, 1, 2-3, 4-7 .. 64-127, 128 and more
+int avrLatencyBin(uint32_t latency)
+{
+    int bin = 0;
+
+    while (latency && bin < AVR_LATENCY_BINS - 1) {
+        latency >>= 1;
+        bin++;
+    }
+    return bin;
+}
+
+//============================================Setup========================================
+// Initialize a core: clear program memory and all hooks, then reset
+void avrInit(struct AvrCore* avr)
+{
+    memset(avr, 0, sizeof(*avr));
+    memset(avr->flash, 0xFF, sizeof(avr->flash)); // Erased flash reads as 0xFFFF
+    avrFlashChanged(avr);
+    avr->nextEvent = UINT64_MAX;
+    avrReset(avr);
+}
+
+// Reset the CPU state; program memory, hooks and peripherals are kept
+void avrReset(struct AvrCore* avr)
+{
+    memset(avr->data, 0, sizeof(avr->data));
+    avr->pc = 0;
+    avr->cycles = 0;
+    avr->instructions = 0;
+    avr->sleeping = 0;
+    avr->irqHold = 0;
+    avr->stopReason = AVR_STOP_NONE;
+    avr->sleepCycles = 0;
+    avr->wakeups = 0;
+    avr->pendingVector = 0;
+    avr->depth = 0;
+    memset(avr->irqTiming, 0, sizeof(avr->irqTiming));
+    memset(&avr->mask, 0, sizeof(avr->mask));
+    avr->mask.start = UINT64_MAX;
+    avr->irqEnabled = 0;
+    avr->isrDepth = 0;
+    memset(avr->ioWrites, 0, sizeof(avr->ioWrites));
+    avr->countHits = 0;
+    avr->idle.branch = NULL;
+    avr->idle.skips = 0;
+    avr->idle.skippedCycles = 0;
+}
+
+// Give a peripheral ownership of an I/O register
+void avrSetIoHook(struct AvrCore* avr, uint16_t addr, AvrReadHook rd, AvrWriteHook wr, void* ctx)
+{
+    avr->readHook[addr - AVR_IO_BASE] = rd;
+    avr->writeHook[addr - AVR_IO_BASE] = wr;
+    avr->hookCtx[addr - AVR_IO_BASE] = ctx;
+}
+
+// Register an interrupt source; vectors are kept sorted so lower numbers win
+void avrAddIrq(struct AvrCore* avr, const struct AvrIrqSource* src)
+{
+    int i;
+
+    if (avr->irqCount >= AVR_MAX_IRQ_SOURCES) {
+        return;
+    }
+    for (i = avr->irqCount; i > 0 && avr->irq[i - 1].vector > src->vector; i--) {
+        avr->irq[i] = avr->irq[i - 1];
+    }
+    avr->irq[i] = *src;
+    avr->irqCount++;
+    avr->irqReg[src->flagAddr - AVR_IO_BASE] = 1;
+    avr->irqReg[src->enableAddr - AVR_IO_BASE] = 1;
+}
+
+// Recompute the highest-priority pending interrupt.
+// Peripherals call this after changing a flag or enable bit.
+void avrUpdateIrq(struct AvrCore* avr)
+{
+    avr->pendingVector = 0;
+    for (int i = 0; i < avr->irqCount; i++) {
+        const struct AvrIrqSource* s = &avr->irq[i];
+        if ((avr->data[s->flagAddr] & s->flagMask) && (avr->data[s->enableAddr] & s->enableMask)) {
+            avr->pendingVector = s->vector;
+            return;
+        }
+    }
+}
+
+// Record when a peripheral set an interrupt flag, for the latency statistics
+void avrIrqRaised(struct AvrCore* avr, uint8_t vector, uint64_t cycle)
+{
+    avr->irqTiming[vector].raised = cycle;
+}
+
+// Register a peripheral event callback that fires at cycle 'next'
+int avrAddPeriph(struct AvrCore* avr, AvrEventHook event, void* ctx, uint64_t next)
+{
+    if (avr->periphCount >= AVR_MAX_PERIPHS) {
+        return -1;
+    }
+    avr->periph[avr->periphCount].event = event;
+    avr->periph[avr->periphCount].ctx = ctx;
+    avr->periph[avr->periphCount].next = next;
+    avr->periphCount++;
+    if (next < avr->nextEvent) {
+        avr->nextEvent = next;
+    }
+    return 0;
+}
+
+// Move the next event of the peripheral owning 'ctx' (e.g. after a register write)
+void avrReschedule(struct AvrCore* avr, void* ctx, uint64_t next)
+{
+    avr->nextEvent = UINT64_MAX;
+    for (int i = 0; i < avr->periphCount; i++) {
+        if (avr->periph[i].ctx == ctx) {
+            avr->periph[i].next = next;
+        }
+        if (avr->periph[i].next < avr->nextEvent) {
+            avr->nextEvent = avr->periph[i].next;
+        }
+    }
+}
+
+// Fire every peripheral event that is due
+static void runEvents(struct AvrCore* avr)
+{
+    avr->nextEvent = UINT64_MAX;
+    for (int i = 0; i < avr->periphCount; i++) {
+        struct AvrPeriph* p = &avr->periph[i];
+        while (p->next <= avr->cycles) {
+            p->next = p->event(avr, p->ctx);
+        }
+        if (p->next < avr->nextEvent) {
+            avr->nextEvent = p->next;
+        }
+    }
+}
+
+// Allocate the per-function statistics table
+int avrEnableProfile(struct AvrCore* avr)
+{
+    if (!avr->funcStats) {
+        avr->funcStats = calloc(AVR_FLASH_WORDS, sizeof(struct AvrFuncStats));
+    }
+    return avr->funcStats ? 0 : -1;
+}
+
+void avrFree(struct AvrCore* avr)
+{
+    free(avr->funcStats);
+    avr->funcStats = NULL;
+    free(avr->gpio.changes);
+    avr->gpio.changes = NULL;
+    avr->gpio.changeCount = 0;
+    avr->gpio.changeSize = 0;
+    free(avr->gpio.edges);
+    avr->gpio.edges = NULL;
+    avr->gpio.edgeCount = 0;
+    avr->gpio.edgeSize = 0;
+}
+
+//============================================Data space========================================
+uint8_t avrReadData(struct AvrCore* avr, uint16_t addr)
+{
+    if (addr >= AVR_IO_BASE && addr < AVR_SRAM_START) {
+        AvrReadHook rd = avr->readHook[addr - AVR_IO_BASE];
+        if (rd) {
+            avr->idle.clockedReads += avr->ioClocked[addr - AVR_IO_BASE];
+            return rd(avr, addr, avr->hookCtx[addr - AVR_IO_BASE]);
+        }
+    } else if (addr >= AVR_DATA_SIZE) {
+        return 0; // Unmapped
+    }
+    return avr->data[addr];
+}
+
+void avrWriteData(struct AvrCore* avr, uint16_t addr, uint8_t value)
+{
+    if (addr >= AVR_IO_BASE && addr < AVR_SRAM_START) {
+        AvrWriteHook wr = avr->writeHook[addr - AVR_IO_BASE];
+        avr->ioWrites[addr - AVR_IO_BASE]++;
+        if (wr) {
+            wr(avr, addr, value, avr->hookCtx[addr - AVR_IO_BASE]);
+        } else {
+            avr->data[addr] = value;
+        }
+        if (avr->irqReg[addr - AVR_IO_BASE]) {
+            avrUpdateIrq(avr);
+        }
+    } else if (addr < AVR_DATA_SIZE) {
+        avr->data[addr] = value;
+    }
+}
+
+//============================================Stack========================================
+static uint16_t getSp(struct AvrCore* avr)
+{
+    return avr->data[AVR_SPL] | (avr->data[AVR_SPH] << 8);
+}
+
+static void setSp(struct AvrCore* avr, uint16_t sp)
+{
+    avr->data[AVR_SPL] = sp & 0xFF;
+    avr->data[AVR_SPH] = sp >> 8;
+}
+
+static void push8(struct AvrCore* avr, uint8_t v)
+{
+    uint16_t sp = getSp(avr);
+    avrWriteData(avr, sp, v);
+    setSp(avr, sp - 1);
+}
+
+static uint8_t pop8(struct AvrCore* avr)
+{
+    uint16_t sp = getSp(avr) + 1;
+    setSp(avr, sp);
+    return avrReadData(avr, sp);
+}
+
+// Return addresses are pushed low byte first, as on the real core
+static void pushPc(struct AvrCore* avr, uint16_t pc)
+{
+    push8(avr, pc & 0xFF);
+    push8(avr, pc >> 8);
+}
+
+static uint16_t popPc(struct AvrCore* avr)
+{
+    uint16_t hi = pop8(avr);
+    return (hi << 8) | pop8(avr);
+}
+
+//============================================Cycle accounting========================================
+static void enterFrame(struct AvrCore* avr, uint16_t target, uint8_t isIrq, uint64_t start)
+{
+    if (!avr->funcStats || avr->depth >= AVR_CALL_DEPTH) {
+        return;
+    }
+    struct AvrFrame* f = &avr->frames[avr->depth++];
+    f->target = target;
+    f->isIrq = isIrq;
+    f->start = start;
+    f->child = 0;
+}
+
+// Close the innermost frame once its RET/RETI has completed
+static void leaveFrame(struct AvrCore* avr, uint8_t isIrq)
+{
+    if (!avr->funcStats || avr->depth == 0) {
+        return;
+    }
+    // Unwind frames abandoned by stack manipulation until the matching kind is found
+    while (avr->depth > 0 && avr->frames[avr->depth - 1].isIrq != isIrq) {
+        avr->depth--;
+    }
+    if (avr->depth == 0) {
+        return;
+    }
+    struct AvrFrame* f = &avr->frames[--avr->depth];
+    uint64_t total = avr->cycles - f->start;
+    struct AvrFuncStats* s = f->isIrq ? &avr->irqStats[f->target] : &avr->funcStats[f->target];
+
+    if (avr->idle.branch) {
+        idleTouch(avr, s);
+    }
+    if (s->calls == 0 || total < s->min) {
+        s->min = (uint32_t)total;
+    }
+    if (total > s->max) {
+        s->max = (uint32_t)total;
+    }
+    s->calls++;
+    s->inclusive += total;
+    s->exclusive += total - f->child;
+    if (avr->depth > 0) {
+        avr->frames[avr->depth - 1].child += total;
+    }
+}
+
+//============================================Flags========================================
+static void flagsZns(struct AvrCore* avr, uint8_t r, uint8_t v)
+{
+    uint8_t n = BIT(r, 7);
+    SREG = (SREG & ~((1 << SREG_Z) | (1 << SREG_N) | (1 << SREG_V) | (1 << SREG_S)))
+         | ((r == 0) << SREG_Z) | (n << SREG_N) | (v << SREG_V) | ((n ^ v) << SREG_S);
+}
+
+static uint8_t doAdd(struct AvrCore* avr, uint8_t d, uint8_t r, uint8_t carry)
+{
+    uint8_t res = d + r + carry;
+    uint8_t c = (d & r) | (r & ~res) | (~res & d);
+    uint8_t v = BIT((d & r & ~res) | (~d & ~r & res), 7);
+
+    SREG = (SREG & ~((1 << SREG_H) | (1 << SREG_C))) | (BIT(c, 3) << SREG_H) | (BIT(c, 7) << SREG_C);
+    flagsZns(avr, res, v);
+    return res;
+}
+
+// Subtract with flags; 'keepZ' implements the SBC/SBCI/CPC rule that Z can only be cleared
+static uint8_t doSub(struct AvrCore* avr, uint8_t d, uint8_t r, uint8_t carry, uint8_t keepZ)
+{
+    uint8_t res = d - r - carry;
+    uint8_t b = (~d & r) | (r & res) | (res & ~d);
+    uint8_t v = BIT((d & ~r & ~res) | (~d & r & res), 7);
+    uint8_t z = BIT(SREG, SREG_Z);
+
+    SREG = (SREG & ~((1 << SREG_H) | (1 << SREG_C))) | (BIT(b, 3) << SREG_H) | (BIT(b, 7) << SREG_C);
+    flagsZns(avr, res, v);
+    if (keepZ && !z) {
+        SREG &= ~(1 << SREG_Z);
+    }
+    return res;
+}
+
+static void flagsLogic(struct AvrCore* avr, uint8_t r)
+{
+    flagsZns(avr, r, 0);
+}
+
+// Flags of the shift/rotate group: C = bit shifted out, V = N ^ C
+static void flagsShift(struct AvrCore* avr, uint8_t r, uint8_t c)
+{
+    uint8_t n = BIT(r, 7);
+    SREG = (SREG & ~0x1F) | c | ((r == 0) << SREG_Z) | (n << SREG_N)
+         | ((n ^ c) << SREG_V) | (((n ^ c) ^ n) << SREG_S);
+}
+
+static void flagsMul(struct AvrCore* avr, uint16_t r, uint8_t c)
+{
+    SREG = (SREG & ~((1 << SREG_C) | (1 << SREG_Z))) | (c << SREG_C) | ((r == 0) << SREG_Z);
+    REG(0) = r & 0xFF;
+    REG(1) = r >> 8;
+}
+
+//============================================Decoder========================================
+// Size in words of the instruction with the given first word
+int avrOpcodeWords(uint16_t op)
+{
+    if ((op & 0xFC0F) == 0x9000 || (op & 0xFE0C) == 0x940C) {
+        return 2; // LDS/STS, JMP/CALL
+    }
+    return 1;
+}
+
+static uint16_t pointer(struct AvrCore* avr, int reg)
+{
+    return REG(reg) | (REG(reg + 1) << 8);
+}
+
+static void setPointer(struct AvrCore* avr, int reg, uint16_t v)
+{
+    REG(reg) = v & 0xFF;
+    REG(reg + 1) = v >> 8;
+}
+
+//============================================Instruction handlers========================================
+// One handler per instruction, run through avr->ops[] (see decode()). avr->pc already points
+// past the first word; the handler returns the cycles taken, or -1 on an illegal opcode.
+// Operands come predecoded: d/r are register numbers (r also a bit number), k an immediate,
+// an absolute target, a data address, or the words a skip jumps over.
+#define HANDLER(name) \
+    static int name(__attribute__((unused)) struct AvrCore* avr, \
+                    __attribute__((unused)) const struct AvrOp* op)
+
+// Skip the next instruction (op->k words); returns the cycles of the skipping instruction
+static int skip(struct AvrCore* avr, const struct AvrOp* op)
+{
+    avr->pc = (avr->pc + op->k) & (AVR_FLASH_WORDS - 1);
+    return 1 + op->k;
+}
+
+// Store a (FMUL: fractional, shifted) product
+static int mulResult(struct AvrCore* avr, int32_t p, int shift)
+{
+    uint16_t u = (uint16_t)p;
+    flagsMul(avr, (uint16_t)(u << shift), BIT(u, 15));
+    return 2;
+}
+
+HANDLER(opIllegal) { return -1; }
+HANDLER(opNop) { return 1; }
+
+// Arithmetic and logic
+HANDLER(opAdd) { REG(op->d) = doAdd(avr, REG(op->d), REG(op->r), 0); return 1; }
+HANDLER(opAdc) { REG(op->d) = doAdd(avr, REG(op->d), REG(op->r), BIT(SREG, SREG_C)); return 1; }
+HANDLER(opSub) { REG(op->d) = doSub(avr, REG(op->d), REG(op->r), 0, 0); return 1; }
+HANDLER(opSbc) { REG(op->d) = doSub(avr, REG(op->d), REG(op->r), BIT(SREG, SREG_C), 1); return 1; }
+HANDLER(opCp) { doSub(avr, REG(op->d), REG(op->r), 0, 0); return 1; }
+HANDLER(opCpc) { doSub(avr, REG(op->d), REG(op->r), BIT(SREG, SREG_C), 1); return 1; }
+HANDLER(opAnd) { REG(op->d) &= REG(op->r); flagsLogic(avr, REG(op->d)); return 1; }
+HANDLER(opEor) { REG(op->d) ^= REG(op->r); flagsLogic(avr, REG(op->d)); return 1; }
+HANDLER(opOr) { REG(op->d) |= REG(op->r); flagsLogic(avr, REG(op->d)); return 1; }
+HANDLER(opMov) { REG(op->d) = REG(op->r); return 1; }
+HANDLER(opMovw) { REG(op->d) = REG(op->r); REG(op->d + 1) = REG(op->r + 1); return 1; }
+HANDLER(opCpi) { doSub(avr, REG(op->d), op->k, 0, 0); return 1; }
+HANDLER(opSubi) { REG(op->d) = doSub(avr, REG(op->d), op->k, 0, 0); return 1; }
+HANDLER(opSbci) { REG(op->d) = doSub(avr, REG(op->d), op->k, BIT(SREG, SREG_C), 1); return 1; }
+HANDLER(opOri) { REG(op->d) |= op->k; flagsLogic(avr, REG(op->d)); return 1; }
+HANDLER(opAndi) { REG(op->d) &= op->k; flagsLogic(avr, REG(op->d)); return 1; }
+HANDLER(opLdi) { REG(op->d) = op->k; return 1; }
+
+HANDLER(opCom)
+{
+    REG(op->d) = ~REG(op->d);
+    flagsLogic(avr, REG(op->d));
+    SREG |= 1 << SREG_C;
+    return 1;
+}
+
+HANDLER(opNeg) { REG(op->d) = doSub(avr, 0, REG(op->d), 0, 0); return 1; }
+HANDLER(opSwap) { REG(op->d) = (REG(op->d) << 4) | (REG(op->d) >> 4); return 1; }
+HANDLER(opInc) { REG(op->d)++; flagsZns(avr, REG(op->d), REG(op->d) == 0x80); return 1; }
+HANDLER(opDec) { REG(op->d)--; flagsZns(avr, REG(op->d), REG(op->d) == 0x7F); return 1; }
+
+HANDLER(opAsr)
+{
+    uint8_t r = REG(op->d);
+    REG(op->d) = (r >> 1) | (r & 0x80);
+    flagsShift(avr, REG(op->d), r & 1);
+    return 1;
+}
+
+HANDLER(opLsr)
+{
+    uint8_t r = REG(op->d);
+    REG(op->d) = r >> 1;
+    flagsShift(avr, REG(op->d), r & 1);
+    return 1;
+}
+
+HANDLER(opRor)
+{
+    uint8_t r = REG(op->d);
+    REG(op->d) = (r >> 1) | (BIT(SREG, SREG_C) << 7);
+    flagsShift(avr, REG(op->d), r & 1);
+    return 1;
+}
+
+// ADIW / SBIW on the pair at op->d
+static int addWord(struct AvrCore* avr, const struct AvrOp* op, int subtract)
+{
+    uint16_t w = pointer(avr, op->d);
+    uint16_t res;
+    uint8_t v, c;
+
+    if (subtract) {
+        res = w - op->k;
+        v = BIT(w, 15) & (BIT(res, 15) ^ 1);
+        c = BIT(res, 15) & (BIT(w, 15) ^ 1);
+    } else {
+        res = w + op->k;
+        v = (BIT(w, 15) ^ 1) & BIT(res, 15);
+        c = (BIT(res, 15) ^ 1) & BIT(w, 15);
+    }
+    setPointer(avr, op->d, res);
+    SREG = (SREG & ~0x1F) | c | ((res == 0) << SREG_Z) | (BIT(res, 15) << SREG_N)
+         | (v << SREG_V) | ((BIT(res, 15) ^ v) << SREG_S);
+    return 2;
+}
+
+HANDLER(opAdiw) { return addWord(avr, op, 0); }
+HANDLER(opSbiw) { return addWord(avr, op, 1); }
+
+// Multiplication
+HANDLER(opMul) { return mulResult(avr, REG(op->d) * REG(op->r), 0); }
+HANDLER(opMuls) { return mulResult(avr, (int8_t)REG(op->d) * (int8_t)REG(op->r), 0); }
+HANDLER(opMulsu) { return mulResult(avr, (int8_t)REG(op->d) * (uint8_t)REG(op->r), 0); }
+HANDLER(opFmul) { return mulResult(avr, (uint8_t)REG(op->d) * (uint8_t)REG(op->r), 1); }
+HANDLER(opFmuls) { return mulResult(avr, (int8_t)REG(op->d) * (int8_t)REG(op->r), 1); }
+HANDLER(opFmulsu) { return mulResult(avr, (int8_t)REG(op->d) * (uint8_t)REG(op->r), 1); }
+
+// Bits and flags
+HANDLER(opBclr) { SREG &= ~(1 << op->r); return 1; }
+
+HANDLER(opBset)
+{
+    if (op->r == SREG_I && !BIT(SREG, SREG_I)) {
+        avr->irqHold = 1; // The instruction after SEI always executes
+    }
+    SREG |= 1 << op->r;
+    return 1;
+}
+
+HANDLER(opBld) { REG(op->d) = (REG(op->d) & ~(1 << op->r)) | (BIT(SREG, SREG_T) << op->r); return 1; }
+HANDLER(opBst) { SREG = (SREG & ~(1 << SREG_T)) | (BIT(REG(op->d), op->r) << SREG_T); return 1; }
+
+// Data transfer; op->r is the pointer register (26 = X, 28 = Y, 30 = Z) where there is one
+HANDLER(opLdd) { REG(op->d) = avrReadData(avr, pointer(avr, op->r) + op->k); return 2; }
+HANDLER(opStd) { avrWriteData(avr, pointer(avr, op->r) + op->k, REG(op->d)); return 2; }
+
+HANDLER(opLdInc)
+{
+    uint16_t w = pointer(avr, op->r);
+    REG(op->d) = avrReadData(avr, w);
+    setPointer(avr, op->r, w + 1);
+    return 2;
+}
+
+HANDLER(opLdDec)
+{
+    uint16_t w = pointer(avr, op->r) - 1;
+    REG(op->d) = avrReadData(avr, w);
+    setPointer(avr, op->r, w);
+    return 2;
+}
+
+HANDLER(opStInc)
+{
+    uint16_t w = pointer(avr, op->r);
+    avrWriteData(avr, w, REG(op->d));
+    setPointer(avr, op->r, w + 1);
+    return 2;
+}
+
+HANDLER(opStDec)
+{
+    uint16_t w = pointer(avr, op->r) - 1;
+    avrWriteData(avr, w, REG(op->d));
+    setPointer(avr, op->r, w);
+    return 2;
+}
+
+HANDLER(opLds)
+{
+    avr->pc = (avr->pc + 1) & (AVR_FLASH_WORDS - 1);
+    REG(op->d) = avrReadData(avr, op->k);
+    return 2;
+}
+
+HANDLER(opSts)
+{
+    avr->pc = (avr->pc + 1) & (AVR_FLASH_WORDS - 1);
+    avrWriteData(avr, op->k, REG(op->d));
+    return 2;
+}
+
+static uint8_t flashByte(struct AvrCore* avr, uint16_t addr)
+{
+    return (avr->flash[(addr >> 1) & (AVR_FLASH_WORDS - 1)] >> ((addr & 1) * 8)) & 0xFF;
+}
+
+HANDLER(opLpm) { REG(op->d) = flashByte(avr, pointer(avr, 30)); return 3; }
+
+HANDLER(opLpmInc)
+{
+    uint16_t w = pointer(avr, 30);
+    REG(op->d) = flashByte(avr, w);
+    setPointer(avr, 30, w + 1);
+    return 3;
+}
+
+HANDLER(opPush) { push8(avr, REG(op->d)); return 2; }
+HANDLER(opPop) { REG(op->d) = pop8(avr); return 2; }
+
+// I/O space; op->k is the data-space address
+HANDLER(opIn) { REG(op->d) = avrReadData(avr, op->k); return 1; }
+HANDLER(opOut) { avrWriteData(avr, op->k, REG(op->d)); return 1; }
+
+HANDLER(opOutSreg)
+{
+    uint8_t wasEnabled = BIT(SREG, SREG_I);
+    avrWriteData(avr, AVR_SREG, REG(op->d));
+    if (!wasEnabled && BIT(SREG, SREG_I)) {
+        avr->irqHold = 1;
+    }
+    return 1;
+}
+
+HANDLER(opCbi) { avrWriteData(avr, op->d, avrReadData(avr, op->d) & ~(1 << op->r)); return 2; }
+HANDLER(opSbi) { avrWriteData(avr, op->d, avrReadData(avr, op->d) | (1 << op->r)); return 2; }
+HANDLER(opSbic) { return BIT(avrReadData(avr, op->d), op->r) ? 1 : skip(avr, op); }
+HANDLER(opSbis) { return BIT(avrReadData(avr, op->d), op->r) ? skip(avr, op) : 1; }
+
+// Control flow; op->k is the absolute target word address
+HANDLER(opCpse) { return REG(op->d) == REG(op->r) ? skip(avr, op) : 1; }
+HANDLER(opSbrc) { return BIT(REG(op->d), op->r) ? 1 : skip(avr, op); }
+HANDLER(opSbrs) { return BIT(REG(op->d), op->r) ? skip(avr, op) : 1; }
+
+HANDLER(opBrbs)
+{
+    if (BIT(SREG, op->r)) {
+        avr->pc = op->k;
+        return 2;
+    }
+    return 1;
+}
+
+HANDLER(opBrbc)
+{
+    if (!BIT(SREG, op->r)) {
+        avr->pc = op->k;
+        return 2;
+    }
+    return 1;
+}
+
+HANDLER(opRjmp) { avr->pc = op->k; return 2; }
+
+// Backward branches close loops, which idle.c watches for passes that change nothing
+HANDLER(opBrbsBack)
+{
+    if (BIT(SREG, op->r)) {
+        avr->pc = op->k;
+        idleEdge(avr, op);
+        return 2;
+    }
+    return 1;
+}
+
+HANDLER(opBrbcBack)
+{
+    if (!BIT(SREG, op->r)) {
+        avr->pc = op->k;
+        idleEdge(avr, op);
+        return 2;
+    }
+    return 1;
+}
+
+// BRNE closing a delay loop that only counts a register down (d, r bytes) from head k
+HANDLER(opBrneCount)
+{
+    if (!BIT(SREG, SREG_Z)) {
+        avr->pc = op->k;
+        idleCountdown(avr, op);
+        return 2;
+    }
+    return 1;
+}
+
+HANDLER(opRjmpBack) { avr->pc = op->k; idleEdge(avr, op); return 2; }
+
+HANDLER(opRjmpSelf)
+{
+    if (!BIT(SREG, SREG_I)) {
+        avr->stopReason = AVR_STOP_HALT; // "cli; rjmp ." can never leave
+    }
+    avr->pc = op->k;
+    idleEdge(avr, op);
+    return 2;
+}
+
+HANDLER(opJmp) { avr->pc = op->k; return 3; }
+HANDLER(opIjmp) { avr->pc = pointer(avr, 30) & (AVR_FLASH_WORDS - 1); return 2; }
+
+HANDLER(opRcall)
+{
+    pushPc(avr, avr->pc);
+    avr->pc = op->k;
+    enterFrame(avr, avr->pc, 0, avr->cycles);
+    return 3;
+}
+
+HANDLER(opCall)
+{
+    pushPc(avr, avr->pc + 1);
+    avr->pc = op->k;
+    enterFrame(avr, avr->pc, 0, avr->cycles);
+    return 4;
+}
+
+HANDLER(opIcall)
+{
+    pushPc(avr, avr->pc);
+    avr->pc = pointer(avr, 30) & (AVR_FLASH_WORDS - 1);
+    enterFrame(avr, avr->pc, 0, avr->cycles);
+    return 3;
+}
+
+// RET/RETI close their frame only after their own cycles are charged, so they charge the
+// four cycles themselves and report none
+HANDLER(opRet)
+{
+    avr->pc = popPc(avr) & (AVR_FLASH_WORDS - 1);
+    avr->cycles += 4;
+    leaveFrame(avr, 0);
+    return 0;
+}
+
+HANDLER(opReti)
+{
+    avr->pc = popPc(avr) & (AVR_FLASH_WORDS - 1);
+    SREG |= 1 << SREG_I;
+    avr->irqHold = 1;
+    avr->cycles += 4;
+    leaveFrame(avr, 1);
+    if (avr->isrDepth > 0) {
+        avr->isrDepth--;
+    }
+    return 0;
+}
+
+HANDLER(opSleep)
+{
+    if (avr->data[AVR_MCUCR] & AVR_SE) {
+        avr->sleeping = 1;
+    }
+    return 1;
+}
+
+HANDLER(opBreak)
+{
+    avr->stopReason = AVR_STOP_BREAK;
+    return 1;
+}
+
+//============================================Predecoder========================================
+// Translate the instruction at 'pc' into its handler and operands
+static void decode(const uint16_t* flash, uint16_t pc, struct AvrOp* out)
+{
+    uint16_t op = flash[pc];
+    uint16_t next = (pc + 1) & (AVR_FLASH_WORDS - 1);
+    AvrOpHandler run = opIllegal;
+    uint8_t d = RD5(op);
+    uint8_t r = RR5(op);
+    uint16_t k = avrOpcodeWords(flash[next]); // Words skipped by CPSE, SBRC, SBIC, ...
+    int bytes;
+
+    switch (op >> 12) {
+    case 0x0:
+        switch ((op >> 10) & 3) {
+        case 0:
+            if (op == 0x0000) {
+                run = opNop;
+                break;
+            }
+            switch ((op >> 8) & 3) {
+            case 1: // MOVW
+                run = opMovw;
+                d = ((op >> 4) & 0x0F) * 2;
+                r = (op & 0x0F) * 2;
+                break;
+            case 2: // MULS
+                run = opMuls;
+                d = RD4(op);
+                r = 16 + (op & 0x0F);
+                break;
+            case 3: { // MULSU, FMUL, FMULS, FMULSU
+                static const AvrOpHandler mul[4] = { opMulsu, opFmul, opFmuls, opFmulsu };
+                run = mul[((op >> 3) & 1) | ((op >> 6) & 2)];
+                d = 16 + ((op >> 4) & 7);
+                r = 16 + (op & 7);
+                break;
+            }
+            }
+            break;
+        case 1: run = opCpc; break;
+        case 2: run = opSbc; break;
+        default: run = opAdd; break; // ADD / LSL
+        }
+        break;
+
+    case 0x1:
+        switch ((op >> 10) & 3) {
+        case 0: run = opCpse; break;
+        case 1: run = opCp; break;
+        case 2: run = opSub; break;
+        default: run = opAdc; break; // ADC / ROL
+        }
+        break;
+
+    case 0x2: {
+        static const AvrOpHandler logic[4] = { opAnd, opEor, opOr, opMov };
+        run = logic[(op >> 10) & 3];
+        break;
+    }
+
+    case 0x3: case 0x4: case 0x5: case 0x6: case 0x7: case 0xE: {
+        static const AvrOpHandler immediate[16] = {
+            [0x3] = opCpi, [0x4] = opSbci, [0x5] = opSubi, [0x6] = opOri, [0x7] = opAndi,
+            [0xE] = opLdi
+        };
+        run = immediate[op >> 12];
+        d = RD4(op);
+        k = K8(op);
+        break;
+    }
+
+    case 0x8:
+    case 0xA: // LDD / STD with displacement (LD/ST Y, Z when q = 0)
+        run = (op & 0x0200) ? opStd : opLdd;
+        r = (op & 0x08) ? 28 : 30;
+        k = Q6(op);
+        break;
+
+    case 0x9:
+        if ((op & 0x0C00) == 0x0000) { // 1001 00xd: loads, stores, PUSH/POP, LPM
+            int store = (op >> 9) & 1;
+            switch (op & 0x0F) {
+            case 0x0: // LDS / STS
+                run = store ? opSts : opLds;
+                k = flash[next];
+                break;
+            case 0x4: case 0x5: // LPM Rd, Z / Z+
+                if (!store) {
+                    run = (op & 1) ? opLpmInc : opLpm;
+                }
+                break;
+            case 0xF:
+                run = store ? opPush : opPop;
+                break;
+            case 0x1: case 0x2: case 0x9: case 0xA: case 0xC: case 0xD: case 0xE: {
+                // Plain LD/ST X; Y and Z without displacement are LDD/STD with q = 0
+                static const AvrOpHandler load[3] = { opLdd, opLdInc, opLdDec };
+                static const AvrOpHandler save[3] = { opStd, opStInc, opStDec };
+                run = store ? save[op & 3] : load[op & 3];
+                r = (op & 0x0C) == 0x0C ? 26 : ((op & 0x08) ? 28 : 30);
+                k = 0;
+                break;
+            }
+            }
+            break;
+        }
+        if ((op & 0x0E00) == 0x0400) { // 1001 010x: one-operand and misc
+            static const AvrOpHandler single[16] = {
+                [0x0] = opCom, [0x1] = opNeg, [0x2] = opSwap, [0x3] = opInc, [0x5] = opAsr,
+                [0x6] = opLsr, [0x7] = opRor, [0xA] = opDec
+            };
+            switch (op & 0x0F) {
+            case 0x8:
+                if ((op & 0xFF0F) == 0x9408) { // BSET / BCLR (SEI, CLI, SEC, ...)
+                    run = (op & 0x80) ? opBclr : opBset;
+                    r = (op >> 4) & 7;
+                    break;
+                }
+                switch (op) {
+                case 0x9508: run = opRet; break;
+                case 0x9518: run = opReti; break;
+                case 0x9588: run = opSleep; break;
+                case 0x9598: run = opBreak; break;
+                case 0x95A8: run = opNop; break; // WDR
+                case 0x95C8: run = opLpm; d = 0; break; // LPM (r0 implied)
+                case 0x95E8: run = opNop; break; // SPM - self-programming is not modeled
+                }
+                break;
+            case 0x9:
+                if (op == 0x9409) {
+                    run = opIjmp;
+                } else if (op == 0x9509) {
+                    run = opIcall;
+                }
+                break;
+            case 0xC: case 0xD: case 0xE: case 0xF: // JMP / CALL
+                run = (op & 2) ? opCall : opJmp;
+                k = flash[next] & (AVR_FLASH_WORDS - 1);
+                break;
+            default:
+                if (single[op & 0x0F]) {
+                    run = single[op & 0x0F];
+                }
+                break;
+            }
+            break;
+        }
+        if ((op & 0x0E00) == 0x0600) { // ADIW / SBIW
+            run = (op & 0x0100) ? opSbiw : opAdiw;
+            d = 24 + ((op >> 3) & 0x06);
+            k = ((op >> 2) & 0x30) | (op & 0x0F);
+            break;
+        }
+        if ((op & 0x0C00) == 0x0800) { // CBI / SBIC / SBI / SBIS
+            static const AvrOpHandler bitIo[4] = { opCbi, opSbic, opSbi, opSbis };
+            run = bitIo[(op >> 8) & 3];
+            d = AVR_IO_BASE + ((op >> 3) & 0x1F);
+            r = op & 7;
+            break;
+        }
+        run = opMul;
+        break;
+
+    case 0xB: // IN / OUT
+        k = AVR_IO_BASE + IOA6(op);
+        run = !(op & 0x0800) ? opIn : (k == AVR_SREG ? opOutSreg : opOut);
+        break;
+
+    case 0xC: // RJMP
+        run = (op & 0x0FFF) == 0x0FFF ? opRjmpSelf : (op & 0x0800) ? opRjmpBack : opRjmp;
+        k = (next + ((int16_t)(op << 4) >> 4)) & (AVR_FLASH_WORDS - 1);
+        break;
+
+    case 0xD: // RCALL
+        run = opRcall;
+        k = (next + ((int16_t)(op << 4) >> 4)) & (AVR_FLASH_WORDS - 1);
+        break;
+
+    default: // 0xF
+        if ((op & 0x0800) == 0) { // BRBS / BRBC
+            run = (op & 0x0400) ? opBrbc : opBrbs;
+            r = op & 7;
+            k = (next + ((int8_t)((op >> 2) & 0xFE) >> 1)) & (AVR_FLASH_WORDS - 1);
+            if (op & 0x0200) { // Backward
+                run = (op & 0x0400) ? opBrbcBack : opBrbsBack;
+                if (r == SREG_Z && run == opBrbcBack
+                    && (bytes = idleCountdownBytes(flash, k, pc, &d)) != 0) {
+                    run = opBrneCount;
+                    r = bytes;
+                }
+            }
+        } else if (!(op & 0x0008)) {
+            static const AvrOpHandler bitReg[4] = { opBld, opBst, opSbrc, opSbrs };
+            run = bitReg[(op >> 9) & 3];
+            r = op & 7;
+        }
+        break;
+    }
+    out->run = run;
+    out->d = d;
+    out->r = r;
+    out->k = k;
+    out->backoff = IDLE_FIRST_BACKOFF;
+    out->wait = 1 << IDLE_FIRST_BACKOFF;
+}
+
+// Initial handler of every flash word: predecode on first execution, then run
+HANDLER(opDecode)
+{
+    uint16_t pc = (uint16_t)(op - avr->ops);
+
+    decode(avr->flash, pc, &avr->ops[pc]);
+    return avr->ops[pc].run(avr, &avr->ops[pc]);
+}
+
+// Drop every predecoded instruction; must follow any change to avr->flash
+void avrFlashChanged(struct AvrCore* avr)
+{
+    for (int i = 0; i < AVR_FLASH_WORDS; i++) {
+        avr->ops[i].run = opDecode;
+    }
+}
+
+//============================================Interrupts========================================
+// Follow the I flag and keep the longest interrupts-disabled window.
+// 'at' is the cycle of the change, 'pc' the instruction (or vector) that made it.
+static void trackMask(struct AvrCore* avr, uint64_t at, uint16_t pc)
+{
+    struct AvrMaskTiming* m = &avr->mask;
+    uint8_t enabled = BIT(SREG, SREG_I);
+
+    if (enabled == avr->irqEnabled) {
+        return;
+    }
+    avr->irqEnabled = enabled;
+    if (!enabled) {
+        m->start = at;
+        m->startPc = pc;
+    } else if (m->start != UINT64_MAX) {
+        m->windows++;
+        if (at - m->start > m->longest) {
+            m->longest = at - m->start;
+            m->longestPc = m->startPc;
+            m->longestAt = m->start;
+        }
+    } else {
+        m->start = 0; // First SEI: start tracking from here on
+    }
+}
+
+// Take the pending interrupt: push PC, clear I, jump to the vector
+static void serviceIrq(struct AvrCore* avr)
+{
+    uint8_t vector = avr->pendingVector;
+    uint64_t start = avr->cycles;
+    struct AvrIrqTiming* t = &avr->irqTiming[vector];
+    uint32_t latency = (uint32_t)(start - t->raised);
+
+    for (int i = 0; i < avr->irqCount; i++) {
+        const struct AvrIrqSource* s = &avr->irq[i];
+        if (s->vector == vector && s->autoClear) {
+            avr->data[s->flagAddr] &= ~s->flagMask;
+        }
+    }
+    if (avr->sleeping) {
+        avr->sleeping = 0;
+        avr->wakeups++;
+        avr->cycles += AVR_IRQ_CYCLES; // Wake-up adds four cycles to the response time
+    }
+    pushPc(avr, avr->pc);
+    SREG &= ~(1 << SREG_I);
+    avr->pc = vector * 2;
+    avr->cycles += AVR_IRQ_CYCLES;
+    enterFrame(avr, vector, 1, start);
+    avrUpdateIrq(avr);
+    trackMask(avr, start, vector * 4); // Byte address of the vector
+    if (avr->isrDepth < AVR_ISR_DEPTH) {
+        avr->isrStack[avr->isrDepth++] = vector;
+    }
+
+    if (t->entries == 0 || latency < t->minLatency) {
+        t->minLatency = latency;
+    }
+    if (latency > t->maxLatency) {
+        t->maxLatency = latency;
+    }
+    t->histogram[avrLatencyBin(latency)]++;
+    if (t->entries > 0) {
+        uint32_t period = (uint32_t)(start - t->lastEntry);
+        if (t->entries == 1 || period < t->minPeriod) {
+            t->minPeriod = period;
+        }
+        if (period > t->maxPeriod) {
+            t->maxPeriod = period;
+        }
+    }
+    t->lastEntry = start;
+    t->entries++;
+}
+
+//============================================Execution========================================
+// Run the predecoded instruction at avr->pc and charge its cycles; returns -1 on an illegal
+// opcode (left unexecuted, with the stop reason set)
+static inline int dispatch(struct AvrCore* avr)
+{
+    uint16_t pc = avr->pc;
+    const struct AvrOp* op = &avr->ops[pc];
+    int cycles;
+
+    if (pc == avr->countPc && pc != 0) {
+        avr->countHits++;
+    }
+    avr->pc = (pc + 1) & (AVR_FLASH_WORDS - 1);
+    cycles = op->run(avr, op);
+    if (cycles < 0) {
+        avr->pc = pc;
+        avr->stopReason = AVR_STOP_ILLEGAL;
+        return -1;
+    }
+    avr->cycles += cycles;
+    avr->instructions++;
+    if (BIT(SREG, SREG_I) != avr->irqEnabled) {
+        trackMask(avr, avr->cycles, pc * 2);
+    }
+    return 0;
+}
+
+// Execute one instruction (or take one interrupt, or sleep until the next event).
+// Returns the stop reason, AVR_STOP_NONE while the program can keep running.
+int avrStep(struct AvrCore* avr)
+{
+    if (avr->cycles >= avr->nextEvent) {
+        runEvents(avr);
+    }
+    if (__builtin_expect(avr->vcd != NULL, 0)) {
+        vcdSample(avr);
+    }
+    if (__builtin_expect(avr->prof != NULL, 0)) {
+        profSample(avr);
+    }
+
+    if (avr->pendingVector && BIT(SREG, SREG_I) && !avr->irqHold) {
+        serviceIrq(avr);
+        return avr->stopReason;
+    }
+
+    if (avr->sleeping) {
+        // Nothing happens until a peripheral event; jump straight to it
+        if (avr->nextEvent == UINT64_MAX) {
+            avr->stopReason = AVR_STOP_SLEEP;
+            return avr->stopReason;
+        }
+        avr->sleepCycles += avr->nextEvent - avr->cycles;
+        avr->cycles = avr->nextEvent;
+        return avr->stopReason;
+    }
+
+    avr->irqHold = 0;
+
+    if (avr->trace) {
+        char text[64];
+        avrDisasm(avr->flash, avr->pc, text, sizeof(text));
+        fprintf(avr->trace, "%10llu  %04x: %-28s SREG=%02x SP=%04x\n",
+                (unsigned long long)avr->cycles, avr->pc * 2, text,
+                SREG, getSp(avr));
+    }
+
+    dispatch(avr);
+    return avr->stopReason;
+}
+
+// Threaded inner loop of avrRun(): predecoded handlers back to back, with none of the
+// per-step checks that only matter at an event, an interrupt or a sleep. Returns at 'limit',
+// at the next peripheral event, when an interrupt can be taken, on SLEEP or on a stop, all of
+// which avrStep() then handles exactly as if every instruction had been stepped.
+static void runThreaded(struct AvrCore* avr, uint64_t limit)
+{
+    if (avr->sleeping || avr->stopReason != AVR_STOP_NONE) {
+        return;
+    }
+    // Idle loops may be skipped up to the first event or 'limit', never across either
+    avr->idle.limit = avr->idle.disabled ? 0 : limit;
+    avr->idle.branch = NULL;
+    while (avr->cycles < limit && avr->cycles < avr->nextEvent) {
+        if (avr->pendingVector && BIT(SREG, SREG_I) && !avr->irqHold) {
+            break;
+        }
+        avr->irqHold = 0;
+        dispatch(avr);
+        if (__builtin_expect(avr->sleeping | avr->stopReason, 0)) {
+            break;
+        }
+    }
+    avr->idle.limit = 0;
+}
+
+// Run until the cycle counter reaches 'cycleLimit' or the program stops
+int avrRun(struct AvrCore* avr, uint64_t cycleLimit)
+{
+    if (avr->stopReason == AVR_STOP_CYCLES) {
+        avr->stopReason = AVR_STOP_NONE; // A run in slices continues where the last one ended
+    }
+    while (avr->cycles < cycleLimit) {
+        // A sleep that outlasts the budget ends exactly at the limit
+        if (avr->sleeping && avr->nextEvent > cycleLimit
+            && !(avr->pendingVector && BIT(SREG, SREG_I))) {
+            if (avr->nextEvent == UINT64_MAX) {
+                break; // Let avrStep() report the dead sleep
+            }
+            avr->sleepCycles += cycleLimit - avr->cycles;
+            avr->cycles = cycleLimit;
+            break;
+        }
+        // Tracing, waveforms and cycle attribution need every instruction to pass through avrStep()
+        if (!avr->trace && !avr->vcd && !avr->prof) {
+            runThreaded(avr, cycleLimit);
+            if (avr->stopReason != AVR_STOP_NONE) {
+                return avr->stopReason;
+            }
+            if (avr->cycles >= cycleLimit) {
+                break;
+            }
+        }
+        if (avrStep(avr) != AVR_STOP_NONE) {
+            return avr->stopReason;
+        }
+    }
+    if (avr->cycles < cycleLimit) {
+        return avrStep(avr);
+    }
+    avr->stopReason = AVR_STOP_CYCLES;
+    return avr->stopReason;
+}
@@ -0,0 +1,179 @@
+//===========================================================================================
+// Project: ATmega32A Host-Side Simulator
+// Compiler: gcc (host, C99)
+// Target microcontroller: ATmega32A (simulated)
+// Description: One-line disassembler for the instruction trace. Output follows avr-objdump
+//              mnemonics; branch and call targets are printed as byte addresses.
+// Date created: 2026-10-16
+//===========================================================================================
+
+//============================================Libraries========================================
+#include "avrsim.h"
+
+//============================================Defines========================================
+#define RD5(op)  (((op) >> 4) & 0x1F)
+#define RR5(op)  ((((op) >> 5) & 0x10) | ((op) & 0x0F))
+#define RD4(op)  (16 + (((op) >> 4) & 0x0F))
+#define K8(op)   ((((op) >> 4) & 0xF0) | ((op) & 0x0F))
+#define IOA6(op) ((((op) >> 5) & 0x30) | ((op) & 0x0F))
+#define Q6(op)   ((((op) >> 8) & 0x20) | (((op) >> 7) & 0x18) | ((op) & 0x07))
+
+//============================================Tables========================================
+static const char* const aluNames[16] = {
+    "", "cpc", "sbc", "add", "cpse", "cp", "sub", "adc", "and", "eor", "or", "mov",
+    "cpi", "sbci", "subi", "ori"
+};
+static const char* const oneOpNames[16] = {
+    "com", "neg", "swap", "inc", NULL, "asr", "lsr", "ror", NULL, NULL, "dec",
+    NULL, NULL, NULL, NULL, NULL
+};
+static const char* const setNames[8] = { "sec", "sez", "sen", "sev", "ses", "seh", "set", "sei" };
+static const char* const clrNames[8] = { "clc", "clz", "cln", "clv", "cls", "clh", "clt", "cli" };
+static const char* const brsNames[8] = { "brcs", "breq", "brmi", "brvs", "brlt", "brhs", "brts", "brie" };
+static const char* const brcNames[8] = { "brcc", "brne", "brpl", "brvc", "brge", "brhc", "brtc", "brid" };
+static const char* const ptrModes[16] = {
+    NULL, "Z+", "-Z", NULL, NULL, NULL, NULL, NULL, NULL, "Y+", "-Y", NULL, "X", "X+", "-X", NULL
+};
+
+//============================================Functions========================================
+// Disassemble the instruction at word address 'pc' into 'buf'; returns its size in words
+int avrDisasm(const uint16_t* flash, uint16_t pc, char* buf, size_t len)
+{
+    uint16_t op = flash[pc];
+    uint16_t next = flash[(pc + 1) & (AVR_FLASH_WORDS - 1)];
+    int words = avrOpcodeWords(op);
+
+    switch (op >> 12) {
+    case 0x0:
+        if (op == 0x0000) {
+            snprintf(buf, len, "nop");
+        } else if ((op & 0xFF00) == 0x0100) {
+            snprintf(buf, len, "movw r%d, r%d", ((op >> 4) & 0x0F) * 2, (op & 0x0F) * 2);
+        } else if ((op & 0xFF00) == 0x0200) {
+            snprintf(buf, len, "muls r%d, r%d", RD4(op), 16 + (op & 0x0F));
+        } else if ((op & 0xFF00) == 0x0300) {
+            static const char* const m[4] = { "mulsu", "fmul", "fmuls", "fmulsu" };
+            snprintf(buf, len, "%s r%d, r%d", m[((op >> 6) & 2) | ((op >> 3) & 1)],
+                     16 + ((op >> 4) & 7), 16 + (op & 7));
+        } else if ((op & 0x0C00) == 0x0C00 && RD5(op) == RR5(op)) {
+            snprintf(buf, len, "lsl r%d", RD5(op));
+        } else if ((op & 0x0C00) != 0) {
+            snprintf(buf, len, "%s r%d, r%d", aluNames[(op >> 10) & 3], RD5(op), RR5(op));
+        } else {
+            snprintf(buf, len, ".word 0x%04x", op);
+        }
+        break;
+    case 0x1:
+    case 0x2:
+        if ((op & 0xFC00) == 0x1C00 && RD5(op) == RR5(op)) {
+            snprintf(buf, len, "rol r%d", RD5(op));
+        } else if ((op & 0xFC00) == 0x2000 && RD5(op) == RR5(op)) {
+            snprintf(buf, len, "tst r%d", RD5(op));
+        } else if ((op & 0xFC00) == 0x2400 && RD5(op) == RR5(op)) {
+            snprintf(buf, len, "clr r%d", RD5(op));
+        } else {
+            snprintf(buf, len, "%s r%d, r%d", aluNames[(op >> 10) & 0x0F], RD5(op), RR5(op));
+        }
+        break;
+    case 0x3: case 0x4: case 0x5: case 0x6:
+        snprintf(buf, len, "%s r%d, 0x%02X", aluNames[(op >> 12) + 9], RD4(op), K8(op));
+        break;
+    case 0x7:
+        snprintf(buf, len, "andi r%d, 0x%02X", RD4(op), K8(op));
+        break;
+    case 0x8:
+    case 0xA:
+        if (op & 0x0200) {
+            snprintf(buf, len, "std %c+%d, r%d", (op & 0x08) ? 'Y' : 'Z', Q6(op), RD5(op));
+        } else {
+            snprintf(buf, len, "ldd r%d, %c+%d", RD5(op), (op & 0x08) ? 'Y' : 'Z', Q6(op));
+        }
+        break;
+    case 0x9:
+        if ((op & 0x0C00) == 0x0000) {
+            int store = (op >> 9) & 1;
+            switch (op & 0x0F) {
+            case 0x0:
+                if (store) {
+                    snprintf(buf, len, "sts 0x%04X, r%d", next, RD5(op));
+                } else {
+                    snprintf(buf, len, "lds r%d, 0x%04X", RD5(op), next);
+                }
+                break;
+            case 0x4: snprintf(buf, len, "lpm r%d, Z", RD5(op)); break;
+            case 0x5: snprintf(buf, len, "lpm r%d, Z+", RD5(op)); break;
+            case 0xF: snprintf(buf, len, "%s r%d", store ? "push" : "pop", RD5(op)); break;
+            default:
+                if (ptrModes[op & 0x0F]) {
+                    if (store) {
+                        snprintf(buf, len, "st %s, r%d", ptrModes[op & 0x0F], RD5(op));
+                    } else {
+                        snprintf(buf, len, "ld r%d, %s", RD5(op), ptrModes[op & 0x0F]);
+                    }
+                } else {
+                    snprintf(buf, len, ".word 0x%04x", op);
+                }
+            }
+        } else if ((op & 0x0E00) == 0x0400) {
+            int sub = op & 0x0F;
+            if (oneOpNames[sub]) {
+                snprintf(buf, len, "%s r%d", oneOpNames[sub], RD5(op));
+            } else if ((op & 0xFF0F) == 0x9408) {
+                snprintf(buf, len, "%s", (op & 0x80) ? clrNames[(op >> 4) & 7] : setNames[(op >> 4) & 7]);
+            } else if (sub == 0xC || sub == 0xD || sub == 0xE || sub == 0xF) {
+                snprintf(buf, len, "%s 0x%x", sub < 0xE ? "jmp" : "call", next * 2);
+            } else {
+                switch (op) {
+                case 0x9508: snprintf(buf, len, "ret"); break;
+                case 0x9518: snprintf(buf, len, "reti"); break;
+                case 0x9588: snprintf(buf, len, "sleep"); break;
+                case 0x9598: snprintf(buf, len, "break"); break;
+                case 0x95A8: snprintf(buf, len, "wdr"); break;
+                case 0x95C8: snprintf(buf, len, "lpm"); break;
+                case 0x95E8: snprintf(buf, len, "spm"); break;
+                case 0x9409: snprintf(buf, len, "ijmp"); break;
+                case 0x9509: snprintf(buf, len, "icall"); break;
+                default: snprintf(buf, len, ".word 0x%04x", op);
+                }
+            }
+        } else if ((op & 0x0E00) == 0x0600) {
+            snprintf(buf, len, "%s r%d, 0x%02X", (op & 0x0100) ? "sbiw" : "adiw",
+                     24 + ((op >> 3) & 0x06), ((op >> 2) & 0x30) | (op & 0x0F));
+        } else if ((op & 0x0C00) == 0x0800) {
+            static const char* const m[4] = { "cbi", "sbic", "sbi", "sbis" };
+            snprintf(buf, len, "%s 0x%02X, %d", m[(op >> 8) & 3], (op >> 3) & 0x1F, op & 7);
+        } else {
+            snprintf(buf, len, "mul r%d, r%d", RD5(op), RR5(op));
+        }
+        break;
+    case 0xB:
+        if (op & 0x0800) {
+            snprintf(buf, len, "out 0x%02X, r%d", IOA6(op), RD5(op));
+        } else {
+            snprintf(buf, len, "in r%d, 0x%02X", RD5(op), IOA6(op));
+        }
+        break;
+    case 0xC:
+    case 0xD:
+        snprintf(buf, len, "%s .%+d ; 0x%x", (op >> 12) == 0xC ? "rjmp" : "rcall",
+                 ((int16_t)(op << 4) >> 4) * 2,
+                 ((pc + 1 + ((int16_t)(op << 4) >> 4)) & (AVR_FLASH_WORDS - 1)) * 2);
+        break;
+    case 0xE:
+        snprintf(buf, len, "ldi r%d, 0x%02X", RD4(op), K8(op));
+        break;
+    default:
+        if ((op & 0x0800) == 0) {
+            int offset = (int8_t)((op >> 2) & 0xFE) >> 1;
+            snprintf(buf, len, "%s .%+d ; 0x%x", (op & 0x0400) ? brcNames[op & 7] : brsNames[op & 7],
+                     offset * 2, ((pc + 1 + offset) & (AVR_FLASH_WORDS - 1)) * 2);
+        } else if ((op & 0x0008) == 0) {
+            static const char* const m[4] = { "bld", "bst", "sbrc", "sbrs" };
+            snprintf(buf, len, "%s r%d, %d", m[(op >> 9) & 3], RD5(op), op & 7);
+        } else {
+            snprintf(buf, len, ".word 0x%04x", op);
+        }
+        break;
+    }
+    return words;
+}
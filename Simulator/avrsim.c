@@ -0,0 +1,431 @@
+//===========================================================================================
+// Project: ATmega32A Host-Side Simulator
+// Compiler: gcc (host, C99)
+// Target microcontroller: ATmega32A (simulated)
+// Description: Command line front end. Loads an example .hex image (or the a.out ELF next to
+//              it, which adds function names and, with -g, source lines), runs it for a given
+//              amount of simulated time and reports exact cycle counts per called function
+//              and per interrupt vector. In place of the image it takes a snapshot written by
+//              -w and carries on from there; pin and stimulus times then count from the
+//              snapshot, and the totals include the run that led up to it.
+//
+// Usage:   avrsim [options] image.hex|a.out|state.snap
+//   -F hz          CPU clock used to convert cycles to time (default 8000000)
+//   -c cycles      Run this many cycles
+//   -f file        Write folded call stacks with their cycles to 'file' (flamegraph.pl input)
+//   -s seconds     Run this much simulated time (default 1; 0 only patches and saves)
+//   -i P<n>=<0|1|z>[@seconds]
+//                  Drive (or release, z) an input pin, from the start or at a simulated time,
+//                  e.g. -i D6=0 -i D2=1@0.25 -i D2=0@0.40 (may be repeated)
+//   -P addr=value[:bytes]
+//                  Patch 'bytes' bytes (default 4, little-endian) of a snapshot's SRAM before
+//                  it runs, e.g. -P 0x60=0xFFFFFC00 to start millisCounter 1 s before its wrap
+//   -L             Charge every cycle to its call stack, function, source line and instruction
+//                  and print the hottest of each
+//   -l addr        Count executions of the instruction at byte address 'addr' (loop counter)
+//   -m addr        Treat the 32-bit SRAM variable at 'addr' as a millisecond counter and
+//                  report its drift against simulated time (e.g. -m 0x60 for millisCounter)
+//   -n             Execute every pass of idle loops instead of fast-forwarding them
+//   -p             Print the per-function / per-ISR cycle profile
+//   -S file        Apply the timed pin changes and bounce bursts of a stimulus script
+//                  (format in stimulus.c)
+//   -t             Trace every executed instruction to stdout
+//   -u file        Write every byte the USART transmits to 'file' (tracedump decodes it)
+//   -v file.vcd    Record a VCD waveform of the run (GTKWave)
+//   -V signals     Comma separated signals for -v: pins (PD6), ports (PINB), I/O registers
+//                  or their bits (TIFR.1), TCNT0, irq, I, sleep, pc (default
+//                  PINA,PINB,PINC,PIND,TCNT0,TIFR,irq,I,sleep)
+//   -w file        Write a snapshot of the machine at the end of the run
+//
+// Build:   make   (inside this directory)
+// Date created: 2026-10-16
+//===========================================================================================
+
+//============================================Libraries========================================
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "avrsim.h"
+
+//============================================Defines========================================
+#define DEFAULT_F_CPU 8000000UL // Matches the Timer0 and debounce examples
+
+static const char* const stopNames[] = {
+    "running", "cycle limit reached", "sleeping with no wake-up source",
+    "halted (cli; rjmp .)", "illegal opcode", "break"
+};
+
+//============================================Functions========================================
+static void usage(const char* prog)
+{
+    fprintf(stderr,
+            "usage: %s [-F hz] [-c cycles | -s seconds] [-i P<n>=<0|1|z>[@s]] [-S stimulus] [-l addr] [-m addr] [-n] [-p] [-t] [-u file] [-v file.vcd [-V signals]]"
+            " [-P addr=value[:bytes]] [-w file] [-L] [-f folded.txt]\n"
+            "          image.hex|a.out|state.snap\n",
+            prog);
+    exit(2);
+}
+
+// Parse "D6=0" or "D2=1@0.25" into a pin drive; the time needs the final clock frequency
+static int parsePin(struct AvrCore* avr, const char* arg, double fCpu)
+{
+    char port = arg[0];
+    const char* at = strchr(arg, '@');
+    uint8_t level;
+
+    if (port >= 'a' && port <= 'd') {
+        port -= 'a' - 'A';
+    }
+    if (port < 'A' || port > 'D' || arg[1] < '0' || arg[1] > '7' || arg[2] != '=') {
+        return -1;
+    }
+    level = (arg[3] == 'z' || arg[3] == 'Z') ? 2 : atoi(&arg[3]) != 0;
+    if (at) {
+        return gpioSchedule(avr, port, arg[1] - '0', level,
+                            avr->cycles + (uint64_t)(atof(at + 1) * fCpu));
+    }
+    if (level > 1) {
+        gpioRelease(avr, port, arg[1] - '0');
+    } else {
+        gpioSetInput(avr, port, arg[1] - '0', level);
+    }
+    return 0;
+}
+
+// Parse "0x60=0xFFFFFC00" or "0x70=1:1" and apply it to a snapshot
+static int parsePatch(struct AvrSnapshot* snap, const char* arg)
+{
+    char* end;
+    unsigned long addr = strtoul(arg, &end, 0);
+    uint64_t value;
+    int bytes = 4;
+
+    if (end == arg || *end != '=') {
+        return -1;
+    }
+    arg = end + 1;
+    value = strtoull(arg, &end, 0);
+    if (end == arg) {
+        return -1;
+    }
+    if (*end == ':') {
+        bytes = atoi(end + 1);
+    } else if (*end) {
+        return -1;
+    }
+    return addr > 0xFFFF ? -1 : snapPatch(snap, (uint16_t)addr, value, bytes);
+}
+
+// Print a cycle count together with its duration at the configured clock
+static void printCycles(uint64_t cycles, double fCpu)
+{
+    printf("%12llu cycles (%.3f us)", (unsigned long long)cycles, cycles * 1e6 / fCpu);
+}
+
+static void printProfile(const struct AvrCore* avr, const struct AvrSymbols* syms)
+{
+    printf("\nFunctions (CALL .. RET inclusive):\n");
+    printf("  %-8s %10s %8s %8s %10s %14s %14s\n",
+           "address", "calls", "min", "max", "avg", "inclusive", "exclusive");
+    for (int a = 0; a < AVR_FLASH_WORDS; a++) {
+        const struct AvrFuncStats* s = &avr->funcStats[a];
+        const struct AvrSymbol* sym = symFind(syms, a * 2);
+        if (s->calls == 0) {
+            continue;
+        }
+        printf("  0x%04x   %10u %8u %8u %10.1f %14llu %14llu", a * 2, s->calls, s->min, s->max,
+               (double)s->inclusive / s->calls, (unsigned long long)s->inclusive,
+               (unsigned long long)s->exclusive);
+        printf(sym && sym->addr == a * 2u ? "  %s\n" : "\n", sym ? sym->name : "");
+    }
+
+    printf("\nInterrupts (response .. RETI inclusive):\n");
+    printf("  %-16s %10s %8s %8s %10s %14s\n", "vector", "entries", "min", "max", "avg", "total");
+    for (int v = 1; v < AVR_VECTOR_COUNT; v++) {
+        const struct AvrFuncStats* s = &avr->irqStats[v];
+        if (s->calls == 0) {
+            continue;
+        }
+        printf("  %2d %-13s %10u %8u %8u %10.1f %14llu  (%.2f%% of CPU)\n", v, avrVectorName(v),
+               s->calls, s->min, s->max, (double)s->inclusive / s->calls,
+               (unsigned long long)s->inclusive, 100.0 * s->inclusive / avr->cycles);
+    }
+}
+
+// Active vs sleeping cycles per simulated second
+static void printDuty(const struct AvrCore* avr, double fCpu)
+{
+    double seconds = avr->cycles / fCpu;
+    uint64_t active = avr->cycles - avr->sleepCycles;
+
+    if (seconds <= 0) {
+        return;
+    }
+    printf("  per second: %.0f active + %.0f sleeping cycles (%.2f%% duty), %.1f wake-ups\n",
+           active / seconds, avr->sleepCycles / seconds, 100.0 * active / avr->cycles,
+           avr->wakeups / seconds);
+}
+
+// I/O registers written during the run, with the external interrupt counters
+static void printIo(const struct AvrCore* avr)
+{
+    printf("  I/O writes:");
+    for (int i = 0; i < AVR_IO_SIZE; i++) {
+        if (avr->ioWrites[i]) {
+            printf(" 0x%02x=%llu", AVR_IO_BASE + i, (unsigned long long)avr->ioWrites[i]);
+        }
+    }
+    printf("\n");
+    if (avr->extint.requests || avr->extint.missed) {
+        printf("  external interrupts: %llu requests, %llu edges missed in sleep\n",
+               (unsigned long long)avr->extint.requests, (unsigned long long)avr->extint.missed);
+    }
+    if (avr->usart.txBytes) {
+        printf("  USART: %llu bytes transmitted, %u cycles per frame\n",
+               (unsigned long long)avr->usart.txBytes, usartFrameCycles(avr));
+    }
+}
+
+// Latency histogram of one vector, empty bins skipped
+static void printHistogram(const struct AvrIrqTiming* t)
+{
+    printf("     latency histogram:");
+    for (int b = 0; b < AVR_LATENCY_BINS; b++) {
+        uint32_t low = b ? 1u << (b - 1) : 0;
+        if (t->histogram[b] == 0) {
+            continue;
+        }
+        if (b == AVR_LATENCY_BINS - 1) {
+            printf(" %u+:%llu", low, (unsigned long long)t->histogram[b]);
+        } else if (b < 2) {
+            printf(" %u:%llu", low, (unsigned long long)t->histogram[b]);
+        } else {
+            printf(" %u-%u:%llu", low, low * 2 - 1, (unsigned long long)t->histogram[b]);
+        }
+    }
+    printf("\n");
+}
+
+// Interrupt entry timing and Timer0 tick accuracy
+static void printTiming(struct AvrCore* avr, double fCpu, int counterAddr)
+{
+    uint32_t period = timer0Period(avr);
+
+    printf("\nTimer0: %llu compare matches, %llu overflows",
+           (unsigned long long)avr->timer0.matches, (unsigned long long)avr->timer0.overflows);
+    if (period) {
+        printf(", CTC period %u cycles = %.3f us", period, period * 1e6 / fCpu);
+    }
+    printf("\n");
+
+    for (int v = 1; v < AVR_VECTOR_COUNT; v++) {
+        const struct AvrIrqTiming* t = &avr->irqTiming[v];
+        if (t->entries == 0) {
+            continue;
+        }
+        printf("  %2d %-13s entries %llu, latency %u..%u cycles",
+               v, avrVectorName(v), (unsigned long long)t->entries, t->minLatency, t->maxLatency);
+        if (t->entries > 1) {
+            printf(", entry period %u..%u cycles (jitter %u = %.3f us)", t->minPeriod, t->maxPeriod,
+                   t->maxPeriod - t->minPeriod, (t->maxPeriod - t->minPeriod) * 1e6 / fCpu);
+        }
+        printf("\n");
+        printHistogram(t);
+    }
+    if (avr->mask.windows) {
+        printf("  interrupts disabled: %llu windows, longest %llu cycles = %.3f us from 0x%04x at cycle %llu\n",
+               (unsigned long long)avr->mask.windows, (unsigned long long)avr->mask.longest,
+               avr->mask.longest * 1e6 / fCpu, avr->mask.longestPc,
+               (unsigned long long)avr->mask.longestAt);
+    }
+
+    if (counterAddr >= 0) {
+        const uint8_t* m = &avr->data[counterAddr];
+        uint32_t counter = m[0] | (m[1] << 8) | ((uint32_t)m[2] << 16) | ((uint32_t)m[3] << 24);
+        uint64_t expected = (uint64_t)(avr->cycles * 1000.0 / fCpu);
+        printf("  counter @0x%04x = %u, wall clock %llu ms, drift %lld ms, lost ticks %lld\n",
+               counterAddr, counter, (unsigned long long)expected,
+               (long long)counter - (long long)expected,
+               (long long)avr->timer0.matches - (long long)counter);
+    }
+}
+
+//============================================Main Code========================================
+int main(int argc, char** argv)
+{
+    static struct AvrCore avr; // Too large for the stack
+    double fCpu = DEFAULT_F_CPU;
+    double seconds = 1.0;
+    uint64_t limit = 0;
+    int profile = 0;
+    int attribute = 0;
+    const char* foldedPath = NULL;
+    struct AvrSymbols syms;
+    int counterAddr = -1;
+    const char* pins[64];
+    int pinCount = 0;
+    const char* patches[64];
+    int patchCount = 0;
+    const char* snapPath = NULL;
+    struct AvrSnapshot* snap = NULL;
+    const char* stimPath = NULL;
+    const char* vcdPath = NULL;
+    const char* vcdSignals = NULL;
+    int opt;
+
+    avrInit(&avr);
+    memset(&syms, 0, sizeof(syms));
+    gpioAttach(&avr);
+    extintAttach(&avr);
+    timer0Attach(&avr);
+    timer1Attach(&avr);
+    usartAttach(&avr);
+
+    while ((opt = getopt(argc, argv, "F:c:f:s:i:S:l:Lm:nptu:v:V:P:w:")) != -1) {
+        switch (opt) {
+        case 'F': fCpu = atof(optarg); break;
+        case 'c': limit = strtoull(optarg, NULL, 0); break;
+        case 's': seconds = atof(optarg); break;
+        case 'i':
+            if (pinCount == 64) {
+                usage(argv[0]);
+            }
+            pins[pinCount++] = optarg;
+            break;
+        case 'P':
+            if (patchCount == 64) {
+                usage(argv[0]);
+            }
+            patches[patchCount++] = optarg;
+            break;
+        case 'S': stimPath = optarg; break;
+        case 'l': avr.countPc = (uint16_t)(strtoul(optarg, NULL, 0) / 2); break;
+        case 'm':
+            counterAddr = (int)strtol(optarg, NULL, 0);
+            if (counterAddr < AVR_SRAM_START || counterAddr > AVR_RAMEND - 3) {
+                usage(argv[0]);
+            }
+            break;
+        case 'n': avr.idle.disabled = 1; break;
+        case 'p': profile = 1; break;
+        case 'L': attribute = 1; break;
+        case 'f': foldedPath = optarg; break;
+        case 't': avr.trace = stdout; break;
+        case 'u':
+            avr.usart.out = fopen(optarg, "wb");
+            if (!avr.usart.out) {
+                perror(optarg);
+                return 1;
+            }
+            break;
+        case 'v': vcdPath = optarg; break;
+        case 'V': vcdSignals = optarg; break;
+        case 'w': snapPath = optarg; break;
+        default: usage(argv[0]);
+        }
+    }
+    if (optind != argc - 1 || fCpu <= 0) {
+        usage(argv[0]);
+    }
+    if (limit == 0) {
+        limit = (uint64_t)(seconds * fCpu);
+    }
+
+    // The machine first: pin and stimulus times count from where it starts
+    if (snapIsFile(argv[optind])) {
+        snap = snapLoad(argv[optind]);
+        if (!snap) {
+            return 1;
+        }
+        for (int i = 0; i < patchCount; i++) {
+            if (parsePatch(snap, patches[i]) < 0) {
+                fprintf(stderr, "bad patch %s\n", patches[i]);
+                return 1;
+            }
+        }
+        if (snapRestore(&avr, snap) < 0) {
+            fprintf(stderr, "%s: does not fit this simulator\n", argv[optind]);
+            return 1;
+        }
+        snapFree(snap);
+    } else if (patchCount) {
+        fprintf(stderr, "-P patches a snapshot; the startup code of a .hex image would undo it\n");
+        return 1;
+    } else if (elfIsFile(argv[optind])) {
+        if (elfLoad(&avr, argv[optind], &syms) < 0) {
+            return 1;
+        }
+    } else if (avrLoadHex(&avr, argv[optind]) < 0) {
+        return 1;
+    }
+    limit += avr.cycles;
+    for (int i = 0; i < pinCount; i++) {
+        if (parsePin(&avr, pins[i], fCpu) < 0) {
+            usage(argv[0]);
+        }
+    }
+    if (stimPath && stimLoad(&avr, stimPath, fCpu) < 0) {
+        return 1;
+    }
+    if (profile && avrEnableProfile(&avr) < 0) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+    if (vcdPath && !vcdOpen(&avr, vcdPath, vcdSignals, fCpu)) {
+        return 1;
+    }
+    if ((attribute || foldedPath) && !profOpen(&avr, &syms)) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+
+    int stop = avrRun(&avr, limit);
+    vcdClose(&avr);
+    if (snapPath) {
+        snap = snapTake(&avr);
+        if (!snap || snapSave(snap, snapPath) < 0) {
+            return 1;
+        }
+        snapFree(snap);
+    }
+
+    printf("%s: %s at pc 0x%04x\n", argv[optind], stopNames[stop], avr.pc * 2);
+    printf("  executed  ");
+    printCycles(avr.cycles, fCpu);
+    printf(", %llu instructions\n", (unsigned long long)avr.instructions);
+    printf("  sleeping  ");
+    printCycles(avr.sleepCycles, fCpu);
+    printf(", %llu wake-ups\n", (unsigned long long)avr.wakeups);
+    if (avr.idle.skips) {
+        printf("  idle      ");
+        printCycles(avr.idle.skippedCycles, fCpu);
+        printf(" fast-forwarded in %llu skips\n", (unsigned long long)avr.idle.skips);
+    }
+    printDuty(&avr, fCpu);
+    printf("  PORTA=%02x PORTB=%02x PORTC=%02x PORTD=%02x\n",
+           avr.data[0x3B], avr.data[0x38], avr.data[0x35], avr.data[0x32]);
+    if (avr.countPc) {
+        printf("  instruction at 0x%04x executed %llu times\n", avr.countPc * 2,
+               (unsigned long long)avr.countHits);
+    }
+    printIo(&avr);
+
+    printTiming(&avr, fCpu, counterAddr);
+    if (profile) {
+        printProfile(&avr, &syms);
+    }
+    if (attribute) {
+        profReport(&avr, stdout, 20, fCpu);
+    }
+    if (foldedPath && profFolded(&avr, foldedPath) < 0) {
+        return 1;
+    }
+    profClose(&avr);
+    symFree(&syms);
+
+    if (avr.usart.out) {
+        fclose(avr.usart.out);
+    }
+    avrFree(&avr);
+    return stop == AVR_STOP_ILLEGAL ? 1 : 0;
+}
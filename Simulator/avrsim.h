@@ -0,0 +1,511 @@
+//===========================================================================================
+// Project: ATmega32A Host-Side Simulator
+// Compiler: gcc (host, C99)
+// Target microcontroller: ATmega32A (simulated)
+// Description: Public interface of the cycle-accurate AVR core used to run the example .hex
+//              images on a Linux host. The core models the register file, SREG, the stack,
+//              the I/O space and interrupt vectoring of the ATmega32A, and keeps per-function
+//              and per-ISR cycle statistics so every example can be measured without a board.
+// Date created: 2026-10-16
+//===========================================================================================
+#ifndef AVRSIM_H
+#define AVRSIM_H
+
+//============================================Libraries========================================
+#include <stdint.h>
+#include <stdio.h>
+
+//============================================Defines========================================
+// ATmega32A memory layout
+#define AVR_FLASH_WORDS   16384   // 32 KB of program memory (16K words)
+#define AVR_IO_BASE       0x20    // First I/O register in data space
+#define AVR_IO_SIZE       64      // Number of I/O registers (0x20..0x5F)
+#define AVR_SRAM_START    0x60    // First byte of internal SRAM
+#define AVR_RAMEND        0x85F   // Last byte of internal SRAM (2 KB)
+#define AVR_DATA_SIZE     (AVR_RAMEND + 1)
+#define AVR_VECTOR_COUNT  21      // Reset + 20 interrupt sources
+
+// Data-space addresses of the core registers (I/O address + 0x20)
+#define AVR_SREG  0x5F
+#define AVR_SPH   0x5E
+#define AVR_SPL   0x5D
+#define AVR_MCUCR 0x55
+
+// MCUCR sleep control
+#define AVR_SE        0x80 // Sleep enable
+#define AVR_SM_MASK   0x70 // Sleep mode select SM2..SM0
+#define AVR_SM_IDLE   0x00 // The only mode that keeps clkIO running
+
+// SREG bit positions
+#define SREG_C 0 // Carry
+#define SREG_Z 1 // Zero
+#define SREG_N 2 // Negative
+#define SREG_V 3 // Two's complement overflow
+#define SREG_S 4 // Sign (N ^ V)
+#define SREG_H 5 // Half carry
+#define SREG_T 6 // Bit copy storage
+#define SREG_I 7 // Global interrupt enable
+
+// Interrupt response time in cycles (push PC + jump to vector)
+#define AVR_IRQ_CYCLES     4
+#define AVR_MAX_IRQ_SOURCES 32
+#define AVR_MAX_PERIPHS     8
+#define AVR_CALL_DEPTH      64
+#define AVR_ISR_DEPTH       8  // Nested interrupts tracked for the active-vector signal
+#define AVR_LATENCY_BINS    9  // Latency histogram: 0, 1, 2-3, 4-7 .. 64-127, 128 and more
+#define AVR_IDLE_FUNCS      4  // Functions a skipped idle loop may call (with profiling on)
+
+// Reasons avrRun() returns
+#define AVR_STOP_NONE      0 // Still running
+#define AVR_STOP_CYCLES    1 // Cycle budget exhausted
+#define AVR_STOP_SLEEP     2 // SLEEP with nothing left that could wake the core
+#define AVR_STOP_HALT      3 // "cli; rjmp ." idle loop reached (avr-libc exit)
+#define AVR_STOP_ILLEGAL   4 // Undecodable opcode
+#define AVR_STOP_BREAK     5 // BREAK instruction
+
+// Bounce burst timing distributions (stimulus.c)
+#define STIM_UNIFORM 0 // Toggles spread evenly over the burst
+#define STIM_EXP     1 // Toggles crowd at the start, gaps grow
+
+//============================================Types========================================
+struct AvrCore;
+struct AvrVcd; // Private to vcd.c
+struct AvrSnapshot; // Private to snapshot.c
+struct AvrProfile; // Private to profile.c
+
+// I/O register hooks: a peripheral claims an address to see every access to it.
+// 'addr' is the data-space address (0x20..0x5F).
+typedef uint8_t (*AvrReadHook)(struct AvrCore* avr, uint16_t addr, void* ctx);
+typedef void (*AvrWriteHook)(struct AvrCore* avr, uint16_t addr, uint8_t value, void* ctx);
+
+// Peripheral event callback: called once avr->cycles reaches the cycle it asked for,
+// returns the absolute cycle of its next event (UINT64_MAX when idle).
+typedef uint64_t (*AvrEventHook)(struct AvrCore* avr, void* ctx);
+
+// Predecoded instruction handler (avr_core.c): runs 'op' with avr->pc past its first word,
+// returns the cycles taken or -1 on an illegal opcode
+struct AvrOp;
+typedef int (*AvrOpHandler)(struct AvrCore* avr, const struct AvrOp* op);
+
+// Counter value callback of timer0Replay(): TCNT0 became 'tcnt' at 'cycle'
+typedef void (*AvrCountHook)(void* ctx, uint64_t cycle, uint8_t tcnt);
+
+// Interrupt source: the request is pending while (flag & flagMask) && (enable & enableMask).
+struct AvrIrqSource
+{
+    uint8_t vector;       // Vector number (avr-libc __vector_N numbering)
+    uint16_t flagAddr;    // Data address of the flag register
+    uint8_t flagMask;     // Flag bit inside flagAddr
+    uint16_t enableAddr;  // Data address of the enable register
+    uint8_t enableMask;   // Enable bit inside enableAddr
+    uint8_t autoClear;    // 1 if hardware clears the flag when the vector is taken
+};
+
+struct AvrPeriph
+{
+    AvrEventHook event; // Event callback
+    void* ctx;          // Peripheral state
+    uint64_t next;      // Absolute cycle of the next event
+};
+
+// Cycle statistics of one call target or one interrupt vector
+struct AvrFuncStats
+{
+    uint32_t calls;     // Number of completed invocations
+    uint64_t inclusive; // Cycles including callees (and CALL/RET or IRQ/RETI overhead)
+    uint64_t exclusive; // Cycles excluding callees and nested interrupts
+    uint32_t min;       // Shortest single invocation (inclusive)
+    uint32_t max;       // Longest single invocation (inclusive)
+};
+
+// Entry timing of one interrupt vector, kept whether or not profiling is enabled
+struct AvrIrqTiming
+{
+    uint64_t raised;      // Cycle at which the peripheral last raised the flag
+    uint64_t lastEntry;   // Cycle of the last interrupt response
+    uint64_t entries;     // Number of times the vector was taken
+    uint32_t minPeriod;   // Shortest / longest distance between two entries
+    uint32_t maxPeriod;
+    uint32_t minLatency;  // Shortest / longest flag-to-response delay
+    uint32_t maxLatency;
+    uint64_t histogram[AVR_LATENCY_BINS]; // Entries per latency bin (avrLatencyBin)
+};
+
+// Interrupts-disabled windows: from the cycle the I flag is cleared (instruction or interrupt
+// response) to the end of the instruction that sets it again. Startup code before the first
+// SEI is not counted.
+struct AvrMaskTiming
+{
+    uint64_t start;       // Cycle the current window began, UINT64_MAX while not tracking
+    uint16_t startPc;     // Byte address that cleared I (the vector for an interrupt response)
+    uint64_t windows;     // Completed windows
+    uint64_t longest;     // Cycles of the longest window
+    uint16_t longestPc;   // Where it began
+    uint64_t longestAt;   // Cycle at which it began
+};
+
+// Timer/Counter0 state (timer0.c)
+struct AvrTimer0
+{
+    uint8_t tcnt;         // Counter value as of lastSync
+    uint8_t ocr;          // Active compare value
+    uint8_t ocrBuffer;    // CPU-visible OCR0 (double buffered in the PWM modes)
+    uint8_t countDown;    // Phase correct PWM direction
+    uint8_t blockMatch;   // A TCNT0 write blocks the compare match on the next timer clock
+    uint64_t lastSync;    // Cycle up to which tcnt is valid
+    uint64_t psrBase;     // Cycle at which the shared prescaler was last reset
+    uint64_t matches;     // Compare matches since reset
+    uint64_t overflows;   // Overflows since reset
+    uint32_t version;     // Bumped by every register write, invalidates replay shadows
+};
+
+// Timer/Counter1 state (timer1.c), a free-running counter on Timer0's prescaler
+struct AvrTimer1
+{
+    uint16_t tcnt;        // Counter value as of lastSync
+    uint8_t temp;         // TEMP register of the 16-bit accesses
+    uint64_t lastSync;    // Cycle up to which tcnt is valid
+};
+
+// Private copy of Timer0 that timer0Replay() steps tick by tick for waveform output
+struct AvrTimer0Shadow
+{
+    struct AvrTimer0 state;
+    uint32_t version;     // timer0.version the copy was taken at
+    uint8_t valid;
+};
+
+// Timed change of an externally driven input pin
+struct AvrPinChange
+{
+    uint64_t cycle; // Absolute cycle at which the change is applied
+    uint8_t port;   // 0 = A .. 3 = D
+    uint8_t bit;
+    uint8_t level;  // 0, 1, or 2 to release the pin
+};
+
+// External drive of the four parallel ports (index 0 = A .. 3 = D)
+struct AvrGpio
+{
+    uint8_t level[4];  // Level applied by the outside world
+    uint8_t driven[4]; // 1 = bit is driven externally, 0 = floating (pull-up decides)
+    void (*onChange)(struct AvrCore* avr); // Called after a pin level may have changed
+    struct AvrPinChange* changes;          // Scheduled input changes, sorted by cycle
+    uint32_t changeCount;
+    uint32_t changeSize;                   // Allocated entries
+    uint32_t changeNext;                   // First change not applied yet
+    uint8_t watch[4];                      // Pins whose level changes are logged (gpioWatch)
+    uint8_t watchLevel[4];                 // Their levels at the last change
+    struct AvrPinChange* edges;            // Logged level changes, in order
+    uint32_t edgeCount;
+    uint32_t edgeSize;
+    uint32_t edgesLost;                    // Not logged for lack of memory
+};
+
+// External interrupts INT0 (PD2), INT1 (PD3) and INT2 (PB2) (extint.c)
+struct AvrExtInt
+{
+    uint8_t last;       // Pin levels at the last sync, bit n = INTn
+    uint64_t requests;  // Edges or levels that set the flag of an enabled interrupt
+    uint64_t missed;    // INT0/INT1 edges lost because the I/O clock was stopped in sleep
+};
+
+// USART transmitter state (usart.c)
+struct AvrUsart
+{
+    uint8_t buffer;       // Transmit buffer (UDR as written by the CPU)
+    uint8_t bufferFull;   // 1 while the buffer waits for the shift register
+    uint8_t shifter;      // Byte in the shift register
+    uint8_t busy;         // 1 while a frame is on the line
+    uint64_t txDone;      // Cycle at which the frame in the shift register ends
+    uint8_t ubrrh;        // UBRRH and UCSRC share one address
+    uint8_t ucsrc;
+    uint64_t txBytes;     // Frames completed since reset
+    FILE* out;            // Receives every transmitted byte, NULL to discard
+};
+
+// One flash word translated for the threaded interpreter
+struct AvrOp
+{
+    AvrOpHandler run; // Handler, or the predecoder while the word has not run yet
+    uint8_t d;        // Destination register (I/O address for CBI/SBI/SBIC/SBIS)
+    uint8_t r;        // Source or pointer register, bit number
+    uint16_t k;       // Immediate, target, data address, or words skipped
+    uint8_t backoff;  // Loop branches: log2 of the back edges between two idle probes
+    uint16_t wait;    // Loop branches: back edges left until the next probe
+};
+
+// Profile entry changed by a probed loop iteration, with its value before the iteration
+struct AvrIdleStats
+{
+    struct AvrFuncStats* stats;
+    struct AvrFuncStats before;
+};
+
+// Idle-loop fast-forward (idle.c). A loop iteration that leaves registers, SRAM, I/O and
+// every statistic's rate exactly as it found them repeats identically until the next
+// peripheral event, so those iterations are skipped and only the counters advance.
+struct AvrIdle
+{
+    uint8_t disabled;                // 1 to execute every iteration
+    uint64_t limit;                  // Cycle a skip must not pass, 0 outside avrRun()
+    const struct AvrOp* branch;      // Back edge of the loop being probed, NULL if none
+    uint32_t clockedReads;           // Reads of ioClocked registers during the probe
+    uint64_t startCycles;            // State at the loop head when the probe began
+    uint64_t startInstructions;
+    uint64_t startHits;
+    uint64_t startWindows;
+    uint64_t startChild;
+    uint8_t startDepth;
+    uint8_t startPending;
+    uint8_t data[AVR_DATA_SIZE];
+    uint64_t ioWrites[AVR_IO_SIZE];
+    struct AvrIdleStats touched[AVR_IDLE_FUNCS];
+    uint8_t touchedCount;            // AVR_IDLE_FUNCS + 1 when too many to follow
+    uint64_t skips;                  // Fast-forwards taken
+    uint64_t skippedCycles;          // Cycles they covered
+};
+
+// Shadow call stack entry used for cycle accounting
+struct AvrFrame
+{
+    uint16_t target;  // Callee word address, or vector number for interrupts
+    uint8_t isIrq;    // 1 for interrupt frames
+    uint64_t start;   // Cycle at which the CALL / interrupt response started
+    uint64_t child;   // Cycles spent in callees and nested interrupts
+};
+
+struct AvrCore
+{
+    uint16_t flash[AVR_FLASH_WORDS]; // Program memory
+    struct AvrOp ops[AVR_FLASH_WORDS]; // Predecoded program memory (avrFlashChanged)
+    uint8_t data[AVR_DATA_SIZE];     // Registers, I/O space and SRAM
+    uint16_t pc;                     // Program counter (word address)
+    uint64_t cycles;                 // Cycles executed since reset
+    uint64_t instructions;           // Instructions retired since reset
+    uint8_t sleeping;                // 1 while the core sits in a SLEEP instruction
+    uint8_t irqHold;                 // Instructions to run before the next interrupt may be taken
+    uint8_t stopReason;              // Why avrRun() returned
+    uint64_t sleepCycles;            // Cycles spent asleep
+    uint64_t wakeups;                // Interrupts that ended a SLEEP
+
+    // I/O hooks indexed by (addr - AVR_IO_BASE)
+    AvrReadHook readHook[AVR_IO_SIZE];
+    AvrWriteHook writeHook[AVR_IO_SIZE];
+    void* hookCtx[AVR_IO_SIZE];
+
+    // Interrupt sources and the registers they depend on
+    struct AvrIrqSource irq[AVR_MAX_IRQ_SOURCES];
+    uint8_t irqCount;
+    uint8_t irqReg[AVR_IO_SIZE];     // 1 if a write to the register can change pending state
+    uint8_t pendingVector;           // Highest-priority pending vector, 0 = none
+
+    // Peripheral event scheduling
+    struct AvrPeriph periph[AVR_MAX_PERIPHS];
+    uint8_t periphCount;
+    uint64_t nextEvent;              // Earliest periph[].next
+
+    // Cycle accounting (enabled by avrEnableProfile)
+    struct AvrFuncStats* funcStats;  // Indexed by callee word address
+    struct AvrFuncStats irqStats[AVR_VECTOR_COUNT];
+    struct AvrFrame frames[AVR_CALL_DEPTH];
+    uint8_t depth;
+
+    struct AvrIrqTiming irqTiming[AVR_VECTOR_COUNT];
+    struct AvrMaskTiming mask;
+    uint8_t irqEnabled;              // I flag as seen after the last instruction
+    uint8_t isrStack[AVR_ISR_DEPTH]; // Vectors of the interrupts being serviced, innermost last
+    uint8_t isrDepth;
+
+    struct AvrGpio gpio;             // Parallel port model
+    struct AvrTimer0 timer0;         // Timer/Counter0 model
+    struct AvrTimer1 timer1;         // Timer/Counter1 model
+    struct AvrExtInt extint;         // External interrupt model
+    struct AvrUsart usart;           // USART model
+
+    uint64_t ioWrites[AVR_IO_SIZE];  // Writes per I/O register, indexed by (addr - AVR_IO_BASE)
+    uint8_t ioClocked[AVR_IO_SIZE];  // 1 if reads change with time between events (TCNT0)
+    struct AvrIdle idle;             // Idle-loop fast-forward
+    uint16_t countPc;                // Word address whose executions are counted, 0 = none
+    uint64_t countHits;              // Times the instruction at countPc was executed
+
+    FILE* trace;                     // Per-instruction trace output, NULL when disabled
+    struct AvrVcd* vcd;              // Waveform output (vcd.c), NULL when disabled
+    struct AvrProfile* prof;         // Cycle attribution (profile.c), NULL when disabled
+};
+
+// Function or label of an ELF image (elf.c)
+struct AvrSymbol
+{
+    uint32_t addr;    // Byte address in flash
+    uint32_t size;    // Bytes, 0 if unknown (then it reaches to the next symbol)
+    const char* name;
+    uint8_t rank;     // Functions before global before weak labels at one address
+};
+
+// One row of the DWARF line table; line 0 ends a sequence
+struct AvrLine
+{
+    uint32_t addr;    // Byte address in flash
+    uint32_t line;
+    uint32_t order;   // Row number in .debug_line
+    uint16_t file;    // Index into AvrSymbols.files
+};
+
+// Symbols and source lines of an ELF image, sorted by address
+struct AvrSymbols
+{
+    struct AvrSymbol* syms;
+    uint32_t count;
+    struct AvrLine* lines;
+    uint32_t lineCount;
+    uint32_t lineSize;                // Allocated rows
+    char** files;                     // Source file paths
+    uint32_t fileCount;
+    char* strings;                    // Symbol names
+    struct AvrSymbol* labels;         // Local labels of executable code (not in syms), such as
+    uint32_t labelCount;              // the loop labels wcet bounds are keyed on
+};
+
+// Press sequence driven into a debouncer and the pin it toggles per press (bounce.c)
+struct BounceConfig
+{
+    double fCpu;
+    int presses;
+    char inPort;         // Button pin
+    uint8_t inBit;
+    uint8_t activeLevel; // Pin level while pressed
+    char outPort;        // Pin toggled per detected press
+    uint8_t outBit;
+    double period;       // Seconds from one press to the next
+    double hold;         // Seconds the button is held
+    double bounce;       // Seconds of bounce on each edge
+    int edges;           // Toggles per bounce burst
+    int dist;            // STIM_UNIFORM or STIM_EXP
+    int glitches;        // Noise pulses between two presses
+    double glitchWidth;  // Seconds per noise pulse
+    uint64_t seed;
+};
+
+// Verdict on one run of a press sequence; times in cycles
+struct BounceScore
+{
+    uint32_t presses;
+    uint32_t detected;      // Presses answered by a toggle while still held
+    uint32_t falseTriggers; // Every further toggle before the next press
+    uint64_t latencySum;    // First press edge to the toggle
+    uint64_t latencyMin;
+    uint64_t latencyMax;
+    uint64_t settledSum;    // End of the press bounce to the toggle
+    uint64_t settledMax;
+};
+
+//============================================Functions========================================
+// Core (avr_core.c)
+void avrInit(struct AvrCore* avr);
+void avrReset(struct AvrCore* avr);
+int avrStep(struct AvrCore* avr);
+int avrRun(struct AvrCore* avr, uint64_t cycleLimit);
+uint8_t avrReadData(struct AvrCore* avr, uint16_t addr);
+void avrWriteData(struct AvrCore* avr, uint16_t addr, uint8_t value);
+void avrSetIoHook(struct AvrCore* avr, uint16_t addr, AvrReadHook rd, AvrWriteHook wr, void* ctx);
+void avrAddIrq(struct AvrCore* avr, const struct AvrIrqSource* src);
+void avrUpdateIrq(struct AvrCore* avr);
+void avrIrqRaised(struct AvrCore* avr, uint8_t vector, uint64_t cycle);
+int avrAddPeriph(struct AvrCore* avr, AvrEventHook event, void* ctx, uint64_t next);
+void avrReschedule(struct AvrCore* avr, void* ctx, uint64_t next);
+int avrEnableProfile(struct AvrCore* avr);
+void avrFree(struct AvrCore* avr);
+int avrOpcodeWords(uint16_t opcode);
+void avrFlashChanged(struct AvrCore* avr);
+const char* avrVectorName(uint8_t vector);
+int avrLatencyBin(uint32_t latency);
+
+// Idle-loop fast-forward, called by the loop branches of the core (idle.c)
+void idleEdge(struct AvrCore* avr, const struct AvrOp* branch);
+void idleCountdown(struct AvrCore* avr, const struct AvrOp* branch);
+void idleTouch(struct AvrCore* avr, struct AvrFuncStats* stats);
+int idleCountdownBytes(const uint16_t* flash, uint16_t head, uint16_t branch, uint8_t* reg);
+
+// Intel HEX loader (ihex.c)
+int avrLoadHex(struct AvrCore* avr, const char* path);
+
+// ELF images, symbols and source lines (elf.c)
+int elfIsFile(const char* path);
+int elfLoad(struct AvrCore* avr, const char* path, struct AvrSymbols* syms);
+const struct AvrSymbol* symFind(const struct AvrSymbols* syms, uint32_t addr);
+const struct AvrLine* symLine(const struct AvrSymbols* syms, uint32_t addr);
+void symFree(struct AvrSymbols* syms);
+
+// Disassembler (avr_disasm.c)
+int avrDisasm(const uint16_t* flash, uint16_t pc, char* buf, size_t len);
+
+// Parallel ports A..D (gpio.c)
+void gpioAttach(struct AvrCore* avr);
+void gpioSetInput(struct AvrCore* avr, char port, uint8_t bit, uint8_t level);
+void gpioRelease(struct AvrCore* avr, char port, uint8_t bit);
+int gpioSchedule(struct AvrCore* avr, char port, uint8_t bit, uint8_t level, uint64_t cycle);
+uint8_t gpioPins(struct AvrCore* avr, int port);
+void gpioWatch(struct AvrCore* avr, char port, uint8_t bit);
+
+// External interrupts INT0..INT2 (extint.c)
+void extintAttach(struct AvrCore* avr);
+
+// USART (usart.c)
+void usartAttach(struct AvrCore* avr);
+uint32_t usartFrameCycles(const struct AvrCore* avr);
+
+// Timer/Counter0 (timer0.c)
+void timer0Attach(struct AvrCore* avr);
+uint32_t timer0Period(struct AvrCore* avr);
+void timer0Replay(struct AvrCore* avr, struct AvrTimer0Shadow* shadow, uint64_t to,
+                  AvrCountHook emit, void* ctx);
+
+// Timer/Counter1 (timer1.c)
+void timer1Attach(struct AvrCore* avr);
+void timer1Sync(struct AvrCore* avr, uint64_t now);
+
+// Stimulus files and bounce generators (stimulus.c)
+int stimLoad(struct AvrCore* avr, const char* path, double fCpu);
+int stimBounce(struct AvrCore* avr, char port, uint8_t bit, uint8_t level, uint64_t start,
+               uint64_t duration, int edges, int dist, uint64_t* rng);
+double stimRandom(uint64_t* rng);
+
+// Debounce press sequences and their scoring (bounce.c)
+#define BOUNCE_OPTIONS "F:n:i:a:o:p:H:b:e:d:g:w:r:"
+#define BOUNCE_USAGE                                                                         \
+    "[-F hz] [-n presses] [-i pin] [-a active] [-o pin] [-p period_ms] [-H hold_ms]\n"       \
+    "          [-b bounce_ms] [-e edges] [-d uniform|exp] [-g glitches] [-w glitch_us] [-r seed]"
+#define BOUNCE_DEFAULTS                                                                      \
+    "defaults: 1000 presses on D6 (active 0), output B1, 300 ms period, 120 ms hold,\n"      \
+    "          5 ms bounce with 8 edges (uniform), no glitches\n"
+void bounceDefaults(struct BounceConfig* c);
+int bounceOption(struct BounceConfig* c, int opt, const char* arg);
+int bounceValid(const struct BounceConfig* c);
+uint64_t bounceSchedule(struct AvrCore* avr, const struct BounceConfig* c);
+void bounceScore(const struct AvrCore* avr, const struct BounceConfig* c, uint64_t end,
+                 struct BounceScore* s, uint64_t* latency);
+
+// Machine snapshots (snapshot.c)
+struct AvrSnapshot* snapTake(const struct AvrCore* avr);
+int snapRestore(struct AvrCore* avr, const struct AvrSnapshot* snap);
+int snapPatch(struct AvrSnapshot* snap, uint16_t addr, uint64_t value, int bytes);
+uint64_t snapCycles(const struct AvrSnapshot* snap);
+int snapSave(const struct AvrSnapshot* snap, const char* path);
+int snapIsFile(const char* path);
+struct AvrSnapshot* snapLoad(const char* path);
+void snapFree(struct AvrSnapshot* snap);
+
+// Cycle attribution by call stack, function, line and instruction (profile.c)
+struct AvrProfile* profOpen(struct AvrCore* avr, const struct AvrSymbols* syms);
+void profSample(struct AvrCore* avr);
+void profReport(struct AvrCore* avr, FILE* out, int top, double fCpu);
+int profFolded(struct AvrCore* avr, const char* path);
+void profClose(struct AvrCore* avr);
+
+// Value Change Dump waveform output (vcd.c)
+struct AvrVcd* vcdOpen(struct AvrCore* avr, const char* path, const char* signals, double fCpu);
+void vcdSample(struct AvrCore* avr);
+void vcdClose(struct AvrCore* avr);
+
+#endif // AVRSIM_H
@@ -0,0 +1,347 @@
+//===========================================================================================
+// Project: ATmega32A Host-Side Simulator
+// Compiler: gcc (host, C99)
+// Target microcontroller: ATmega32A (simulated)
+// Description: Monte Carlo board farm. Simulates many independent boards running the same
+//              image, each with its own press sequence (bounce.c, seeded per board), on one
+//              thread per host core, and adds up how the debouncer did over all of them.
+//
+//              Board numbers are dealt out in equal ranges, one per thread. A thread claims
+//              boards from its own range with an atomic increment and, once that is empty,
+//              steals from the other ranges the same way, so a slow board never leaves the
+//              other cores idle. Every finished board adds its score to the totals with
+//              atomic adds, with no lock anywhere. Every board has a fixed seed and sums are
+//              in whole cycles, so the report is the same for any thread count.
+//
+//              Given a snapshot (avrsim -w) instead of an image, every board forks from it:
+//              the press sequence starts where the snapshot was taken, so a firmware state
+//              reached after a long run is tested without simulating the run once per board.
+// Usage:   ./boardfarm [-N boards] [-j threads] [bouncebench options] image.hex|state.snap
+// Date created: 2026-10-16
+//===========================================================================================
+
+//============================================Libraries========================================
+#include <getopt.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "avrsim.h"
+
+//============================================Defines========================================
+#define FARM_MAX_THREADS 256
+#define LATENCY_BINS     512   // Latency histogram, LATENCY_BIN_MS per bin
+#define LATENCY_BIN_MS   0.25
+
+// Totals over all boards, only ever changed with atomic operations
+struct FarmTotals
+{
+    uint64_t boards;
+    uint64_t failed;        // Boards whose firmware stopped early
+    uint64_t presses;
+    uint64_t detected;
+    uint64_t falseTriggers;
+    uint64_t missedBoards;  // Boards with at least one missed press
+    uint64_t falseBoards;   // Boards with at least one false trigger
+    uint64_t latencySum;
+    uint64_t latencyMin;
+    uint64_t latencyMax;
+    uint64_t settledSum;
+    uint64_t settledMax;
+    uint64_t cycles;        // Simulated in total
+    uint64_t histogram[LATENCY_BINS];
+};
+
+// One thread and the range of boards it starts with
+struct FarmWorker
+{
+    pthread_t thread;
+    int id;
+    uint64_t next;          // Next board of the range; claimed by atomic increment
+    uint64_t end;
+    uint64_t boards;        // Boards this thread ran
+    uint64_t stolen;        // ... of which from other ranges
+    struct Farm* farm;
+};
+
+struct Farm
+{
+    struct BounceConfig config; // Seed is the farm seed; each board derives its own
+    const uint16_t* flash;      // Image, loaded once
+    const struct AvrSnapshot* snap; // Or the state every board starts from, NULL for reset
+    uint64_t latencyBin;        // Cycles per histogram bin
+    int threads;
+    struct FarmWorker workers[FARM_MAX_THREADS];
+    struct FarmTotals totals;
+};
+
+//============================================Helpers========================================
+static void usage(const char* prog)
+{
+    fprintf(stderr, "usage: %s [-N boards] [-j threads] " BOUNCE_USAGE "\n          image.hex|state.snap\n"
+            "defaults: 1000 boards on every core, 20 presses per board; otherwise as bouncebench:\n"
+            BOUNCE_DEFAULTS, prog);
+    exit(2);
+}
+
+static double hostSeconds(void)
+{
+    struct timespec t;
+
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+// Seed of board 'n': splitmix64 of the farm seed and the board number, never 0
+static uint64_t boardSeed(uint64_t seed, uint64_t n)
+{
+    uint64_t z = seed + (n + 1) * 0x9E3779B97F4A7C15ULL;
+
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return (z ^ (z >> 31)) | 1;
+}
+
+static void atomicAdd(uint64_t* total, uint64_t value)
+{
+    __atomic_fetch_add(total, value, __ATOMIC_RELAXED);
+}
+
+static void atomicMax(uint64_t* total, uint64_t value)
+{
+    uint64_t seen = __atomic_load_n(total, __ATOMIC_RELAXED);
+
+    while (value > seen
+           && !__atomic_compare_exchange_n(total, &seen, value, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+    }
+}
+
+static void atomicMin(uint64_t* total, uint64_t value)
+{
+    uint64_t seen = __atomic_load_n(total, __ATOMIC_RELAXED);
+
+    while (value < seen
+           && !__atomic_compare_exchange_n(total, &seen, value, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+    }
+}
+
+// Claim the next board of 'w's range; 0 when the range is used up
+static int claim(struct FarmWorker* w, uint64_t* board)
+{
+    uint64_t n = __atomic_fetch_add(&w->next, 1, __ATOMIC_RELAXED);
+
+    if (n >= w->end) {
+        return 0;
+    }
+    *board = n;
+    return 1;
+}
+
+// Simulate board 'n' from reset (or the snapshot) on 'avr' and add its score to the totals
+static void runBoard(struct Farm* farm, struct AvrCore* avr, uint64_t* latency, uint64_t n)
+{
+    struct FarmTotals* t = &farm->totals;
+    struct BounceConfig c = farm->config;
+    struct BounceScore s;
+    uint64_t begin;
+    uint64_t end;
+    int stop;
+
+    c.seed = boardSeed(farm->config.seed, n);
+    avrInit(avr);
+    gpioAttach(avr);
+    extintAttach(avr);
+    timer0Attach(avr);
+    timer1Attach(avr);
+    usartAttach(avr);
+    if (farm->snap) {
+        if (snapRestore(avr, farm->snap) < 0) {
+            fprintf(stderr, "snapshot does not fit this simulator\n");
+            exit(1);
+        }
+    } else {
+        memcpy(avr->flash, farm->flash, sizeof(avr->flash));
+        avrFlashChanged(avr);
+    }
+
+    begin = avr->cycles;
+    end = bounceSchedule(avr, &c);
+    stop = avrRun(avr, end);
+    if (stop != AVR_STOP_CYCLES || avr->gpio.edgesLost) {
+        atomicAdd(&t->failed, 1);
+    }
+    bounceScore(avr, &c, end, &s, latency);
+    avrFree(avr);
+
+    atomicAdd(&t->boards, 1);
+    atomicAdd(&t->cycles, avr->cycles - begin);
+    atomicAdd(&t->presses, s.presses);
+    atomicAdd(&t->detected, s.detected);
+    atomicAdd(&t->falseTriggers, s.falseTriggers);
+    atomicAdd(&t->missedBoards, s.detected < s.presses);
+    atomicAdd(&t->falseBoards, s.falseTriggers != 0);
+    atomicAdd(&t->latencySum, s.latencySum);
+    atomicAdd(&t->settledSum, s.settledSum);
+    if (s.detected) {
+        atomicMin(&t->latencyMin, s.latencyMin);
+        atomicMax(&t->latencyMax, s.latencyMax);
+        atomicMax(&t->settledMax, s.settledMax);
+    }
+    for (uint32_t i = 0; i < s.detected; i++) {
+        uint64_t bin = latency[i] / farm->latencyBin;
+        atomicAdd(&t->histogram[bin < LATENCY_BINS ? bin : LATENCY_BINS - 1], 1);
+    }
+}
+
+// Thread body: own range first, then whatever is left in the others
+static void* worker(void* arg)
+{
+    struct FarmWorker* self = arg;
+    struct Farm* farm = self->farm;
+    struct AvrCore* avr = malloc(sizeof(*avr)); // Too large for a thread stack
+    uint64_t* latency = calloc(farm->config.presses, sizeof(*latency));
+    uint64_t board;
+
+    if (!avr || !latency) {
+        fprintf(stderr, "out of memory\n");
+        exit(1);
+    }
+    for (int k = 0; k < farm->threads; k++) {
+        struct FarmWorker* victim = &farm->workers[(self->id + k) % farm->threads];
+
+        while (claim(victim, &board)) {
+            runBoard(farm, avr, latency, board);
+            self->boards++;
+            self->stolen += k != 0;
+        }
+    }
+    free(latency);
+    free(avr);
+    return NULL;
+}
+
+// Latency below which 'fraction' of the detected presses fall, in ms (bin upper edge)
+static double percentile(const struct FarmTotals* t, double fraction)
+{
+    uint64_t want = (uint64_t)(fraction * t->detected);
+    uint64_t seen = 0;
+
+    for (int i = 0; i < LATENCY_BINS; i++) {
+        seen += t->histogram[i];
+        if (seen > want) {
+            return (i + 1) * LATENCY_BIN_MS;
+        }
+    }
+    return LATENCY_BINS * LATENCY_BIN_MS;
+}
+
+//============================================Main Code========================================
+int main(int argc, char** argv)
+{
+    static struct AvrCore image; // Loads the image once for every board
+    struct AvrSnapshot* snap = NULL;
+    static struct Farm farm;
+    struct BounceConfig* c = &farm.config;
+    const struct FarmTotals* t = &farm.totals;
+    uint64_t boards = 1000;
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    double start;
+    double host;
+    int opt;
+
+    bounceDefaults(c);
+    c->presses = 20;
+    farm.threads = cores > 0 ? (int)cores : 1;
+    while ((opt = getopt(argc, argv, BOUNCE_OPTIONS "N:j:")) != -1) {
+        switch (opt) {
+        case 'N': boards = strtoull(optarg, NULL, 0); break;
+        case 'j': farm.threads = atoi(optarg); break;
+        default:
+            if (bounceOption(c, opt, optarg) <= 0) {
+                usage(argv[0]);
+            }
+        }
+    }
+    if (optind != argc - 1 || !bounceValid(c) || boards == 0 || farm.threads < 1
+        || farm.threads > FARM_MAX_THREADS) {
+        usage(argv[0]);
+    }
+
+    avrInit(&image);
+    if (snapIsFile(argv[optind])) {
+        if (!(snap = snapLoad(argv[optind]))) {
+            return 1;
+        }
+        farm.snap = snap;
+    } else if (avrLoadHex(&image, argv[optind]) < 0) {
+        return 1;
+    }
+    farm.flash = image.flash;
+    farm.latencyBin = (uint64_t)(LATENCY_BIN_MS * 1e-3 * c->fCpu);
+    if (farm.latencyBin == 0) {
+        farm.latencyBin = 1;
+    }
+    farm.totals.latencyMin = UINT64_MAX;
+
+    // Equal ranges of board numbers, one per thread
+    for (int i = 0; i < farm.threads; i++) {
+        struct FarmWorker* w = &farm.workers[i];
+
+        w->id = i;
+        w->farm = &farm;
+        w->next = boards * i / farm.threads;
+        w->end = boards * (i + 1) / farm.threads;
+    }
+    start = hostSeconds();
+    for (int i = 0; i < farm.threads; i++) {
+        if (pthread_create(&farm.workers[i].thread, NULL, worker, &farm.workers[i]) != 0) {
+            fprintf(stderr, "cannot start thread %d\n", i);
+            return 1;
+        }
+    }
+    for (int i = 0; i < farm.threads; i++) {
+        pthread_join(farm.workers[i].thread, NULL);
+    }
+    host = hostSeconds() - start;
+    if (host < 1e-9) {
+        host = 1e-9;
+    }
+
+    printf("%s: %llu boards x %d presses, bounce %.3f ms x %d edges (%s), %d glitches of %.0f us per gap, seed %llu\n",
+           argv[optind], (unsigned long long)boards, c->presses, c->bounce * 1e3, c->edges,
+           c->dist == STIM_EXP ? "exp" : "uniform", c->glitches, c->glitchWidth * 1e6,
+           (unsigned long long)c->seed);
+    printf("  %d threads, %.3f host s: %.1f boards/s, %.1f simulated s per host s\n", farm.threads,
+           host, t->boards / host, t->cycles / c->fCpu / host);
+    if (t->failed) {
+        printf("  %llu boards stopped before the end of their sequence\n",
+               (unsigned long long)t->failed);
+    }
+    printf("  detected      %llu of %llu presses\n", (unsigned long long)t->detected,
+           (unsigned long long)t->presses);
+    printf("  missed        %llu (%.4f%%) on %llu boards\n",
+           (unsigned long long)(t->presses - t->detected),
+           100.0 * (t->presses - t->detected) / t->presses, (unsigned long long)t->missedBoards);
+    printf("  false         %llu (%.4f%% of presses) on %llu boards\n",
+           (unsigned long long)t->falseTriggers, 100.0 * t->falseTriggers / t->presses,
+           (unsigned long long)t->falseBoards);
+    if (t->detected) {
+        double ms = 1e3 / c->fCpu;
+
+        printf("  latency from first edge  min %.3f  mean %.3f  p50 < %.2f  p95 < %.2f  p99 < %.2f  max %.3f ms\n",
+               t->latencyMin * ms, (double)t->latencySum / t->detected * ms, percentile(t, 0.50),
+               percentile(t, 0.95), percentile(t, 0.99), t->latencyMax * ms);
+        printf("  latency from settling    mean %.3f  max %.3f ms\n",
+               (double)t->settledSum / t->detected * ms, t->settledMax * ms);
+    }
+    printf("  per thread:");
+    for (int i = 0; i < farm.threads; i++) {
+        printf(" %llu (%llu stolen)", (unsigned long long)farm.workers[i].boards,
+               (unsigned long long)farm.workers[i].stolen);
+    }
+    printf("\n");
+    snapFree(snap);
+    avrFree(&image);
+    return 0;
+}
@@ -0,0 +1,178 @@
+//===========================================================================================
+// Project: ATmega32A Host-Side Simulator
+// Compiler: gcc (host, C99)
+// Target microcontroller: ATmega32A (simulated)
+// Description: Debounce press sequences, shared by bouncebench and boardfarm. A sequence is a
+//              run of button presses, each with random contact bounce on press and release and
+//              optional noise glitches between presses. The firmware should toggle an output
+//              pin once per detected press (PB1 in deBounce_Button), and the logged toggles
+//              are scored:
+//
+//                missed press   no toggle between the first press edge and the release
+//                false trigger  every further toggle before the next press
+//                latency        first press edge (and end of the bounce) to the toggle
+//
+//              The same seed always produces the same input, so two builds of the firmware
+//              can be compared press for press.
+// Date created: 2026-10-16
+//===========================================================================================
+
+//============================================Libraries========================================
+#include <stdlib.h>
+#include <string.h>
+#include "avrsim.h"
+
+//============================================Defines========================================
+#define WARMUP_S 0.1 // Time given to the firmware to initialise before the first press
+
+//============================================Helpers========================================
+// Parse "D6" into port and bit
+static int parsePinName(const char* text, char* port, uint8_t* bit)
+{
+    char p = text[0];
+
+    if (p >= 'a' && p <= 'd') {
+        p -= 'a' - 'A';
+    }
+    if (p < 'A' || p > 'D' || text[1] < '0' || text[1] > '7' || text[2]) {
+        return -1;
+    }
+    *port = p;
+    *bit = text[1] - '0';
+    return 0;
+}
+
+//============================================Functions========================================
+// 1000 presses on D6 (active low), toggles on B1, 300 ms period, 120 ms hold, 5 ms bounce
+void bounceDefaults(struct BounceConfig* c)
+{
+    static const struct BounceConfig defaults = {
+        8000000.0, 1000, 'D', 6, 0, 'B', 1, 0.3, 0.12, 0.005, 8, STIM_UNIFORM, 0, 200e-6, 1
+    };
+
+    *c = defaults;
+}
+
+// Apply one option of BOUNCE_OPTIONS; returns 0 if 'opt' is not one of them, -1 on a bad value
+int bounceOption(struct BounceConfig* c, int opt, const char* arg)
+{
+    switch (opt) {
+    case 'F': c->fCpu = atof(arg); break;
+    case 'n': c->presses = atoi(arg); break;
+    case 'i': return parsePinName(arg, &c->inPort, &c->inBit) < 0 ? -1 : 1;
+    case 'a': c->activeLevel = atoi(arg) != 0; break;
+    case 'o': return parsePinName(arg, &c->outPort, &c->outBit) < 0 ? -1 : 1;
+    case 'p': c->period = atof(arg) * 1e-3; break;
+    case 'H': c->hold = atof(arg) * 1e-3; break;
+    case 'b': c->bounce = atof(arg) * 1e-3; break;
+    case 'e': c->edges = atoi(arg); break;
+    case 'd':
+        if (!strcmp(arg, "exp")) {
+            c->dist = STIM_EXP;
+        } else if (!strcmp(arg, "uniform")) {
+            c->dist = STIM_UNIFORM;
+        } else {
+            return -1;
+        }
+        break;
+    case 'g': c->glitches = atoi(arg); break;
+    case 'w': c->glitchWidth = atof(arg) * 1e-6; break;
+    case 'r': c->seed = strtoull(arg, NULL, 0) | 1; break;
+    default: return 0;
+    }
+    return 1;
+}
+
+// 1 if the timing fits together: bounce inside the hold, hold and bounce inside the period
+int bounceValid(const struct BounceConfig* c)
+{
+    return c->fCpu > 0 && c->presses > 0 && c->edges >= 0 && c->glitches >= 0
+           && c->hold + c->bounce < c->period && c->bounce < c->hold;
+}
+
+// Schedule every press, release and glitch, starting WARMUP_S from now, and log the output
+// pin; returns the cycle at which the run ends
+uint64_t bounceSchedule(struct AvrCore* avr, const struct BounceConfig* c)
+{
+    uint64_t rng = c->seed;
+    uint64_t period = (uint64_t)(c->period * c->fCpu);
+    uint64_t hold = (uint64_t)(c->hold * c->fCpu);
+    uint64_t bounce = (uint64_t)(c->bounce * c->fCpu);
+    uint64_t width = (uint64_t)(c->glitchWidth * c->fCpu);
+    uint64_t start = avr->cycles + (uint64_t)(WARMUP_S * c->fCpu);
+    uint8_t active = c->activeLevel;
+
+    gpioSetInput(avr, c->inPort, c->inBit, !active);
+    for (int i = 0; i < c->presses; i++) {
+        uint64_t t = start + i * period;
+        uint64_t quiet = t + hold + bounce; // Released and settled from here to the next press
+        uint64_t gap = period - hold - bounce;
+
+        stimBounce(avr, c->inPort, c->inBit, active, t, bounce, c->edges, c->dist, &rng);
+        stimBounce(avr, c->inPort, c->inBit, !active, t + hold, bounce, c->edges, c->dist, &rng);
+
+        // Glitches land in the middle 80% of the quiet gap, one per equal slice so they stay ordered
+        for (int g = 0; g < c->glitches; g++) {
+            uint64_t slice = gap * 8 / 10 / c->glitches;
+            uint64_t room = slice > width ? slice - width : 0;
+            uint64_t at = quiet + gap / 10 + g * slice + (uint64_t)(stimRandom(&rng) * room);
+            gpioSchedule(avr, c->inPort, c->inBit, active, at);
+            gpioSchedule(avr, c->inPort, c->inBit, !active, at + width);
+        }
+    }
+    gpioWatch(avr, c->outPort, c->outBit);
+    return start + c->presses * period;
+}
+
+// Score the logged output toggles against each press window [press, next press); 'end' is
+// what bounceSchedule() returned. 'latency', if not NULL, receives the latency of every
+// detected press in press order.
+void bounceScore(const struct AvrCore* avr, const struct BounceConfig* c, uint64_t end,
+                 struct BounceScore* s, uint64_t* latency)
+{
+    const struct AvrGpio* g = &avr->gpio;
+    uint64_t period = (uint64_t)(c->period * c->fCpu);
+    uint64_t hold = (uint64_t)(c->hold * c->fCpu);
+    uint64_t bounce = (uint64_t)(c->bounce * c->fCpu);
+    uint64_t start = end - c->presses * period;
+    uint8_t outPort = c->outPort - 'A';
+    uint32_t k = 0;
+
+    memset(s, 0, sizeof(*s));
+    s->presses = c->presses;
+    for (int i = 0; i < c->presses; i++) {
+        uint64_t pressAt = start + i * period;
+        int first = 1;
+
+        for (; k < g->edgeCount && g->edges[k].cycle < pressAt + period; k++) {
+            const struct AvrPinChange* e = &g->edges[k];
+
+            if (e->port != outPort || e->bit != c->outBit || e->cycle < pressAt) {
+                continue; // Other pins, and output changes during start-up
+            }
+            if (first && e->cycle < pressAt + hold) {
+                uint64_t lat = e->cycle - pressAt;
+                uint64_t settled = lat > bounce ? lat - bounce : 0;
+
+                if (latency) {
+                    latency[s->detected] = lat;
+                }
+                if (s->detected == 0 || lat < s->latencyMin) {
+                    s->latencyMin = lat;
+                }
+                if (lat > s->latencyMax) {
+                    s->latencyMax = lat;
+                }
+                if (settled > s->settledMax) {
+                    s->settledMax = settled;
+                }
+                s->latencySum += lat;
+                s->settledSum += settled;
+                s->detected++;
+            } else {
+                s->falseTriggers++;
+            }
+            first = 0;
+        }
+    }
+}
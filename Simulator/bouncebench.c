@@ -0,0 +1,121 @@
+//===========================================================================================
+// Project: ATmega32A Host-Side Simulator
+// Compiler: gcc (host, C99)
+// Target microcontroller: ATmega32A (simulated)
+// Description: Debouncer benchmark. Runs a firmware image against thousands of synthetic
+//              button presses, each with random contact bounce on press and release, and
+//              optional noise glitches between presses, then scores the output pin the
+//              firmware toggles once per detected press (PB1 in deBounce_Button) for missed
+//              presses, false triggers and latency (see bounce.c). The same seed always
+//              produces the same input, so two builds of the firmware can be compared press
+//              for press; boardfarm runs many seeds at once.
+// Usage:   ./bouncebench [options] image.hex   (see usage())
+// Date created: 2026-10-16
+//===========================================================================================
+
+//============================================Libraries========================================
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "avrsim.h"
+
+//============================================Functions========================================
+static void usage(const char* prog)
+{
+    fprintf(stderr, "usage: %s " BOUNCE_USAGE "\n          [-v file.vcd [-V signals]] image.hex\n"
+            BOUNCE_DEFAULTS, prog);
+    exit(2);
+}
+
+static int compareCycles(const void* a, const void* b)
+{
+    uint64_t x = *(const uint64_t*)a;
+    uint64_t y = *(const uint64_t*)b;
+    return x < y ? -1 : x > y;
+}
+
+int main(int argc, char** argv)
+{
+    static struct AvrCore avr; // Too large for the stack
+    struct BounceConfig c;
+    struct BounceScore score;
+    uint64_t* latency;
+    const char* vcdPath = NULL;
+    const char* vcdSignals = NULL;
+    int opt;
+
+    bounceDefaults(&c);
+    while ((opt = getopt(argc, argv, BOUNCE_OPTIONS "v:V:")) != -1) {
+        switch (opt) {
+        case 'v': vcdPath = optarg; break;
+        case 'V': vcdSignals = optarg; break;
+        default:
+            if (bounceOption(&c, opt, optarg) <= 0) {
+                usage(argv[0]);
+            }
+        }
+    }
+    if (optind != argc - 1 || !bounceValid(&c)) {
+        usage(argv[0]);
+    }
+
+    avrInit(&avr);
+    gpioAttach(&avr);
+    extintAttach(&avr);
+    timer0Attach(&avr);
+    timer1Attach(&avr);
+    usartAttach(&avr);
+    if (avrLoadHex(&avr, argv[optind]) < 0) {
+        return 1;
+    }
+
+    latency = calloc(c.presses, sizeof(*latency));
+    if (!latency) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+    uint64_t end = bounceSchedule(&avr, &c);
+    if (vcdPath && !vcdOpen(&avr, vcdPath, vcdSignals, c.fCpu)) {
+        return 1;
+    }
+
+    // Run at full speed; the port model logs every change of the output pin
+    if (avrRun(&avr, end) != AVR_STOP_CYCLES) {
+        fprintf(stderr, "%s: stopped at pc 0x%04x (reason %d)\n", argv[optind], avr.pc * 2,
+                avr.stopReason);
+    }
+    if (avr.gpio.edgesLost) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+    bounceScore(&avr, &c, end, &score, latency);
+
+    int detected = score.detected;
+    printf("%s: %d presses, bounce %.3f ms x %d edges (%s), %d glitches of %.0f us per gap, seed %llu\n",
+           argv[optind], c.presses, c.bounce * 1e3, c.edges, c.dist == STIM_EXP ? "exp" : "uniform",
+           c.glitches, c.glitchWidth * 1e6, (unsigned long long)c.seed);
+    printf("  detected      %d\n", detected);
+    printf("  missed        %d (%.2f%%)\n", c.presses - detected, 100.0 * (c.presses - detected) / c.presses);
+    printf("  false         %u (%.2f%% of presses)\n", score.falseTriggers,
+           100.0 * score.falseTriggers / c.presses);
+    if (detected) {
+        double ms = 1e3 / c.fCpu;
+        double sum = 0;
+
+        qsort(latency, detected, sizeof(*latency), compareCycles);
+        for (int i = 0; i < detected; i++) {
+            sum += latency[i];
+        }
+        printf("  latency from first edge  min %.3f  mean %.3f  p95 %.3f  max %.3f ms\n",
+               latency[0] * ms, sum / detected * ms, latency[(detected * 95) / 100] * ms,
+               latency[detected - 1] * ms);
+        printf("  latency from settling    mean %.3f  max %.3f ms\n",
+               (double)score.settledSum / detected * ms, score.settledMax * ms);
+    }
+
+    vcdClose(&avr);
+    free(latency);
+    avrFree(&avr);
+    return 0;
+}
@@ -0,0 +1,183 @@
+//===========================================================================================
+// Project: ATmega32A Host-Side Simulator
+// Compiler: gcc (host, C99)
+// Target microcontroller: ATmega32A (simulated)
+// Description: Checks the cycle counts of labelled code in an ELF image. The image marks
+//              each stretch to time with two global labels, delaycheck_<id>_<cycles>_<slack>
+//              in front and delaycheck_<id>_end behind, and delaycheck_done where the checks
+//              are over. The image is stepped one instruction at a time, with no idle
+//              fast-forward, from reset to delaycheck_done. Each stretch must take between
+//              <cycles> and <cycles> + <slack> cycles, measured from reaching the first label
+//              to reaching the second. delaytest/delays.c uses it for Library/delay.h, and
+//              make delaytest builds that at every -O level and checks each image.
+// Usage:   ./delaycheck [-c max_cycles] image.elf
+// Date created: 2026-10-16
+//===========================================================================================
+
+//============================================Libraries========================================
+#include <getopt.h>
+#include <stdlib.h>
+#include <string.h>
+#include "avrsim.h"
+
+//============================================Defines========================================
+#define MAX_CHECKS 64
+
+struct Check
+{
+    unsigned id;
+    unsigned long long cycles; // Expected
+    unsigned long long slack;  // Accepted on top
+    uint16_t begin;            // Word addresses of the labels
+    uint16_t end;
+    uint8_t hasEnd;
+    uint8_t started;
+    uint8_t done;
+    uint64_t startCycle;
+    uint64_t measured;
+};
+
+//============================================Functions========================================
+static struct Check* findCheck(struct Check* checks, int count, unsigned id)
+{
+    for (int i = 0; i < count; i++) {
+        if (checks[i].id == id) {
+            return &checks[i];
+        }
+    }
+    return NULL;
+}
+
+int main(int argc, char** argv)
+{
+    static struct AvrCore avr;
+    struct AvrSymbols syms;
+    struct Check checks[MAX_CHECKS];
+    int count = 0;
+    int failed = 0;
+    int haveDone = 0;
+    uint16_t done = 0;
+    uint64_t limit = 100000000ULL;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "c:")) != -1) {
+        switch (opt) {
+        case 'c': limit = strtoull(optarg, NULL, 0); break;
+        default:
+            fprintf(stderr, "usage: %s [-c max_cycles] image.elf\n", argv[0]);
+            return 2;
+        }
+    }
+    if (optind + 1 != argc) {
+        fprintf(stderr, "usage: %s [-c max_cycles] image.elf\n", argv[0]);
+        return 2;
+    }
+
+    avrInit(&avr);
+    gpioAttach(&avr);
+    extintAttach(&avr);
+    timer0Attach(&avr);
+    timer1Attach(&avr);
+    usartAttach(&avr);
+    if (elfLoad(&avr, argv[optind], &syms) < 0) {
+        return 2;
+    }
+
+    // Collect the labels
+    for (uint32_t i = 0; i < syms.count; i++) {
+        const char* name = syms.syms[i].name;
+        unsigned id;
+        unsigned long long cycles, slack;
+        int used = 0;
+        struct Check* c;
+
+        if (strncmp(name, "delaycheck_", 11) != 0) {
+            continue;
+        }
+        if (!strcmp(name, "delaycheck_done")) {
+            done = (uint16_t)(syms.syms[i].addr / 2);
+            haveDone = 1;
+            continue;
+        }
+        if (sscanf(name, "delaycheck_%u_%llu_%llu%n", &id, &cycles, &slack, &used) == 3
+            && name[used] == '\0') {
+            if (!(c = findCheck(checks, count, id))) {
+                if (count == MAX_CHECKS) {
+                    fprintf(stderr, "more than %d checks\n", MAX_CHECKS);
+                    return 2;
+                }
+                c = &checks[count++];
+                memset(c, 0, sizeof(*c));
+                c->id = id;
+            }
+            c->cycles = cycles;
+            c->slack = slack;
+            c->begin = (uint16_t)(syms.syms[i].addr / 2);
+        } else if (sscanf(name, "delaycheck_%u_end%n", &id, &used) == 1 && name[used] == '\0') {
+            if (!(c = findCheck(checks, count, id))) {
+                if (count == MAX_CHECKS) {
+                    fprintf(stderr, "more than %d checks\n", MAX_CHECKS);
+                    return 2;
+                }
+                c = &checks[count++];
+                memset(c, 0, sizeof(*c));
+                c->id = id;
+            }
+            c->end = (uint16_t)(syms.syms[i].addr / 2);
+            c->hasEnd = 1;
+        }
+    }
+    if (count == 0 || !haveDone) {
+        fprintf(stderr, "%s: no delaycheck_ labels (or no delaycheck_done)\n", argv[optind]);
+        symFree(&syms);
+        return 2;
+    }
+
+    // Step to delaycheck_done; labels are checked before the instruction at them runs
+    while (avr.pc != done && avr.cycles < limit) {
+        for (int i = 0; i < count; i++) {
+            struct Check* c = &checks[i];
+            if (c->started && !c->done && c->hasEnd && avr.pc == c->end) {
+                c->measured = avr.cycles - c->startCycle;
+                c->done = 1;
+            }
+            if (!c->started && avr.pc == c->begin) {
+                c->started = 1;
+                c->startCycle = avr.cycles;
+            }
+        }
+        if (avrStep(&avr) < 0) {
+            break;
+        }
+    }
+
+    printf("%s: %llu cycles to delaycheck_done\n", argv[optind], (unsigned long long)avr.cycles);
+    printf("  %4s %12s %12s %12s\n", "id", "expected", "measured", "");
+    for (int i = 0; i < count; i++) {
+        const struct Check* c = &checks[i];
+        int ok = c->done && c->measured >= c->cycles && c->measured <= c->cycles + c->slack;
+
+        if (c->done) {
+            printf("  %4u %12llu %12llu %12s", c->id, c->cycles, (unsigned long long)c->measured,
+                   ok ? "ok" : "FAIL");
+        } else {
+            printf("  %4u %12llu %12s %12s", c->id, c->cycles, "-", "FAIL");
+        }
+        if (c->slack) {
+            printf("  (+%llu accepted)", c->slack);
+        }
+        if (!c->hasEnd) {
+            printf("  no end label");
+        } else if (!c->done) {
+            printf("  end never reached");
+        }
+        printf("\n");
+        failed |= !ok;
+    }
+    if (avr.pc != done) {
+        printf("  delaycheck_done not reached within %llu cycles\n", (unsigned long long)limit);
+        failed = 1;
+    }
+    symFree(&syms);
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,73 @@
+//===========================================================================================
+// Project: ATmega32A Delay Accuracy Test
+// Compiler: avr-gcc (any -O level; F_CPU comes from the command line)
+// Target microcontroller: ATmega32A (run by Simulator/delaycheck)
+// Description: Runs every kind of Library/delay.h delay once, each between two global labels:
+//              delaycheck_<id>_<cycles>_<slack> in front of it and delaycheck_<id>_end behind
+//              it. delaycheck times the run from one label to the other on the simulator and
+//              wants between <cycles> and <cycles> + <slack> cycles, <cycles> being the
+//              delay plus the NOP behind the first label. The compile-time delays
+//              must be exact (slack 0) whatever the optimization level. delayMsVar() may also
+//              spend a few cycles loading its argument, plus its call when -O0 does not
+//              inline it. Interrupts stay disabled throughout.
+// Usage:   avr-gcc -mmcu=atmega32a -DF_CPU=8000000UL -O2 -o delays.elf delays.c
+//          ../delaycheck delays.elf                  (or make delaytest in Simulator/)
+// Date created: 2026-10-16
+//===========================================================================================
+
+//============================================Libraries========================================
+#include <avr/io.h>
+#include "../../Library/delay.h"
+
+//============================================Defines========================================
+#define VAR_SLACK 64 // Argument load, call and return of delayMsVar() at -O0
+
+// Labels around one delay. Every begin label sits between two NOPs, so no two labels share
+// an address (the symbol table keeps one name per address); the NOP after it is counted.
+#define CHECK(id, cycles, slack, delay)                                             \
+    do {                                                                           \
+        __asm__ __volatile__("nop"                                   "\n"          \
+                             ".global delaycheck_" #id "_%0_%1"      "\n"          \
+                             "delaycheck_" #id "_%0_%1:"             "\n"          \
+                             "nop"                                                 \
+                             : : "n" ((cycles) + 1), "n" (slack));                 \
+        delay;                                                                     \
+        __asm__ __volatile__(".global delaycheck_" #id "_end"        "\n"          \
+                             "delaycheck_" #id "_end:");                           \
+    } while (0)
+
+//============================================Global Variables========================================
+volatile uint16_t varMs = 3; // Read at run time, so delayMsVar() cannot be folded
+
+//============================================Main Code========================================
+int main(void)
+{
+    uint16_t ms = varMs;
+
+    // NOPs only (below 7 cycles), then the loop with every padding 0..4
+    CHECK(1, 0, 0, delayCycles(0));
+    CHECK(2, 1, 0, delayCycles(1));
+    CHECK(3, 6, 0, delayCycles(6));
+    CHECK(4, 7, 0, delayCycles(7));
+    CHECK(5, 8, 0, delayCycles(8));
+    CHECK(6, 9, 0, delayCycles(9));
+    CHECK(7, 10, 0, delayCycles(10));
+    CHECK(8, 11, 0, delayCycles(11));
+    CHECK(9, 1000, 0, delayCycles(1000));
+
+    // Rounded to the nearest cycle from F_CPU
+    CHECK(10, DELAY_US_CYCLES(1), 0, delayUs(1));
+    CHECK(11, DELAY_US_CYCLES(10), 0, delayUs(10));
+    CHECK(12, DELAY_US_CYCLES(333), 0, delayUs(333));
+    CHECK(13, DELAY_MS_CYCLES(1), 0, delayMs(1));
+    CHECK(14, DELAY_MS_CYCLES(25), 0, delayMs(25));
+
+    // Run-time count: ms passes of (F_CPU + 500) / 1000 cycles, the last BRNE not taken
+    CHECK(15, 3 * ((F_CPU + 500UL) / 1000UL) - 1, VAR_SLACK, delayMsVar(ms));
+
+    __asm__ __volatile__("nop"                     "\n"
+                         ".global delaycheck_done" "\n"
+                         "delaycheck_done:");
+    for (;;) {
+    }
+}
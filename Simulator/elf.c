@@ -0,0 +1,658 @@
+//===========================================================================================
+// Project: ATmega32A Host-Side Simulator
+// Compiler: gcc (host, C99)
+// Target microcontroller: ATmega32A (simulated)
+// Description: ELF loader for the a.out files avr-gcc links next to each .hex. Program
+//              memory comes from the loadable segments (text and the .data initialisers, at
+//              their load addresses), function names from the symbol table, and source lines
+//              from the DWARF line table (.debug_line, versions 2 to 5) when the image was
+//              built with -g. Without -g only the line table is missing; names still work.
+//
+//              Symbols in .text are kept: functions first, then global and weak labels
+//              (__vectors, __do_clear_bss, ...); local '.L' style labels are dropped. A code
+//              address belongs to the closest symbol at or below it, within the symbol's size
+//              when the symbol has one. Other local labels (written into the source with asm,
+//              such as the loop labels wcet bounds are keyed on) are kept in a list of their
+//              own, so they never split a function or take its name.
+// Date created: 2026-10-16
+//===========================================================================================
+
+//============================================Libraries========================================
+#include <stdlib.h>
+#include <string.h>
+#include "avrsim.h"
+
+//============================================Defines========================================
+#define ELF_MACHINE_AVR 83
+#define ELF_PT_LOAD     1
+#define ELF_SHT_SYMTAB  2
+#define ELF_STT_NOTYPE  0
+#define ELF_STT_FUNC    2
+#define ELF_STB_GLOBAL  1
+#define ELF_STB_WEAK    2
+#define ELF_DATA_BASE   0x800000 // Data space in the AVR linker's flat address map
+
+// Symbol ranking when several share an address
+#define SYM_RANK_FUNC   3
+#define SYM_RANK_GLOBAL 2
+#define SYM_RANK_WEAK   1
+
+// A little-endian byte range being read; 'bad' sticks once a read runs past the end
+struct ElfReader
+{
+    const uint8_t* p;
+    const uint8_t* end;
+    int bad;
+};
+
+//============================================Helpers========================================
+static uint32_t get16(const uint8_t* p)
+{
+    return p[0] | (p[1] << 8);
+}
+
+static uint32_t get32(const uint8_t* p)
+{
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint64_t readBytes(struct ElfReader* r, int n)
+{
+    uint64_t v = 0;
+
+    if (r->bad || r->end - r->p < n) {
+        r->bad = 1;
+        return 0;
+    }
+    for (int i = 0; i < n; i++) {
+        v |= (uint64_t)r->p[i] << (8 * i);
+    }
+    r->p += n;
+    return v;
+}
+
+static uint64_t readUleb(struct ElfReader* r)
+{
+    uint64_t v = 0;
+    int shift = 0;
+
+    while (!r->bad) {
+        uint8_t b = (uint8_t)readBytes(r, 1);
+        if (shift < 64) {
+            v |= (uint64_t)(b & 0x7F) << shift;
+        }
+        shift += 7;
+        if (!(b & 0x80)) {
+            break;
+        }
+    }
+    return v;
+}
+
+static int64_t readSleb(struct ElfReader* r)
+{
+    int64_t v = 0;
+    int shift = 0;
+    uint8_t b = 0;
+
+    do {
+        b = (uint8_t)readBytes(r, 1);
+        if (shift < 64) {
+            v |= (int64_t)(b & 0x7F) << shift;
+        }
+        shift += 7;
+    } while ((b & 0x80) && !r->bad);
+    if (shift < 64 && (b & 0x40)) {
+        v |= -((int64_t)1 << shift);
+    }
+    return v;
+}
+
+static const char* readString(struct ElfReader* r)
+{
+    const char* s = (const char*)r->p;
+    const uint8_t* nul = memchr(r->p, 0, r->bad ? 0 : r->end - r->p);
+
+    if (!nul) {
+        r->bad = 1;
+        return "";
+    }
+    r->p = nul + 1;
+    return s;
+}
+
+// File name storage; returns the index of 'name', added if new
+static int addFile(struct AvrSymbols* syms, const char* dir, const char* name)
+{
+    char path[512];
+
+    if (dir && *dir && name[0] != '/') {
+        snprintf(path, sizeof(path), "%s/%s", dir, name);
+    } else {
+        snprintf(path, sizeof(path), "%s", name);
+    }
+    for (uint32_t i = 0; i < syms->fileCount; i++) {
+        if (!strcmp(syms->files[i], path)) {
+            return (int)i;
+        }
+    }
+    char** grown = realloc(syms->files, (syms->fileCount + 1) * sizeof(*grown));
+    if (!grown) {
+        return -1;
+    }
+    syms->files = grown;
+    syms->files[syms->fileCount] = strdup(path);
+    return syms->files[syms->fileCount] ? (int)syms->fileCount++ : -1;
+}
+
+static int addLine(struct AvrSymbols* syms, uint32_t addr, int file, uint32_t line)
+{
+    if (syms->lineCount == syms->lineSize) {
+        uint32_t size = syms->lineSize ? syms->lineSize * 2 : 256;
+        struct AvrLine* grown = realloc(syms->lines, size * sizeof(*grown));
+        if (!grown) {
+            return -1;
+        }
+        syms->lines = grown;
+        syms->lineSize = size;
+    }
+    syms->lines[syms->lineCount].addr = addr;
+    syms->lines[syms->lineCount].file = file < 0 ? 0 : (uint16_t)file;
+    syms->lines[syms->lineCount].line = line;
+    syms->lines[syms->lineCount].order = syms->lineCount;
+    syms->lineCount++;
+    return 0;
+}
+
+// Skip (or, for names, return) one attribute of a DWARF 5 directory or file entry
+static const char* readEntryForm(struct ElfReader* r, uint64_t form, int offset64,
+                                 const uint8_t* lineStr, size_t lineStrSize,
+                                 const uint8_t* str, size_t strSize, uint64_t* value)
+{
+    uint64_t off;
+
+    *value = 0;
+    switch (form) {
+    case 0x08: // DW_FORM_string
+        return readString(r);
+    case 0x1F: // DW_FORM_line_strp
+    case 0x0E: // DW_FORM_strp
+        off = readBytes(r, offset64 ? 8 : 4);
+        if (form == 0x1F) {
+            return off < lineStrSize ? (const char*)lineStr + off : "";
+        }
+        return off < strSize ? (const char*)str + off : "";
+    case 0x0B: *value = readBytes(r, 1); return NULL; // DW_FORM_data1
+    case 0x05: *value = readBytes(r, 2); return NULL; // DW_FORM_data2
+    case 0x06: *value = readBytes(r, 4); return NULL; // DW_FORM_data4
+    case 0x07: *value = readBytes(r, 8); return NULL; // DW_FORM_data8
+    case 0x0F: *value = readUleb(r); return NULL;     // DW_FORM_udata
+    case 0x1E: readBytes(r, 8); readBytes(r, 8); return NULL; // DW_FORM_data16 (MD5)
+    case 0x09: // DW_FORM_block
+        off = readUleb(r);
+        if (off > (uint64_t)(r->end - r->p)) {
+            r->bad = 1;
+        } else {
+            r->p += off;
+        }
+        return NULL;
+    default: r->bad = 1; return NULL;
+    }
+}
+
+// Run the line number program of one unit; 'r' covers exactly the unit
+static int parseLineUnit(struct AvrSymbols* syms, struct ElfReader* r, int offset64,
+                         const uint8_t* lineStr, size_t lineStrSize,
+                         const uint8_t* str, size_t strSize)
+{
+    uint16_t version = (uint16_t)readBytes(r, 2);
+    uint64_t headerLength;
+    const uint8_t* program;
+    uint8_t minLength, lineRange, opcodeBase;
+    int8_t lineBase;
+    uint8_t opLengths[256];
+    const char* dirs[256];
+    int dirCount = 0;
+    int files[1024];
+    int fileCount = 0;
+
+    if (version < 2 || version > 5) {
+        return 0; // Unknown layout: skip the unit
+    }
+    if (version >= 5) {
+        readBytes(r, 2); // Address size, segment selector size
+    }
+    headerLength = readBytes(r, offset64 ? 8 : 4);
+    program = r->p + headerLength;
+    minLength = (uint8_t)readBytes(r, 1);
+    if (version >= 4) {
+        readBytes(r, 1); // Maximum operations per instruction (VLIW only)
+    }
+    readBytes(r, 1); // default_is_stmt
+    lineBase = (int8_t)readBytes(r, 1);
+    lineRange = (uint8_t)readBytes(r, 1);
+    opcodeBase = (uint8_t)readBytes(r, 1);
+    memset(opLengths, 0, sizeof(opLengths));
+    for (int i = 1; i < opcodeBase; i++) {
+        opLengths[i] = (uint8_t)readBytes(r, 1);
+    }
+
+    if (version < 5) {
+        // Directory 0 is the compilation directory, not listed; files count from 1
+        dirs[dirCount++] = "";
+        for (const char* d = readString(r); *d && !r->bad; d = readString(r)) {
+            if (dirCount < 256) {
+                dirs[dirCount++] = d;
+            }
+        }
+        files[fileCount++] = -1;
+        for (const char* f = readString(r); *f && !r->bad; f = readString(r)) {
+            uint64_t dir = readUleb(r);
+            readUleb(r); // Modification time
+            readUleb(r); // Length
+            if (fileCount < 1024) {
+                files[fileCount++] = addFile(syms, dir < (uint64_t)dirCount ? dirs[dir] : "", f);
+            }
+        }
+    } else {
+        // DWARF 5: self-describing entry formats for directories and files, both from 0
+        for (int table = 0; table < 2; table++) {
+            uint64_t formats[16][2];
+            int formatCount = (int)readBytes(r, 1);
+            uint64_t count;
+
+            for (int i = 0; i < formatCount; i++) {
+                uint64_t type = readUleb(r);
+                uint64_t form = readUleb(r);
+                if (i < 16) {
+                    formats[i][0] = type;
+                    formats[i][1] = form;
+                }
+            }
+            count = readUleb(r);
+            for (uint64_t n = 0; n < count && !r->bad; n++) {
+                const char* name = "";
+                uint64_t dir = 0;
+
+                for (int i = 0; i < formatCount && i < 16; i++) {
+                    uint64_t value;
+                    const char* s = readEntryForm(r, formats[i][1], offset64, lineStr, lineStrSize,
+                                                  str, strSize, &value);
+                    if (formats[i][0] == 1 && s) { // DW_LNCT_path
+                        name = s;
+                    } else if (formats[i][0] == 2) { // DW_LNCT_directory_index
+                        dir = value;
+                    }
+                }
+                if (table == 0 && dirCount < 256) {
+                    dirs[dirCount++] = name;
+                } else if (table == 1 && fileCount < 1024) {
+                    files[fileCount++] = addFile(syms, dir < (uint64_t)dirCount ? dirs[dir] : "", name);
+                }
+            }
+        }
+    }
+    if (r->bad || program > r->end || lineRange == 0) {
+        return -1;
+    }
+    r->p = program;
+
+    // The state machine; only rows (address, file, line) are kept
+    uint32_t address = 0;
+    uint64_t file = 1;
+    int64_t line = 1;
+    while (r->p < r->end && !r->bad) {
+        uint8_t op = (uint8_t)readBytes(r, 1);
+
+        if (op >= opcodeBase) {
+            uint8_t adjusted = op - opcodeBase;
+            address += (adjusted / lineRange) * minLength;
+            line += lineBase + adjusted % lineRange;
+            if (addLine(syms, address, file < (uint64_t)fileCount ? files[file] : -1, (uint32_t)line) < 0) {
+                return -1;
+            }
+            continue;
+        }
+        switch (op) {
+        case 0: { // Extended opcode
+            uint64_t len = readUleb(r);
+            const uint8_t* next = r->p + len;
+            uint8_t ext = len ? (uint8_t)readBytes(r, 1) : 0;
+
+            if (ext == 1) { // DW_LNE_end_sequence: a row with line 0 closes the range
+                if (addLine(syms, address, -1, 0) < 0) {
+                    return -1;
+                }
+                address = 0;
+                file = 1;
+                line = 1;
+            } else if (ext == 2) { // DW_LNE_set_address
+                address = (uint32_t)readBytes(r, (int)(len - 1));
+            }
+            r->p = next;
+            break;
+        }
+        case 1: // DW_LNS_copy
+            if (addLine(syms, address, file < (uint64_t)fileCount ? files[file] : -1, (uint32_t)line) < 0) {
+                return -1;
+            }
+            break;
+        case 2: address += (uint32_t)readUleb(r) * minLength; break; // advance_pc
+        case 3: line += readSleb(r); break;                          // advance_line
+        case 4: file = readUleb(r); break;                           // set_file
+        case 5: readUleb(r); break;                                  // set_column
+        case 6: case 7: case 10: case 11: break;                     // flags and markers
+        case 8: address += ((255 - opcodeBase) / lineRange) * minLength; break; // const_add_pc
+        case 9: address += (uint32_t)readBytes(r, 2); break;         // fixed_advance_pc
+        case 12: readUleb(r); break;                                 // set_isa
+        default: // Unknown standard opcode: skip its operands
+            for (int i = 0; i < opLengths[op]; i++) {
+                readUleb(r);
+            }
+        }
+    }
+    return r->bad ? -1 : 0;
+}
+
+// Build the sorted address -> line table from .debug_line
+static int parseLines(struct AvrSymbols* syms, const uint8_t* sec, size_t size,
+                      const uint8_t* lineStr, size_t lineStrSize, const uint8_t* str, size_t strSize)
+{
+    struct ElfReader r = { sec, sec + size, 0 };
+
+    while (r.p < r.end && !r.bad) {
+        uint64_t length = readBytes(&r, 4);
+        int offset64 = length == 0xFFFFFFFF;
+        struct ElfReader unit;
+
+        if (offset64) {
+            length = readBytes(&r, 8);
+        }
+        if (r.bad || length > (uint64_t)(r.end - r.p)) {
+            return -1;
+        }
+        unit.p = r.p;
+        unit.end = r.p + length;
+        unit.bad = 0;
+        if (parseLineUnit(syms, &unit, offset64, lineStr, lineStrSize, str, strSize) < 0) {
+            return -1;
+        }
+        r.p += length;
+    }
+    return r.bad ? -1 : 0;
+}
+
+static int byAddr(const void* a, const void* b)
+{
+    const struct AvrSymbol* x = a;
+    const struct AvrSymbol* y = b;
+
+    if (x->addr != y->addr) {
+        return x->addr < y->addr ? -1 : 1;
+    }
+    return y->rank - x->rank; // Best name first
+}
+
+// By address; at one address an end of sequence comes first, then rows in table order
+static int lineByAddr(const void* a, const void* b)
+{
+    const struct AvrLine* x = a;
+    const struct AvrLine* y = b;
+
+    if (x->addr != y->addr) {
+        return x->addr < y->addr ? -1 : 1;
+    }
+    if ((x->line == 0) != (y->line == 0)) {
+        return x->line == 0 ? -1 : 1;
+    }
+    return x->order < y->order ? -1 : x->order > y->order;
+}
+
+//============================================Functions========================================
+// 1 if 'path' starts like an ELF file
+int elfIsFile(const char* path)
+{
+    uint8_t magic[4];
+    FILE* f = fopen(path, "rb");
+    int is;
+
+    if (!f) {
+        return 0;
+    }
+    is = fread(magic, sizeof(magic), 1, f) == 1 && !memcmp(magic, "\177ELF", 4);
+    fclose(f);
+    return is;
+}
+
+// Load an AVR ELF executable into program memory and, if 'syms' is not NULL, read its
+// symbols and line table. Returns the number of program bytes loaded, -1 on error.
+int elfLoad(struct AvrCore* avr, const char* path, struct AvrSymbols* syms)
+{
+    FILE* f = fopen(path, "rb");
+    uint8_t* img = NULL;
+    long size;
+    int loaded = 0;
+
+    if (syms) {
+        memset(syms, 0, sizeof(*syms));
+    }
+    if (!f) {
+        perror(path);
+        return -1;
+    }
+    if (fseek(f, 0, SEEK_END) != 0 || (size = ftell(f)) < 52 || fseek(f, 0, SEEK_SET) != 0
+        || !(img = malloc(size)) || fread(img, size, 1, f) != 1) {
+        fprintf(stderr, "%s: cannot read\n", path);
+        free(img);
+        fclose(f);
+        return -1;
+    }
+    fclose(f);
+    if (memcmp(img, "\177ELF", 4) || img[4] != 1 || img[5] != 1 || get16(img + 18) != ELF_MACHINE_AVR) {
+        fprintf(stderr, "%s: not a 32-bit little-endian AVR ELF file\n", path);
+        free(img);
+        return -1;
+    }
+
+    uint32_t phoff = get32(img + 28), shoff = get32(img + 32);
+    uint32_t phentsize = get16(img + 42), phnum = get16(img + 44);
+    uint32_t shentsize = get16(img + 46), shnum = get16(img + 48), shstrndx = get16(img + 50);
+
+    if ((uint64_t)phoff + (uint64_t)phnum * phentsize > (uint64_t)size
+        || (uint64_t)shoff + (uint64_t)shnum * shentsize > (uint64_t)size || shstrndx >= shnum
+        || (phnum && phentsize < 32) || (shnum && shentsize < 40)) {
+        fprintf(stderr, "%s: corrupt ELF headers\n", path);
+        free(img);
+        return -1;
+    }
+
+    // Program memory: every loadable segment below the data space, at its load address
+    avrFlashChanged(avr);
+    for (uint32_t i = 0; i < phnum; i++) {
+        const uint8_t* ph = img + phoff + i * phentsize;
+        uint32_t offset = get32(ph + 4), paddr = get32(ph + 12), filesz = get32(ph + 16);
+
+        if (get32(ph) != ELF_PT_LOAD || filesz == 0 || paddr >= ELF_DATA_BASE) {
+            continue;
+        }
+        if ((uint64_t)offset + filesz > (uint64_t)size || (uint64_t)paddr + filesz > AVR_FLASH_WORDS * 2) {
+            fprintf(stderr, "%s: segment at 0x%x does not fit flash\n", path, paddr);
+            free(img);
+            return -1;
+        }
+        for (uint32_t b = 0; b < filesz; b++) {
+            uint32_t addr = paddr + b;
+            uint16_t* w = &avr->flash[addr >> 1];
+            *w = (addr & 1) ? (*w & 0x00FF) | (img[offset + b] << 8) : (*w & 0xFF00) | img[offset + b];
+        }
+        loaded += filesz;
+    }
+
+    if (!syms) {
+        free(img);
+        return loaded;
+    }
+
+    // Sections by name, and the symbol table
+    const uint8_t* shstr = img + get32(img + shoff + shstrndx * shentsize + 16);
+    const uint8_t* lineSec = NULL, *lineStr = NULL, *str = NULL;
+    size_t lineSize = 0, lineStrSize = 0, strSize = 0;
+    int ok = 1;
+
+    for (uint32_t i = 0; i < shnum && ok; i++) {
+        const uint8_t* sh = img + shoff + i * shentsize;
+        uint32_t type = get32(sh + 4), offset = get32(sh + 16), secSize = get32(sh + 20);
+        const char* name = (const char*)shstr + get32(sh);
+
+        if (type != 8 && (uint64_t)offset + secSize > (uint64_t)size) { // 8 = SHT_NOBITS
+            continue;
+        }
+        if (!strcmp(name, ".debug_line")) {
+            lineSec = img + offset;
+            lineSize = secSize;
+        } else if (!strcmp(name, ".debug_line_str")) {
+            lineStr = img + offset;
+            lineStrSize = secSize;
+        } else if (!strcmp(name, ".debug_str")) {
+            str = img + offset;
+            strSize = secSize;
+        } else if (type == ELF_SHT_SYMTAB && get32(sh + 24) < shnum) {
+            const uint8_t* link = img + shoff + get32(sh + 24) * shentsize;
+            uint32_t strOff = get32(link + 16), strLen = get32(link + 20);
+            uint32_t count = secSize / 16;
+
+            if ((uint64_t)strOff + strLen > (uint64_t)size || strLen == 0) {
+                continue;
+            }
+            syms->strings = malloc(strLen + 1);
+            syms->syms = calloc(count ? count : 1, sizeof(*syms->syms));
+            syms->labels = calloc(count ? count : 1, sizeof(*syms->labels));
+            if (!syms->strings || !syms->syms || !syms->labels) {
+                ok = 0;
+                break;
+            }
+            memcpy(syms->strings, img + strOff, strLen);
+            syms->strings[strLen] = '\0';
+            for (uint32_t n = 0; n < count; n++) {
+                const uint8_t* s = img + offset + n * 16;
+                uint32_t nameOff = get32(s), value = get32(s + 4), symSize = get32(s + 8);
+                uint8_t info = s[12];
+                uint16_t shndx = (uint16_t)get16(s + 14);
+                uint8_t bind = info >> 4;
+                uint8_t rank;
+                const char* symName;
+
+                if (nameOff >= strLen || shndx == 0 || shndx >= 0xFF00 || value >= ELF_DATA_BASE) {
+                    continue; // Undefined, absolute or data
+                }
+                if (!(get32(img + shoff + shndx * shentsize + 8) & 4)) {
+                    continue; // Not in an executable section (SHF_EXECINSTR)
+                }
+                symName = syms->strings + nameOff;
+                if (!*symName || symName[0] == '.') {
+                    continue;
+                }
+                if ((info & 0xF) == ELF_STT_FUNC) {
+                    rank = SYM_RANK_FUNC;
+                } else if (bind == ELF_STB_GLOBAL) {
+                    rank = SYM_RANK_GLOBAL;
+                } else if (bind == ELF_STB_WEAK) {
+                    rank = SYM_RANK_WEAK;
+                } else {
+                    if ((info & 0xF) == ELF_STT_NOTYPE) { // Local label: kept aside, never a name
+                        syms->labels[syms->labelCount].addr = value;
+                        syms->labels[syms->labelCount].name = symName;
+                        syms->labelCount++;
+                    }
+                    continue;
+                }
+                syms->syms[syms->count].addr = value;
+                syms->syms[syms->count].size = symSize;
+                syms->syms[syms->count].name = symName;
+                syms->syms[syms->count].rank = rank;
+                syms->count++;
+            }
+        }
+    }
+
+    // One symbol per address, the best ranked
+    if (ok && syms->count) {
+        uint32_t kept = 0;
+
+        qsort(syms->syms, syms->count, sizeof(*syms->syms), byAddr);
+        for (uint32_t i = 0; i < syms->count; i++) {
+            if (kept == 0 || syms->syms[kept - 1].addr != syms->syms[i].addr) {
+                syms->syms[kept++] = syms->syms[i];
+            }
+        }
+        syms->count = kept;
+    }
+    if (ok && lineSec && parseLines(syms, lineSec, lineSize, lineStr, lineStrSize, str, strSize) < 0) {
+        fprintf(stderr, "%s: unreadable .debug_line, source lines not available\n", path);
+        syms->lineCount = 0;
+    }
+    if (ok && syms->lineCount) {
+        qsort(syms->lines, syms->lineCount, sizeof(*syms->lines), lineByAddr);
+    }
+    free(img);
+    if (!ok) {
+        fprintf(stderr, "out of memory\n");
+        symFree(syms);
+        return -1;
+    }
+    return loaded;
+}
+
+// Symbol containing the byte address 'addr', NULL if none
+const struct AvrSymbol* symFind(const struct AvrSymbols* syms, uint32_t addr)
+{
+    uint32_t lo = 0;
+    uint32_t hi = syms->count;
+
+    while (lo < hi) { // First symbol above addr
+        uint32_t mid = (lo + hi) / 2;
+        if (syms->syms[mid].addr <= addr) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    if (lo == 0) {
+        return NULL;
+    }
+    const struct AvrSymbol* s = &syms->syms[lo - 1];
+    return s->size == 0 || addr < s->addr + s->size ? s : NULL;
+}
+
+// Source line of the byte address 'addr', NULL if the line table does not cover it
+const struct AvrLine* symLine(const struct AvrSymbols* syms, uint32_t addr)
+{
+    uint32_t lo = 0;
+    uint32_t hi = syms->lineCount;
+
+    while (lo < hi) {
+        uint32_t mid = (lo + hi) / 2;
+        if (syms->lines[mid].addr <= addr) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    if (lo == 0 || syms->lines[lo - 1].line == 0) {
+        return NULL; // Before the first row or past an end of sequence
+    }
+    return &syms->lines[lo - 1];
+}
+
+void symFree(struct AvrSymbols* syms)
+{
+    for (uint32_t i = 0; i < syms->fileCount; i++) {
+        free(syms->files[i]);
+    }
+    free(syms->files);
+    free(syms->lines);
+    free(syms->syms);
+    free(syms->labels);
+    free(syms->strings);
+    memset(syms, 0, sizeof(*syms));
+}
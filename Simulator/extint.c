@@ -0,0 +1,185 @@
+//===========================================================================================
+// Project: ATmega32A Host-Side Simulator
+// Compiler: gcc (host, C99)
+// Target microcontroller: ATmega32A (simulated)
+// Description: External interrupts INT0 (PD2), INT1 (PD3) and INT2 (PB2). The pins are
+//              re-examined whenever the port model reports a change, so an edge is seen at the
+//              cycle it is applied and wakes a sleeping core through the normal interrupt path.
+//
+//              INT0/INT1 sense control (MCUCR ISCn1:ISCn0): low level, any change, falling or
+//              rising edge. Their edge detection needs clkIO, so edges that arrive while the
+//              core sleeps in any mode other than Idle are lost (counted in extint.missed);
+//              only the low level can wake the core from Power-down. INT2 (MCUCSR ISC2) is
+//              asynchronous and detects its edge in every sleep mode.
+//
+//              An enabled low-level request stays pending as long as the pin is low: the flag
+//              is set again on every cycle the level is active, and reads of GIFR hide it
+//              because the hardware keeps INTF0/INTF1 cleared in level mode.
+// Date created: 2026-10-16
+//===========================================================================================
+
+//============================================Libraries========================================
+#include "avrsim.h"
+
+//============================================Defines========================================
+// Data-space register addresses
+#define EI_MCUCSR 0x54
+#define EI_GIFR   0x5A
+#define EI_GICR   0x5B
+
+// GICR / GIFR bit of INTn
+static const uint8_t intBits[3] = { 1 << 6, 1 << 7, 1 << 5 };
+
+// Pin of INTn: port index (0 = A) and bit
+static const uint8_t intPort[3] = { 3, 3, 1 };
+static const uint8_t intPin[3] = { 2, 3, 2 };
+
+#define ISC_LOW     0
+#define ISC_CHANGE  1
+#define ISC_FALLING 2
+#define ISC_RISING  3
+
+#define MCUCSR_ISC2 6
+
+//============================================Helpers========================================
+// Sense control of INTn (INT2 only knows falling and rising)
+static uint8_t sense(const struct AvrCore* avr, int n)
+{
+    if (n == 2) {
+        return (avr->data[EI_MCUCSR] >> MCUCSR_ISC2) & 1 ? ISC_RISING : ISC_FALLING;
+    }
+    return (avr->data[AVR_MCUCR] >> (2 * n)) & 3;
+}
+
+// True while the core sleeps in a mode that stops clkIO
+static uint8_t ioClockStopped(const struct AvrCore* avr)
+{
+    return avr->sleeping && (avr->data[AVR_MCUCR] & AVR_SM_MASK) != AVR_SM_IDLE;
+}
+
+// Bit mask of the INTn (GIFR layout) whose low-level request is active and enabled
+static uint8_t activeLevels(struct AvrCore* avr)
+{
+    uint8_t mask = 0;
+
+    for (int n = 0; n < 2; n++) {
+        if (sense(avr, n) == ISC_LOW && (avr->data[EI_GICR] & intBits[n])
+            && !(avr->extint.last & (1 << n))) {
+            mask |= intBits[n];
+        }
+    }
+    return mask;
+}
+
+// Levels of the INTn pins, bit n = INTn
+static uint8_t pinLevels(struct AvrCore* avr)
+{
+    uint8_t levels = 0;
+
+    for (int n = 0; n < 3; n++) {
+        levels |= ((gpioPins(avr, intPort[n]) >> intPin[n]) & 1) << n;
+    }
+    return levels;
+}
+
+// Compare the pins with their last levels and set the flags they request
+static void sync(struct AvrCore* avr)
+{
+    struct AvrExtInt* e = &avr->extint;
+    uint8_t flags = 0;
+
+    for (int n = 0; n < 3; n++) {
+        uint8_t level = (gpioPins(avr, intPort[n]) >> intPin[n]) & 1;
+        uint8_t prev = (e->last >> n) & 1;
+        uint8_t isc = sense(avr, n);
+
+        if (level != prev) {
+            e->last ^= 1 << n;
+            if (isc == ISC_CHANGE || (isc == ISC_FALLING && !level) || (isc == ISC_RISING && level)) {
+                if (n < 2 && ioClockStopped(avr)) {
+                    e->missed++;
+                } else {
+                    flags |= intBits[n];
+                    avrIrqRaised(avr, n + 1, avr->cycles);
+                }
+            }
+        }
+        if (n < 2 && isc == ISC_LOW && !level && (avr->data[EI_GICR] & intBits[n])
+            && !(avr->data[EI_GIFR] & intBits[n])) {
+            flags |= intBits[n]; // Level request: re-armed until the pin goes high
+            avrIrqRaised(avr, n + 1, avr->cycles);
+        }
+    }
+    if (flags & avr->data[EI_GICR]) {
+        e->requests++;
+    }
+    avr->data[EI_GIFR] |= flags; // Flags are set even when the interrupt is disabled
+    avrUpdateIrq(avr);
+}
+
+// Keep polling every cycle while a low-level request is active
+static uint64_t nextCheck(struct AvrCore* avr)
+{
+    return activeLevels(avr) ? avr->cycles + 1 : UINT64_MAX;
+}
+
+//============================================Register hooks========================================
+static uint8_t readReg(struct AvrCore* avr, uint16_t addr, void* ctx)
+{
+    (void)ctx;
+    if (addr == EI_GIFR) {
+        return avr->data[addr] & ~activeLevels(avr);
+    }
+    return avr->data[addr];
+}
+
+static void writeReg(struct AvrCore* avr, uint16_t addr, uint8_t value, void* ctx)
+{
+    if (addr == EI_GIFR) {
+        avr->data[addr] &= ~value; // Flags are cleared by writing a logic one
+    } else {
+        avr->data[addr] = value;
+    }
+    sync(avr);
+    avrReschedule(avr, ctx, nextCheck(avr));
+}
+
+static void onChange(struct AvrCore* avr)
+{
+    // Most pin changes (a PORTx write in a busy loop) touch none of the three INTn pins
+    if (pinLevels(avr) == avr->extint.last && !activeLevels(avr)) {
+        return;
+    }
+    sync(avr);
+    avrReschedule(avr, &avr->extint, nextCheck(avr));
+}
+
+// Event: re-raise an active low-level request
+static uint64_t onEvent(struct AvrCore* avr, void* ctx)
+{
+    (void)ctx;
+    sync(avr);
+    return nextCheck(avr);
+}
+
+//============================================Functions========================================
+// Install the external interrupt model; call after gpioAttach()
+void extintAttach(struct AvrCore* avr)
+{
+    struct AvrExtInt* e = &avr->extint;
+
+    for (int n = 0; n < 3; n++) {
+        struct AvrIrqSource src = { n + 1, EI_GIFR, intBits[n], EI_GICR, intBits[n], 1 };
+        avrAddIrq(avr, &src);
+    }
+    e->last = pinLevels(avr);
+    e->requests = 0;
+    e->missed = 0;
+
+    avrSetIoHook(avr, AVR_MCUCR, readReg, writeReg, e);
+    avrSetIoHook(avr, EI_MCUCSR, readReg, writeReg, e);
+    avrSetIoHook(avr, EI_GICR, readReg, writeReg, e);
+    avrSetIoHook(avr, EI_GIFR, readReg, writeReg, e);
+    avr->gpio.onChange = onChange;
+    avrAddPeriph(avr, onEvent, e, UINT64_MAX);
+}
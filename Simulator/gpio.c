@@ -0,0 +1,203 @@
+//===========================================================================================
+// Project: ATmega32A Host-Side Simulator
+// Compiler: gcc (host, C99)
+// Target microcontroller: ATmega32A (simulated)
+// Description: Parallel port model for ports A..D. Reading PINx returns the output latch for
+//              pins configured as outputs and the externally applied level for inputs; an
+//              undriven input reads high when its pull-up (PORTx bit) is enabled, low otherwise.
+//              Inputs can be changed at scheduled cycles (gpioSchedule); every write to PORTx or
+//              DDRx and every input change is reported through gpio.onChange so pin-triggered
+//              peripherals (external interrupts) see the new levels. Watched pins
+//              (gpioWatch) log every level change with its cycle, so a harness can run the
+//              core at full speed and read the output edges afterwards.
+// Date created: 2026-10-16
+//===========================================================================================
+
+//============================================Libraries========================================
+#include <stdlib.h>
+#include "avrsim.h"
+
+//============================================Defines========================================
+// Data-space addresses of PINA; each port is PIN, DDR, PORT at descending 3-byte strides
+#define GPIO_PINA 0x39
+#define GPIO_PIN(n)  (GPIO_PINA - 3 * (n))
+#define GPIO_DDR(n)  (GPIO_PIN(n) + 1)
+#define GPIO_PORT(n) (GPIO_PIN(n) + 2)
+
+//============================================Functions========================================
+// Levels of the eight pins of port n (0 = A .. 3 = D) as seen by the CPU
+uint8_t gpioPins(struct AvrCore* avr, int n)
+{
+    uint8_t ddr = avr->data[GPIO_DDR(n)];
+    uint8_t port = avr->data[GPIO_PORT(n)];
+    uint8_t driven = avr->gpio.driven[n];
+    uint8_t inputs = (avr->gpio.level[n] & driven) | (port & ~driven); // Pull-ups on floating pins
+
+    return (port & ddr) | (inputs & ~ddr);
+}
+
+// Append the level changes of watched pins to the edge log
+static void logEdges(struct AvrCore* avr)
+{
+    struct AvrGpio* g = &avr->gpio;
+
+    for (int n = 0; n < 4; n++) {
+        uint8_t level = gpioPins(avr, n) & g->watch[n];
+        uint8_t diff = level ^ g->watchLevel[n];
+
+        g->watchLevel[n] = level;
+        for (uint8_t bit = 0; diff; bit++, diff >>= 1) {
+            if (!(diff & 1)) {
+                continue;
+            }
+            if (g->edgeCount == g->edgeSize) {
+                uint32_t size = g->edgeSize ? g->edgeSize * 2 : 64;
+                struct AvrPinChange* grown = realloc(g->edges, size * sizeof(*grown));
+                if (!grown) {
+                    g->edgesLost++;
+                    continue;
+                }
+                g->edges = grown;
+                g->edgeSize = size;
+            }
+            // The cycle at which the writing instruction started
+            g->edges[g->edgeCount].cycle = avr->cycles;
+            g->edges[g->edgeCount].port = n;
+            g->edges[g->edgeCount].bit = bit;
+            g->edges[g->edgeCount].level = (level >> bit) & 1;
+            g->edgeCount++;
+        }
+    }
+}
+
+static void changed(struct AvrCore* avr)
+{
+    if (avr->gpio.watch[0] | avr->gpio.watch[1] | avr->gpio.watch[2] | avr->gpio.watch[3]) {
+        logEdges(avr);
+    }
+    if (avr->gpio.onChange) {
+        avr->gpio.onChange(avr);
+    }
+}
+
+// PINx read hook: compute the pin levels seen by the CPU
+static uint8_t readPin(struct AvrCore* avr, uint16_t addr, void* ctx)
+{
+    (void)ctx;
+    return gpioPins(avr, (GPIO_PINA - addr) / 3);
+}
+
+// PINx is read-only on the ATmega32A
+static void writePin(struct AvrCore* avr, uint16_t addr, uint8_t value, void* ctx)
+{
+    (void)avr;
+    (void)addr;
+    (void)value;
+    (void)ctx;
+}
+
+// PORTx / DDRx write hook: store the latch and let pin-triggered peripherals look
+static void writeLatch(struct AvrCore* avr, uint16_t addr, uint8_t value, void* ctx)
+{
+    (void)ctx;
+    avr->data[addr] = value;
+    changed(avr);
+}
+
+// Apply one input change
+static void apply(struct AvrCore* avr, const struct AvrPinChange* c)
+{
+    uint8_t mask = 1 << c->bit;
+
+    if (c->level > 1) {
+        avr->gpio.driven[c->port] &= ~mask;
+        return;
+    }
+    avr->gpio.driven[c->port] |= mask;
+    if (c->level) {
+        avr->gpio.level[c->port] |= mask;
+    } else {
+        avr->gpio.level[c->port] &= ~mask;
+    }
+}
+
+// Event: apply every scheduled change that is due
+static uint64_t onEvent(struct AvrCore* avr, void* ctx)
+{
+    struct AvrGpio* g = ctx;
+
+    while (g->changeNext < g->changeCount && g->changes[g->changeNext].cycle <= avr->cycles) {
+        apply(avr, &g->changes[g->changeNext++]);
+    }
+    changed(avr);
+    return g->changeNext < g->changeCount ? g->changes[g->changeNext].cycle : UINT64_MAX;
+}
+
+// Install the port model on a core
+void gpioAttach(struct AvrCore* avr)
+{
+    for (int n = 0; n < 4; n++) {
+        avrSetIoHook(avr, GPIO_PIN(n), readPin, writePin, NULL);
+        avrSetIoHook(avr, GPIO_DDR(n), NULL, writeLatch, NULL);
+        avrSetIoHook(avr, GPIO_PORT(n), NULL, writeLatch, NULL);
+    }
+    avrAddPeriph(avr, onEvent, &avr->gpio, UINT64_MAX);
+}
+
+// Drive an input pin from outside; port is 'A'..'D'
+void gpioSetInput(struct AvrCore* avr, char port, uint8_t bit, uint8_t level)
+{
+    int n = port - 'A';
+    avr->gpio.driven[n] |= 1 << bit;
+    if (level) {
+        avr->gpio.level[n] |= 1 << bit;
+    } else {
+        avr->gpio.level[n] &= ~(1 << bit);
+    }
+    changed(avr);
+}
+
+// Stop driving a pin (it floats and follows its pull-up)
+void gpioRelease(struct AvrCore* avr, char port, uint8_t bit)
+{
+    avr->gpio.driven[port - 'A'] &= ~(1 << bit);
+    changed(avr);
+}
+
+// Log every level change of a pin from now on (avr->gpio.edges); port is 'A'..'D'
+void gpioWatch(struct AvrCore* avr, char port, uint8_t bit)
+{
+    int n = port - 'A';
+
+    avr->gpio.watch[n] |= 1 << bit;
+    avr->gpio.watchLevel[n] = gpioPins(avr, n) & avr->gpio.watch[n];
+}
+
+// Drive (level 0/1) or release (level 2) an input at an absolute cycle.
+// Changes may be added in any order; returns -1 when out of memory.
+int gpioSchedule(struct AvrCore* avr, char port, uint8_t bit, uint8_t level, uint64_t cycle)
+{
+    struct AvrGpio* g = &avr->gpio;
+    uint32_t i;
+
+    if (g->changeCount == g->changeSize) {
+        uint32_t size = g->changeSize ? g->changeSize * 2 : 64;
+        struct AvrPinChange* grown = realloc(g->changes, size * sizeof(*grown));
+        if (!grown) {
+            return -1;
+        }
+        g->changes = grown;
+        g->changeSize = size;
+    }
+    // Insertion from the end keeps in-order scripts O(1) per change
+    for (i = g->changeCount; i > g->changeNext && g->changes[i - 1].cycle > cycle; i--) {
+        g->changes[i] = g->changes[i - 1];
+    }
+    g->changes[i].cycle = cycle;
+    g->changes[i].port = port - 'A';
+    g->changes[i].bit = bit;
+    g->changes[i].level = level;
+    g->changeCount++;
+    avrReschedule(avr, g, g->changes[g->changeNext].cycle);
+    return 0;
+}
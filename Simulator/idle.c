@@ -0,0 +1,254 @@
+//===========================================================================================
+// Project: ATmega32A Host-Side Simulator
+// Compiler: gcc (host, C99)
+// Target microcontroller: ATmega32A (simulated)
+// Description: Idle-loop fast-forward. Firmware spends most of its life in loops that only
+//              wait: polling millis() until it moves, spinning on a flag an ISR sets, or
+//              counting down a delay. avrRun() skips both kinds without executing them:
+//
+//                polling loops   Every taken back edge counts down to a probe, which
+//                                snapshots the machine at the loop head and compares it at
+//                                the next arrival there. If registers, SRAM, I/O space, call
+//                                depth and pending interrupt are unchanged, no I/O register
+//                                but SREG was written and no free-running register (TCNT0)
+//                                was read, every further pass is identical until the next
+//                                peripheral event. The passes that fit before it are skipped
+//                                and the cycle, instruction, -l hit, I/O write, interrupts-
+//                                disabled window and profile counters advance by whole passes.
+//                counter loops   DEC, SUBI+SBCI.. or SBIW followed by BRNE back to itself
+//                                (delay.h, avr-libc _delay_loop_1/2), recognised when the
+//                                branch is decoded. The counter is stepped arithmetically to
+//                                the last pass that ends before the next event.
+//
+//              A skip never passes the next peripheral event or the cycle limit, so whatever
+//              happens there happens at the same cycle as without it, and every result stays
+//              cycle-exact. A failed probe doubles the distance to the next one on that loop.
+// Date created: 2026-10-16
+//===========================================================================================
+
+//============================================Libraries========================================
+#include <string.h>
+#include "avrsim.h"
+
+//============================================Defines========================================
+#define IDLE_MAX_BACKOFF 10   // At most 1024 back edges between two probes of one loop
+#define IDLE_MAX_PASS    4096 // Instructions after which a probe that never closed is dropped
+#define IDLE_SREG_INDEX  (AVR_SREG - AVR_IO_BASE)
+
+//============================================Helpers========================================
+// Cycles from the loop head at 'now' to the next event or the cycle limit, whichever is first
+static uint64_t room(const struct AvrCore* avr, uint64_t now)
+{
+    uint64_t end = avr->nextEvent < avr->idle.limit ? avr->nextEvent : avr->idle.limit;
+
+    return now < end ? end - now : 0;
+}
+
+// An interrupt would be taken at the next instruction boundary
+static int irqReady(const struct AvrCore* avr)
+{
+    return avr->pendingVector && (avr->data[AVR_SREG] & (1 << SREG_I));
+}
+
+// Snapshot the machine at the loop head; 'now' is the cycle the back edge completes
+static void probeStart(struct AvrCore* avr, const struct AvrOp* branch, uint64_t now)
+{
+    struct AvrIdle* idle = &avr->idle;
+
+    idle->branch = branch;
+    idle->clockedReads = 0;
+    idle->startCycles = now;
+    idle->startInstructions = avr->instructions + 1; // The branch itself retires after this
+    idle->startHits = avr->countHits;
+    idle->startWindows = avr->mask.windows;
+    idle->startDepth = avr->depth;
+    idle->startChild = avr->depth ? avr->frames[avr->depth - 1].child : 0;
+    idle->startPending = avr->pendingVector;
+    idle->touchedCount = 0;
+    memcpy(idle->data, avr->data, sizeof(idle->data));
+    memcpy(idle->ioWrites, avr->ioWrites, sizeof(idle->ioWrites));
+}
+
+// Cycles of the probed pass if it left the machine as it found it, 0 otherwise
+static uint64_t probeRepeats(struct AvrCore* avr, uint64_t now)
+{
+    struct AvrIdle* idle = &avr->idle;
+    const struct AvrFrame* top = avr->depth ? &avr->frames[avr->depth - 1] : NULL;
+
+    if (idle->clockedReads || idle->touchedCount > AVR_IDLE_FUNCS || irqReady(avr)
+        || avr->depth != idle->startDepth || avr->pendingVector != idle->startPending
+        || (top && top->start >= idle->startCycles)
+        || memcmp(idle->data, avr->data, sizeof(idle->data))) {
+        return 0;
+    }
+    for (int i = 0; i < AVR_IO_SIZE; i++) {
+        if (i != IDLE_SREG_INDEX && avr->ioWrites[i] != idle->ioWrites[i]) {
+            return 0; // Writes to peripherals have effects even when the value is the same
+        }
+    }
+    return now - idle->startCycles;
+}
+
+// Close the probe on 'branch' and skip the passes that fit before the next event
+static void probeFinish(struct AvrCore* avr, struct AvrOp* branch, uint64_t now)
+{
+    struct AvrIdle* idle = &avr->idle;
+    uint64_t cycles = probeRepeats(avr, now);
+    uint64_t passes;
+    uint64_t skipped;
+
+    idle->branch = NULL;
+    if (!cycles) {
+        if (branch->backoff < IDLE_MAX_BACKOFF) {
+            branch->backoff++;
+        }
+        branch->wait = 1 << branch->backoff;
+        return;
+    }
+    // Look again on the next pass: after the event the loop may go idle in a new state
+    branch->backoff = 0;
+    branch->wait = 1;
+    passes = room(avr, now) / cycles;
+    if (passes == 0) {
+        return;
+    }
+
+    skipped = passes * cycles;
+    avr->cycles += skipped;
+    avr->instructions += passes * (avr->instructions + 1 - idle->startInstructions);
+    avr->countHits += passes * (avr->countHits - idle->startHits);
+    avr->ioWrites[IDLE_SREG_INDEX] += passes * (avr->ioWrites[IDLE_SREG_INDEX] - idle->ioWrites[IDLE_SREG_INDEX]);
+    avr->mask.windows += passes * (avr->mask.windows - idle->startWindows);
+    if (!avr->irqEnabled && avr->mask.start != UINT64_MAX && avr->mask.start >= idle->startCycles) {
+        avr->mask.start += skipped; // The open window began in the last pass
+    }
+    for (int i = 0; i < idle->touchedCount; i++) {
+        struct AvrFuncStats* s = idle->touched[i].stats;
+        const struct AvrFuncStats* before = &idle->touched[i].before;
+        s->calls += passes * (s->calls - before->calls);
+        s->inclusive += passes * (s->inclusive - before->inclusive);
+        s->exclusive += passes * (s->exclusive - before->exclusive);
+    }
+    if (avr->depth) {
+        struct AvrFrame* f = &avr->frames[avr->depth - 1];
+        f->child += passes * (f->child - idle->startChild);
+    }
+    idle->skips++;
+    idle->skippedCycles += skipped;
+}
+
+//============================================Functions========================================
+// A loop branch was taken back to avr->pc (its own cycles not charged yet): probe the loop
+// now and then, and skip ahead once a pass is seen to change nothing
+void idleEdge(struct AvrCore* avr, const struct AvrOp* branch)
+{
+    struct AvrIdle* idle = &avr->idle;
+    struct AvrOp* op = &avr->ops[branch - avr->ops];
+    uint64_t now = avr->cycles + 2; // A taken branch takes two cycles
+
+    if (!idle->limit) {
+        return;
+    }
+    if (idle->branch == branch) {
+        probeFinish(avr, op, now);
+        return;
+    }
+    if (idle->branch && avr->instructions + 1 - idle->startInstructions > IDLE_MAX_PASS) {
+        idle->branch = NULL; // The probed loop was left
+    }
+    if (!idle->branch && --op->wait == 0) {
+        op->wait = 1 << op->backoff; // Next try, should this probe be abandoned
+        probeStart(avr, branch, now);
+    }
+}
+
+// A counter loop's BRNE was taken back to its head: step the counter over the passes that
+// fit before the next event. The last skipped pass really runs so SREG holds its flags.
+void idleCountdown(struct AvrCore* avr, const struct AvrOp* branch)
+{
+    uint16_t head = branch->k;
+    int bytes = branch->r;
+    uint64_t cycles = bytes + 2;                        // Per pass, BRNE taken
+    uint16_t count = (uint16_t)(branch - avr->ops) - head + 1; // Instructions per pass
+    uint64_t now = avr->cycles + 2;
+    uint32_t value = 0;
+    uint64_t left;
+    uint64_t passes;
+
+    if (!avr->idle.limit || irqReady(avr)) {
+        return;
+    }
+    for (int i = bytes - 1; i >= 0; i--) {
+        value = (value << 8) | avr->data[branch->d + i];
+    }
+    left = value ? value : (uint64_t)1 << (8 * bytes); // Passes to go; zero wraps round first
+    passes = room(avr, now) / cycles;
+    if (passes > left - 1) {
+        passes = left - 1; // The pass that falls through runs for real
+    }
+    if (passes < 2) {
+        return;
+    }
+
+    value -= passes - 1;
+    for (int i = 0; i < bytes; i++) {
+        avr->data[branch->d + i] = (value >> (8 * i)) & 0xFF;
+    }
+    for (uint16_t pc = head; pc < head + count - 1; pc++) {
+        avr->ops[pc].run(avr, &avr->ops[pc]);
+    }
+    avr->cycles += passes * cycles;
+    avr->instructions += passes * count;
+    if (avr->countPc && avr->countPc >= head && avr->countPc < head + count) {
+        avr->countHits += passes;
+    }
+    avr->idle.skips++;
+    avr->idle.skippedCycles += passes * cycles;
+}
+
+// A call returned while a pass is probed: remember its statistics as they were before
+void idleTouch(struct AvrCore* avr, struct AvrFuncStats* stats)
+{
+    struct AvrIdle* idle = &avr->idle;
+
+    for (int i = 0; i < idle->touchedCount && i < AVR_IDLE_FUNCS; i++) {
+        if (idle->touched[i].stats == stats) {
+            return;
+        }
+    }
+    if (idle->touchedCount < AVR_IDLE_FUNCS) {
+        idle->touched[idle->touchedCount].stats = stats;
+        idle->touched[idle->touchedCount].before = *stats;
+    }
+    if (idle->touchedCount <= AVR_IDLE_FUNCS) {
+        idle->touchedCount++;
+    }
+}
+
+// Counter bytes of a loop that is just DEC Rd, SUBI Rd,1 (+ SBCI Rd+1,0 ..) or SBIW Rd,1
+// from 'head' up to the BRNE at 'branch'; 0 for any other loop
+int idleCountdownBytes(const uint16_t* flash, uint16_t head, uint16_t branch, uint8_t* reg)
+{
+    uint16_t first = flash[head];
+    int words = branch - head;
+
+    if (words == 1 && (first & 0xFE0F) == 0x940A) { // DEC
+        *reg = (first >> 4) & 0x1F;
+        return 1;
+    }
+    if (words == 1 && (first & 0xFF00) == 0x9700 && (first & 0xCF) == 0x01) { // SBIW Rd, 1
+        *reg = 24 + ((first >> 3) & 0x06);
+        return 2;
+    }
+    if (words < 1 || words > 3 || (first & 0xFF0F) != 0x5001) {
+        return 0; // Not SUBI Rd, 1
+    }
+    *reg = 16 + ((first >> 4) & 0x0F);
+    for (int i = 1; i < words; i++) {
+        uint16_t w = flash[head + i];
+        if ((w & 0xFF0F) != 0x4000 || 16 + ((w >> 4) & 0x0F) != *reg + i) {
+            return 0; // Not SBCI Rd+i, 0
+        }
+    }
+    return words;
+}
@@ -0,0 +1,119 @@
+//===========================================================================================
+// Project: ATmega32A Host-Side Simulator
+// Compiler: gcc (host, C99)
+// Target microcontroller: ATmega32A (simulated)
+// Description: Intel HEX loader for the .hex images produced by avr-objcopy.
+//              Supports data (00), end-of-file (01) and the segment/linear address
+//              records (02, 04); start-address records (03, 05) are ignored.
+// Date created: 2026-10-16
+//===========================================================================================
+
+//============================================Libraries========================================
+#include <string.h>
+#include "avrsim.h"
+
+//============================================Functions========================================
+// Convert two hex digits to a byte, returns -1 on a malformed digit
+static int hexByte(const char* s)
+{
+    int v = 0;
+    for (int i = 0; i < 2; i++) {
+        char c = s[i];
+        v <<= 4;
+        if (c >= '0' && c <= '9') {
+            v |= c - '0';
+        } else if (c >= 'A' && c <= 'F') {
+            v |= c - 'A' + 10;
+        } else if (c >= 'a' && c <= 'f') {
+            v |= c - 'a' + 10;
+        } else {
+            return -1;
+        }
+    }
+    return v;
+}
+
+// Load an Intel HEX file into program memory.
+// Returns the number of bytes loaded, or -1 on error (message printed to stderr).
+int avrLoadHex(struct AvrCore* avr, const char* path)
+{
+    FILE* f = fopen(path, "r");
+    char line[600];
+    uint32_t base = 0;
+    int loaded = 0;
+    int lineNo = 0;
+
+    if (!f) {
+        perror(path);
+        return -1;
+    }
+    avrFlashChanged(avr); // Whatever was predecoded from the old image is stale now
+
+    while (fgets(line, sizeof(line), f)) {
+        uint8_t rec[260];
+        size_t len = strcspn(line, "\r\n");
+        lineNo++;
+
+        if (len == 0) {
+            continue;
+        }
+        if (line[0] != ':' || len < 11 || (len - 1) % 2 != 0) {
+            fprintf(stderr, "%s:%d: malformed record\n", path, lineNo);
+            fclose(f);
+            return -1;
+        }
+
+        // Decode the whole record and verify the checksum
+        int count = (int)(len - 1) / 2;
+        uint8_t sum = 0;
+        for (int i = 0; i < count; i++) {
+            int b = hexByte(&line[1 + i * 2]);
+            if (b < 0) {
+                fprintf(stderr, "%s:%d: bad hex digit\n", path, lineNo);
+                fclose(f);
+                return -1;
+            }
+            rec[i] = (uint8_t)b;
+            sum += rec[i];
+        }
+        if (sum != 0 || rec[0] + 5 != count) {
+            fprintf(stderr, "%s:%d: checksum or length mismatch\n", path, lineNo);
+            fclose(f);
+            return -1;
+        }
+
+        uint32_t addr = base + ((rec[1] << 8) | rec[2]);
+        switch (rec[3]) {
+        case 0x00: // Data
+            for (int i = 0; i < rec[0]; i++, addr++) {
+                if (addr >= AVR_FLASH_WORDS * 2) {
+                    fprintf(stderr, "%s:%d: address 0x%x beyond flash\n", path, lineNo, addr);
+                    fclose(f);
+                    return -1;
+                }
+                uint16_t* w = &avr->flash[addr >> 1];
+                if (addr & 1) {
+                    *w = (*w & 0x00FF) | (rec[4 + i] << 8);
+                } else {
+                    *w = (*w & 0xFF00) | rec[4 + i];
+                }
+                loaded++;
+            }
+            break;
+        case 0x01: // End of file
+            fclose(f);
+            return loaded;
+        case 0x02: // Extended segment address
+            base = ((rec[4] << 8) | rec[5]) << 4;
+            break;
+        case 0x04: // Extended linear address
+            base = (uint32_t)((rec[4] << 8) | rec[5]) << 16;
+            break;
+        default: // Start addresses are irrelevant for the AVR
+            break;
+        }
+    }
+
+    fclose(f);
+    return loaded;
+}
@@ -0,0 +1,455 @@
+//===========================================================================================
+// Project: ATmega32A Host-Side Simulator
+// Compiler: gcc (host, C99)
+// Target microcontroller: ATmega32A (simulated)
+// Description: Cycle attribution. Where the -p table times each CALL .. RET, this charges every
+//              single cycle of a run to the call stack it was spent in and to the instruction
+//              that spent it, so nothing is left over: code reached by a jump rather than a
+//              call, interrupt responses and sleep all show up.
+//
+//              The core calls profSample() before every step, like vcdSample(); the cycles of
+//              the previous step go to the stack as it was then, the cycles of a CALL or an
+//              interrupt response to the frame it opened. Stacks are kept as a tree of nodes,
+//              one per distinct path of CALL and interrupt frames, so a step costs a pointer
+//              walk and two additions. With ELF symbols a node also splits by the function the
+//              program counter is in, which names tail-called and jumped-to code.
+//
+//              Output: a flat table of self and total cycles per function, the hottest source
+//              lines (ELF built with -g) and instructions, and folded stacks
+//              ("main;updateButton;millis 8123") for flamegraph.pl or speedscope.
+// Date created: 2026-10-16
+//===========================================================================================
+
+//============================================Libraries========================================
+#include <stdlib.h>
+#include <string.h>
+#include "avrsim.h"
+
+//============================================Defines========================================
+#define PROF_NONE UINT32_MAX
+
+enum
+{
+    NODE_ROOT,  // Outside any frame: reset and startup code
+    NODE_CALL,  // CALL frame, key = callee word address
+    NODE_IRQ,   // Interrupt frame, key = vector
+    NODE_CODE,  // Code of another function inside a frame, key = symbol index
+    NODE_SLEEP  // Asleep in the parent's frame
+};
+
+struct ProfNode
+{
+    uint32_t parent;
+    uint32_t child;    // First child, PROF_NONE if none
+    uint32_t sibling;  // Next child of the parent
+    uint32_t key;
+    int32_t sym;       // Symbol the frame's own code is in, -1 if none (CALL nodes)
+    uint8_t kind;
+    uint64_t cycles;   // Spent in this node itself
+};
+
+struct AvrProfile
+{
+    const struct AvrSymbols* syms; // NULL without an ELF image
+    int32_t* symOf;                // Symbol index per flash word, with syms
+    uint64_t pcCycles[AVR_FLASH_WORDS]; // Cycles charged to each instruction
+    struct ProfNode* nodes;
+    uint32_t nodeCount;
+    uint32_t nodeSize;
+    uint32_t stack[AVR_CALL_DEPTH + 1]; // Node of each frame depth, as last synchronised
+    uint64_t stackStart[AVR_CALL_DEPTH]; // Start cycle of the frame each node was made for
+    uint8_t synced;                // Depth up to which stack[] matches avr->frames
+    uint64_t lastCycles;           // State at the previous sample
+    uint16_t lastPc;
+    uint32_t lastNode;
+    uint8_t lastDepth;
+    uint8_t lastSleeping;
+};
+
+// One name of the flat table
+struct ProfEntry
+{
+    char name[64];
+    uint64_t self;
+    uint64_t total;
+    uint32_t mark; // Last node that counted towards 'total' (recursion counts once)
+};
+
+//============================================Helpers========================================
+// Child of 'parent' with the given kind and key, created if new; PROF_NONE when out of memory
+static uint32_t child(struct AvrProfile* p, uint32_t parent, uint8_t kind, uint32_t key)
+{
+    struct ProfNode* n;
+    uint32_t i;
+
+    for (i = p->nodes[parent].child; i != PROF_NONE; i = p->nodes[i].sibling) {
+        if (p->nodes[i].kind == kind && p->nodes[i].key == key) {
+            return i;
+        }
+    }
+    if (p->nodeCount == p->nodeSize) {
+        uint32_t size = p->nodeSize * 2;
+        struct ProfNode* grown = realloc(p->nodes, size * sizeof(*grown));
+        if (!grown) {
+            return PROF_NONE;
+        }
+        p->nodes = grown;
+        p->nodeSize = size;
+    }
+    i = p->nodeCount++;
+    n = &p->nodes[i];
+    n->parent = parent;
+    n->child = PROF_NONE;
+    n->sibling = p->nodes[parent].child;
+    n->key = key;
+    n->sym = kind == NODE_CALL && p->symOf ? p->symOf[key] : -1;
+    n->kind = kind;
+    n->cycles = 0;
+    p->nodes[parent].child = i;
+    return i;
+}
+
+// Bring stack[] in line with the core's frames; returns the innermost node
+static uint32_t syncStack(struct AvrCore* avr, struct AvrProfile* p)
+{
+    uint8_t d = 0;
+
+    while (d < avr->depth && d < p->synced && p->stackStart[d] == avr->frames[d].start
+           && p->nodes[p->stack[d + 1]].key == avr->frames[d].target
+           && (p->nodes[p->stack[d + 1]].kind == NODE_IRQ) == avr->frames[d].isIrq) {
+        d++;
+    }
+    for (; d < avr->depth; d++) {
+        const struct AvrFrame* f = &avr->frames[d];
+        uint32_t n = child(p, p->stack[d], f->isIrq ? NODE_IRQ : NODE_CALL, f->target);
+
+        if (n == PROF_NONE) {
+            break; // Out of memory: charge the deepest frame there is
+        }
+        p->stack[d + 1] = n;
+        p->stackStart[d] = f->start;
+    }
+    p->synced = d;
+    return p->stack[d];
+}
+
+// Node for code at word 'pc' inside the frame 'node'
+static uint32_t codeNode(struct AvrProfile* p, uint32_t node, uint16_t pc)
+{
+    int32_t sym = p->symOf ? p->symOf[pc] : -1;
+    uint32_t n;
+
+    if (sym < 0 || sym == p->nodes[node].sym) {
+        return node;
+    }
+    n = child(p, node, NODE_CODE, (uint32_t)sym);
+    return n == PROF_NONE ? node : n;
+}
+
+static void nodeName(const struct AvrProfile* p, uint32_t i, char* buf, size_t len)
+{
+    const struct ProfNode* n = &p->nodes[i];
+    const struct AvrSymbol* s;
+
+    switch (n->kind) {
+    case NODE_ROOT: snprintf(buf, len, "[reset]"); break;
+    case NODE_IRQ: snprintf(buf, len, "%s_vect", avrVectorName((uint8_t)n->key)); break;
+    case NODE_CODE: snprintf(buf, len, "%s", p->syms->syms[n->key].name); break;
+    case NODE_SLEEP: snprintf(buf, len, "[sleep]"); break;
+    default:
+        s = p->syms ? symFind(p->syms, n->key * 2) : NULL;
+        if (s && s->addr == n->key * 2u) {
+            snprintf(buf, len, "%s", s->name);
+        } else {
+            snprintf(buf, len, "0x%04x", n->key * 2);
+        }
+    }
+}
+
+static struct ProfEntry* entryFor(struct ProfEntry* e, int* count, int size, const char* name)
+{
+    for (int i = 0; i < *count; i++) {
+        if (!strcmp(e[i].name, name)) {
+            return &e[i];
+        }
+    }
+    if (*count == size) {
+        return NULL;
+    }
+    memset(&e[*count], 0, sizeof(*e));
+    e[*count].mark = PROF_NONE;
+    snprintf(e[*count].name, sizeof(e->name), "%s", name);
+    return &e[(*count)++];
+}
+
+static int byTotal(const void* a, const void* b)
+{
+    const struct ProfEntry* x = a;
+    const struct ProfEntry* y = b;
+
+    if (x->total != y->total) {
+        return x->total > y->total ? -1 : 1;
+    }
+    return x->self > y->self ? -1 : x->self < y->self;
+}
+
+struct ProfHot
+{
+    uint32_t index; // Flash word or line row
+    uint64_t cycles;
+};
+
+static int byCycles(const void* a, const void* b)
+{
+    const struct ProfHot* x = a;
+    const struct ProfHot* y = b;
+
+    if (x->cycles != y->cycles) {
+        return x->cycles > y->cycles ? -1 : 1;
+    }
+    return x->index < y->index ? -1 : x->index > y->index;
+}
+
+// Write the path of node 'i' below the root, outermost first
+static void writePath(FILE* out, const struct AvrProfile* p, uint32_t i)
+{
+    char name[64];
+
+    if (p->nodes[i].parent != PROF_NONE && p->nodes[p->nodes[i].parent].kind != NODE_ROOT) {
+        writePath(out, p, p->nodes[i].parent);
+        fputc(';', out);
+    }
+    nodeName(p, i, name, sizeof(name));
+    fputs(name, out);
+}
+
+//============================================Functions========================================
+// Start charging cycles from the current one on. 'syms' (may be NULL) must outlive the
+// profile. Turns on the call frames of avrEnableProfile(). NULL when out of memory.
+struct AvrProfile* profOpen(struct AvrCore* avr, const struct AvrSymbols* syms)
+{
+    struct AvrProfile* p = calloc(1, sizeof(*p));
+
+    if (!p || avrEnableProfile(avr) < 0) {
+        free(p);
+        return NULL;
+    }
+    p->nodeSize = 256;
+    p->nodes = malloc(p->nodeSize * sizeof(*p->nodes));
+    if (!p->nodes) {
+        free(p);
+        return NULL;
+    }
+    if (syms && syms->count) {
+        p->syms = syms;
+        p->symOf = malloc(AVR_FLASH_WORDS * sizeof(*p->symOf));
+        if (!p->symOf) {
+            free(p->nodes);
+            free(p);
+            return NULL;
+        }
+        for (uint32_t w = 0; w < AVR_FLASH_WORDS; w++) {
+            const struct AvrSymbol* s = symFind(syms, w * 2);
+            p->symOf[w] = s ? (int32_t)(s - syms->syms) : -1;
+        }
+    }
+    p->nodes[0].parent = PROF_NONE;
+    p->nodes[0].child = PROF_NONE;
+    p->nodes[0].sibling = PROF_NONE;
+    p->nodes[0].kind = NODE_ROOT;
+    p->nodes[0].sym = -1;
+    p->nodes[0].cycles = 0;
+    p->nodeCount = 1;
+    p->stack[0] = 0;
+    p->lastCycles = avr->cycles;
+    p->lastPc = avr->pc;
+    p->lastNode = syncStack(avr, p);
+    p->lastDepth = avr->depth;
+    p->lastSleeping = avr->sleeping;
+    avr->prof = p;
+    return p;
+}
+
+// Charge the cycles since the last sample
+void profSample(struct AvrCore* avr)
+{
+    struct AvrProfile* p = avr->prof;
+    uint64_t delta = avr->cycles - p->lastCycles;
+    uint32_t node = syncStack(avr, p);
+
+    if (delta) {
+        if (avr->depth > p->lastDepth && avr->frames[avr->depth - 1].start >= p->lastCycles) {
+            // A CALL or an interrupt response opened a frame: its cost belongs to the frame
+            p->nodes[node].cycles += delta;
+            p->pcCycles[avr->frames[avr->depth - 1].isIrq ? avr->pc : p->lastPc] += delta;
+        } else if (p->lastSleeping) {
+            uint32_t sleep = child(p, p->lastNode, NODE_SLEEP, 0);
+            p->nodes[sleep == PROF_NONE ? p->lastNode : sleep].cycles += delta;
+        } else {
+            p->nodes[codeNode(p, p->lastNode, p->lastPc)].cycles += delta;
+            p->pcCycles[p->lastPc] += delta;
+        }
+    }
+    p->lastCycles = avr->cycles;
+    p->lastPc = avr->pc;
+    p->lastNode = node;
+    p->lastDepth = avr->depth;
+    p->lastSleeping = avr->sleeping;
+}
+
+// Flat profile: self and total cycles per function, then the hottest lines and instructions
+void profReport(struct AvrCore* avr, FILE* out, int top, double fCpu)
+{
+    struct AvrProfile* p = avr->prof;
+    struct ProfEntry* entries;
+    struct ProfHot* hot;
+    int count = 0;
+    int size = (int)p->nodeCount;
+    uint64_t total = 0;
+    char name[64];
+
+    profSample(avr);
+    for (uint32_t i = 0; i < p->nodeCount; i++) {
+        total += p->nodes[i].cycles;
+    }
+    entries = calloc(size, sizeof(*entries));
+    hot = malloc(AVR_FLASH_WORDS * sizeof(*hot));
+    if (!entries || !hot || total == 0) {
+        free(entries);
+        free(hot);
+        return;
+    }
+
+    // Self goes to the node's own name, total to every distinct name on its path
+    for (uint32_t i = 0; i < p->nodeCount; i++) {
+        uint64_t c = p->nodes[i].cycles;
+        struct ProfEntry* e;
+
+        if (c == 0) {
+            continue;
+        }
+        nodeName(p, i, name, sizeof(name));
+        e = entryFor(entries, &count, size, name);
+        e->self += c;
+        for (uint32_t a = i; a != PROF_NONE; a = p->nodes[a].parent) {
+            if (p->nodes[a].kind == NODE_ROOT && a != i) {
+                break;
+            }
+            nodeName(p, a, name, sizeof(name));
+            e = entryFor(entries, &count, size, name);
+            if (e->mark != i) {
+                e->mark = i;
+                e->total += c;
+            }
+        }
+    }
+    qsort(entries, count, sizeof(*entries), byTotal);
+    fprintf(out, "\nCycles by function (every cycle, by call stack):\n");
+    fprintf(out, "  %-24s %14s %7s %14s %7s %12s\n", "function", "self", "", "total", "", "total ms");
+    for (int i = 0; i < count && i < top; i++) {
+        const struct ProfEntry* e = &entries[i];
+        fprintf(out, "  %-24s %14llu %6.2f%% %14llu %6.2f%% %12.3f\n", e->name,
+                (unsigned long long)e->self, 100.0 * e->self / total,
+                (unsigned long long)e->total, 100.0 * e->total / total, e->total * 1e3 / fCpu);
+    }
+
+    // Source lines, when the ELF has a line table
+    if (p->syms && p->syms->lineCount) {
+        int lines = 0;
+
+        for (uint32_t w = 0; w < AVR_FLASH_WORDS; w++) {
+            const struct AvrLine* l;
+            if (!p->pcCycles[w] || !(l = symLine(p->syms, w * 2))) {
+                continue;
+            }
+            // Rows of one source line fold into one entry
+            int j;
+            for (j = 0; j < lines; j++) {
+                const struct AvrLine* k = &p->syms->lines[hot[j].index];
+                if (k->file == l->file && k->line == l->line) {
+                    break;
+                }
+            }
+            if (j == lines) {
+                hot[lines].index = (uint32_t)(l - p->syms->lines);
+                hot[lines++].cycles = 0;
+            }
+            hot[j].cycles += p->pcCycles[w];
+        }
+        qsort(hot, lines, sizeof(*hot), byCycles);
+        fprintf(out, "\nHottest source lines:\n");
+        for (int i = 0; i < lines && i < top; i++) {
+            const struct AvrLine* l = &p->syms->lines[hot[i].index];
+            fprintf(out, "  %14llu %6.2f%%  %s:%u\n", (unsigned long long)hot[i].cycles,
+                    100.0 * hot[i].cycles / total,
+                    p->syms->fileCount ? p->syms->files[l->file] : "?", l->line);
+        }
+    } else if (p->syms) {
+        fprintf(out, "\nNo source lines: the ELF has no line table (link it from objects built with -g)\n");
+    }
+
+    // Instructions
+    int words = 0;
+    for (uint32_t w = 0; w < AVR_FLASH_WORDS; w++) {
+        if (p->pcCycles[w]) {
+            hot[words].index = w;
+            hot[words++].cycles = p->pcCycles[w];
+        }
+    }
+    qsort(hot, words, sizeof(*hot), byCycles);
+    fprintf(out, "\nHottest instructions:\n");
+    for (int i = 0; i < words && i < top; i++) {
+        uint16_t w = (uint16_t)hot[i].index;
+        const struct AvrSymbol* s = p->syms ? symFind(p->syms, w * 2) : NULL;
+        char text[64];
+
+        avrDisasm(avr->flash, w, text, sizeof(text));
+        if (s) {
+            snprintf(name, sizeof(name), "%s+0x%x", s->name, w * 2 - s->addr);
+        } else {
+            name[0] = '\0';
+        }
+        fprintf(out, "  %14llu %6.2f%%  0x%04x %-24s %s\n", (unsigned long long)hot[i].cycles,
+                100.0 * hot[i].cycles / total, w * 2, name, text);
+    }
+    free(hot);
+    free(entries);
+}
+
+// Write folded stacks, one "outer;inner cycles" line per node that spent cycles itself
+int profFolded(struct AvrCore* avr, const char* path)
+{
+    struct AvrProfile* p = avr->prof;
+    FILE* out = fopen(path, "w");
+
+    if (!out) {
+        perror(path);
+        return -1;
+    }
+    profSample(avr);
+    for (uint32_t i = 0; i < p->nodeCount; i++) {
+        if (p->nodes[i].cycles) {
+            writePath(out, p, i);
+            fprintf(out, " %llu\n", (unsigned long long)p->nodes[i].cycles);
+        }
+    }
+    if (fclose(out) != 0) {
+        perror(path);
+        return -1;
+    }
+    return 0;
+}
+
+// Detach and free the profile
+void profClose(struct AvrCore* avr)
+{
+    struct AvrProfile* p = avr->prof;
+
+    if (!p) {
+        return;
+    }
+    free(p->symOf);
+    free(p->nodes);
+    free(p);
+    avr->prof = NULL;
+}
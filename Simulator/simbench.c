@@ -0,0 +1,118 @@
+//===========================================================================================
+// Project: ATmega32A Host-Side Simulator
+// Compiler: gcc (host, C99)
+// Target microcontroller: ATmega32A (simulated)
+// Description: Simulator speed benchmark. Runs each image for a stretch of simulated time
+//              with the usual peripherals attached and reports how fast the host got through
+//              it: simulated MIPS (instructions retired per host microsecond), simulated MHz
+//              (cycles per host microsecond, sleep included) and the real-time factor at the
+//              configured clock. Each image runs several times and the fastest run counts,
+//              so a busy host disturbs the figures as little as possible. -n turns idle-loop
+//              fast-forward off to measure the raw instruction rate.
+// Usage:   ./simbench [-F hz] [-s seconds] [-r runs] [-n] image.hex...   (make bench: every example)
+// Date created: 2026-10-16
+//===========================================================================================
+
+//============================================Libraries========================================
+#include <getopt.h>
+#include <stdlib.h>
+#include <time.h>
+#include "avrsim.h"
+
+//============================================Defines========================================
+#define DEFAULT_F_CPU 8000000.0
+
+//============================================Functions========================================
+static void usage(const char* prog)
+{
+    fprintf(stderr, "usage: %s [-F hz] [-s seconds] [-r runs] [-n] image.hex...\n"
+                    "defaults: 8 MHz, 10 simulated seconds, best of 3 runs\n", prog);
+    exit(2);
+}
+
+static double hostSeconds(void)
+{
+    struct timespec t;
+
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+// Run one image from reset for 'cycles'; returns the host seconds it took, -1 if it failed
+static double runOnce(struct AvrCore* avr, const char* path, uint64_t cycles, int noIdle)
+{
+    double start;
+    int stop;
+
+    avrInit(avr);
+    gpioAttach(avr);
+    extintAttach(avr);
+    timer0Attach(avr);
+    timer1Attach(avr);
+    usartAttach(avr);
+    avr->idle.disabled = noIdle;
+    if (avrLoadHex(avr, path) < 0) {
+        avrFree(avr);
+        return -1;
+    }
+    start = hostSeconds();
+    stop = avrRun(avr, cycles);
+    avrFree(avr); // Counters survive, only the buffers go
+    if (stop == AVR_STOP_ILLEGAL) {
+        fprintf(stderr, "%s: illegal opcode at pc 0x%04x\n", path, avr->pc * 2);
+        return -1;
+    }
+    return hostSeconds() - start;
+}
+
+int main(int argc, char** argv)
+{
+    static struct AvrCore avr; // Too large for the stack
+    double fCpu = DEFAULT_F_CPU;
+    double seconds = 10.0;
+    int runs = 3;
+    int noIdle = 0;
+    int failed = 0;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "F:s:r:n")) != -1) {
+        switch (opt) {
+        case 'F': fCpu = atof(optarg); break;
+        case 's': seconds = atof(optarg); break;
+        case 'r': runs = atoi(optarg); break;
+        case 'n': noIdle = 1; break;
+        default: usage(argv[0]);
+        }
+    }
+    if (optind >= argc || fCpu <= 0 || seconds <= 0 || runs < 1) {
+        usage(argv[0]);
+    }
+
+    printf("%-40s %12s %7s %8s %8s %9s\n", "image", "instructions", "host s", "MIPS", "sim MHz",
+           "realtime");
+    for (int i = optind; i < argc; i++) {
+        double best = -1;
+
+        for (int r = 0; r < runs; r++) {
+            double t = runOnce(&avr, argv[i], (uint64_t)(seconds * fCpu), noIdle);
+            if (t < 0) {
+                best = -1;
+                break;
+            }
+            if (best < 0 || t < best) {
+                best = t;
+            }
+        }
+        if (best < 0) {
+            failed = 1;
+        } else {
+            if (best < 1e-9) {
+                best = 1e-9;
+            }
+            printf("%-40s %12llu %7.3f %8.1f %8.1f %8.1fx\n", argv[i],
+                   (unsigned long long)avr.instructions, best, avr.instructions / best * 1e-6,
+                   avr.cycles / best * 1e-6, avr.cycles / fCpu / best);
+        }
+    }
+    return failed;
+}
@@ -0,0 +1,234 @@
+//===========================================================================================
+// Project: ATmega32A Host-Side Simulator
+// Compiler: gcc (host, C99)
+// Target microcontroller: ATmega32A (simulated)
+// Description: Equivalence check of the execution paths. Runs each image three ways side by
+//              side from reset, with the same bouncing button presses on PD2, PD6 and PD7:
+//
+//                stepped   one instruction per avrStep(), as with avrsim -t (the reference)
+//                -n        threaded predecoded loop, idle-loop fast-forward off
+//                idle      threaded loop with fast-forward, the default
+//
+//              At every checkpoint the three machines must agree on the stop reason, cycle,
+//              instruction and sleep counters, program counter, registers, SREG, SP, SRAM,
+//              the levels of all 32 pins, the write count of every I/O register and the
+//              logged pin edges, cycle for cycle. The first difference is printed per image.
+// Usage:   ./simcheck [-F hz] [-s seconds] [-k checkpoints] image.hex...   (make check)
+// Date created: 2026-10-16
+//===========================================================================================
+
+//============================================Libraries========================================
+#include <getopt.h>
+#include <stdlib.h>
+#include <string.h>
+#include "avrsim.h"
+
+//============================================Defines========================================
+#define DEFAULT_F_CPU 8000000.0
+#define MODES         3
+#define SEED          42
+
+static const char* const modeNames[MODES] = { "stepped", "-n", "idle" };
+static const uint8_t buttonBits[] = { 2, 6, 7 }; // Port D pins the examples read
+
+//============================================Functions========================================
+static void usage(const char* prog)
+{
+    fprintf(stderr, "usage: %s [-F hz] [-s seconds] [-k checkpoints] image.hex...\n"
+                    "defaults: 8 MHz, 0.4 simulated seconds, 20 checkpoints\n", prog);
+    exit(2);
+}
+
+// Reset a core for one mode, load the image and schedule the presses; -1 if it failed
+static int setup(struct AvrCore* avr, int mode, const char* path, uint64_t total, double fCpu,
+                 FILE* sink)
+{
+    uint64_t rng = SEED;
+    uint64_t ms = (uint64_t)(fCpu / 1000);
+
+    avrInit(avr);
+    gpioAttach(avr);
+    extintAttach(avr);
+    timer0Attach(avr);
+    timer1Attach(avr);
+    usartAttach(avr);
+    avr->idle.disabled = mode != 2;
+    avr->trace = mode == 0 ? sink : NULL; // Tracing forces every instruction through avrStep()
+    if (avrLoadHex(avr, path) < 0) {
+        return -1;
+    }
+    // A press every 50 ms per pin, staggered, with contact bounce on both edges
+    for (unsigned i = 0; i < sizeof(buttonBits); i++) {
+        gpioSetInput(avr, 'D', buttonBits[i], 0);
+        for (uint64_t t = (20 + 7 * i) * ms; t < total; t += 50 * ms) {
+            if (stimBounce(avr, 'D', buttonBits[i], 1, t, 2 * ms, 8, STIM_UNIFORM, &rng) < 0
+                || stimBounce(avr, 'D', buttonBits[i], 0, t + 20 * ms, 2 * ms, 8, STIM_UNIFORM, &rng) < 0) {
+                return -1;
+            }
+        }
+    }
+    for (int port = 'A'; port <= 'D'; port++) {
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            gpioWatch(avr, port, bit);
+        }
+    }
+    return 0;
+}
+
+// Index of the first logged edge that differs, -1 if none (the entries carry padding, so
+// they are compared field by field)
+static int firstEdgeDiff(const struct AvrGpio* a, const struct AvrGpio* b)
+{
+    for (uint32_t i = 0; i < a->edgeCount; i++) {
+        const struct AvrPinChange* e = &a->edges[i];
+        const struct AvrPinChange* f = &b->edges[i];
+
+        if (e->cycle != f->cycle || e->port != f->port || e->bit != f->bit || e->level != f->level) {
+            return (int)i;
+        }
+    }
+    return -1;
+}
+
+// Print the first field in which 'b' differs from the reference 'a'; returns 1 if one does
+static int differs(const struct AvrCore* a, struct AvrCore* b, int mode, uint64_t limit)
+{
+    const char* what = NULL;
+    char detail[96];
+    int i;
+
+    detail[0] = '\0';
+    if (a->stopReason != b->stopReason) {
+        what = "stop reason";
+    } else if (a->cycles != b->cycles) {
+        what = "cycles";
+        snprintf(detail, sizeof(detail), " (%llu vs %llu)", (unsigned long long)a->cycles,
+                 (unsigned long long)b->cycles);
+    } else if (a->instructions != b->instructions) {
+        what = "instructions";
+        snprintf(detail, sizeof(detail), " (%llu vs %llu)", (unsigned long long)a->instructions,
+                 (unsigned long long)b->instructions);
+    } else if (a->sleepCycles != b->sleepCycles) {
+        what = "sleep cycles";
+    } else if (a->pc != b->pc || a->sleeping != b->sleeping) {
+        what = "pc";
+        snprintf(detail, sizeof(detail), " (0x%04x vs 0x%04x)", a->pc * 2, b->pc * 2);
+    } else if (memcmp(a->data, b->data, AVR_IO_BASE) != 0) {
+        what = "registers";
+    } else if (memcmp(a->data + AVR_SPL, b->data + AVR_SPL, 3) != 0) {
+        what = "SREG/SP";
+    } else if (memcmp(a->data + AVR_SRAM_START, b->data + AVR_SRAM_START,
+                      AVR_DATA_SIZE - AVR_SRAM_START) != 0) {
+        what = "SRAM";
+    } else if (memcmp(a->ioWrites, b->ioWrites, sizeof(a->ioWrites)) != 0) {
+        for (i = 0; i < AVR_IO_SIZE; i++) {
+            if (a->ioWrites[i] != b->ioWrites[i]) {
+                snprintf(detail, sizeof(detail), " (0x%02x: %llu vs %llu)", AVR_IO_BASE + i,
+                         (unsigned long long)a->ioWrites[i], (unsigned long long)b->ioWrites[i]);
+                break;
+            }
+        }
+        what = "I/O write counts";
+    } else if (a->gpio.edgeCount != b->gpio.edgeCount) {
+        what = "pin edge count";
+        snprintf(detail, sizeof(detail), " (%u vs %u)", a->gpio.edgeCount, b->gpio.edgeCount);
+    } else if ((i = firstEdgeDiff(&a->gpio, &b->gpio)) >= 0) {
+        const struct AvrPinChange* e = &a->gpio.edges[i];
+        const struct AvrPinChange* f = &b->gpio.edges[i];
+
+        what = "pin edges";
+        snprintf(detail, sizeof(detail), " (P%c%u=%u at %llu vs P%c%u=%u at %llu)", 'A' + e->port,
+                 e->bit, e->level, (unsigned long long)e->cycle, 'A' + f->port, f->bit, f->level,
+                 (unsigned long long)f->cycle);
+    } else {
+        for (int n = 0; n < 4; n++) {
+            if (gpioPins((struct AvrCore*)a, n) != gpioPins(b, n)) {
+                what = "pin levels";
+                snprintf(detail, sizeof(detail), " (port %c)", 'A' + n);
+                break;
+            }
+        }
+    }
+    if (!what) {
+        return 0;
+    }
+    printf("FAIL %s run differs from stepped at cycle limit %llu: %s%s\n", modeNames[mode],
+           (unsigned long long)limit, what, detail);
+    return 1;
+}
+
+// Run one image all three ways; returns 0 if they agree throughout
+static int checkImage(const char* path, double fCpu, double seconds, int checkpoints, FILE* sink)
+{
+    static struct AvrCore cores[MODES]; // Too large for the stack
+    uint64_t total = (uint64_t)(seconds * fCpu);
+    int failed = 0;
+
+    for (int m = 0; m < MODES; m++) {
+        if (setup(&cores[m], m, path, total, fCpu, sink) < 0) {
+            fprintf(stderr, "%s: cannot set up the %s run\n", path, modeNames[m]);
+            for (int k = 0; k <= m; k++) {
+                avrFree(&cores[k]);
+            }
+            return 1;
+        }
+    }
+    for (int c = 1; c <= checkpoints && !failed; c++) {
+        uint64_t limit = total * c / checkpoints;
+        int stop = AVR_STOP_NONE;
+
+        for (int m = 0; m < MODES; m++) {
+            stop = avrRun(&cores[m], limit);
+        }
+        for (int m = 1; m < MODES && !failed; m++) {
+            failed = differs(&cores[0], &cores[m], m, limit);
+        }
+        if (stop != AVR_STOP_CYCLES) {
+            break; // Halted, stuck asleep or illegal: all three agree on where
+        }
+    }
+    if (failed) {
+        printf("     in %s\n", path);
+    } else {
+        printf("ok   %-40s %12llu cycles %10llu instructions %6u edges\n", path,
+               (unsigned long long)cores[0].cycles, (unsigned long long)cores[0].instructions,
+               cores[0].gpio.edgeCount);
+    }
+    for (int m = 0; m < MODES; m++) {
+        avrFree(&cores[m]);
+    }
+    return failed;
+}
+
+int main(int argc, char** argv)
+{
+    double fCpu = DEFAULT_F_CPU;
+    double seconds = 0.4;
+    int checkpoints = 20;
+    int failed = 0;
+    int opt;
+    FILE* sink;
+
+    while ((opt = getopt(argc, argv, "F:s:k:")) != -1) {
+        switch (opt) {
+        case 'F': fCpu = atof(optarg); break;
+        case 's': seconds = atof(optarg); break;
+        case 'k': checkpoints = atoi(optarg); break;
+        default: usage(argv[0]);
+        }
+    }
+    if (optind >= argc || fCpu <= 0 || seconds <= 0 || checkpoints < 1) {
+        usage(argv[0]);
+    }
+    sink = fopen("/dev/null", "w");
+    if (!sink) {
+        perror("/dev/null");
+        return 1;
+    }
+
+    for (int i = optind; i < argc; i++) {
+        failed |= checkImage(argv[i], fCpu, seconds, checkpoints, sink);
+    }
+    fclose(sink);
+    return failed;
+}
@@ -0,0 +1,321 @@
+//===========================================================================================
+// Project: ATmega32A Host-Side Simulator
+// Compiler: gcc (host, C99)
+// Target microcontroller: ATmega32A (simulated)
+// Description: Machine snapshots. snapTake() copies everything that decides what the board
+//              does next: program memory, registers, SRAM and I/O space, the program counter,
+//              sleep and pending-interrupt state, the Timer0, USART, external interrupt and
+//              port models (input pins still to change included), the peripheral event times
+//              and the running counters (cycles, instructions, interrupt timing, I/O writes).
+//              snapRestore() puts it back into a core with the same peripherals attached, and
+//              the run continues cycle for cycle as if it had never stopped.
+//
+//              A snapshot in memory is never changed by a restore, so any number of cores (or
+//              threads) can fork from one: each restore copies about 3 KB of state plus the
+//              used part of flash, and instructions are predecoded again as they run. Files
+//              hold a header, the state and the flash up to its last programmed word, typically
+//              a few KB. The state is stored in host layout: a file is only read back by a
+//              build with the same layout, which the header checks.
+//
+//              Not saved: the -p profile and call stack (they restart at the restore point),
+//              trace, waveform and USART outputs, watched pins and the idle-loop probes.
+// Date created: 2026-10-16
+//===========================================================================================
+
+//============================================Libraries========================================
+#include <stdlib.h>
+#include <string.h>
+#include "avrsim.h"
+
+//============================================Defines========================================
+#define SNAP_MAGIC   "AVRSNAP1"
+#define SNAP_VERSION 1
+
+// Everything restored by value
+struct SnapState
+{
+    uint8_t data[AVR_DATA_SIZE];
+    uint16_t pc;
+    uint64_t cycles;
+    uint64_t instructions;
+    uint8_t sleeping;
+    uint8_t irqHold;
+    uint64_t sleepCycles;
+    uint64_t wakeups;
+    uint8_t pendingVector;
+    uint8_t irqCount;                     // Checked against the restoring core
+    uint8_t periphCount;
+    uint64_t periphNext[AVR_MAX_PERIPHS]; // Event times, in attach order
+    struct AvrIrqTiming irqTiming[AVR_VECTOR_COUNT];
+    struct AvrMaskTiming mask;
+    uint8_t irqEnabled;
+    uint8_t isrStack[AVR_ISR_DEPTH];
+    uint8_t isrDepth;
+    uint8_t gpioLevel[4];
+    uint8_t gpioDriven[4];
+    struct AvrTimer0 timer0;
+    struct AvrTimer1 timer1;
+    struct AvrExtInt extint;
+    struct AvrUsart usart;                // 'out' is not restored
+    uint64_t ioWrites[AVR_IO_SIZE];
+    uint64_t countHits;
+    uint64_t skips;
+    uint64_t skippedCycles;
+};
+
+// File header; the state, the pending pin changes and the flash words follow
+struct SnapHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t stateSize;   // sizeof(struct SnapState) of the writer
+    uint32_t changeCount; // Input pin changes still to be applied
+    uint32_t flashWords;  // Words of program memory stored
+};
+
+struct AvrSnapshot
+{
+    struct SnapState state;
+    uint32_t changeCount;
+    struct AvrPinChange* changes;
+    uint32_t flashWords;
+    uint16_t flash[AVR_FLASH_WORDS];
+};
+
+//============================================Functions========================================
+// Copy the state of 'avr'; NULL when out of memory
+struct AvrSnapshot* snapTake(const struct AvrCore* avr)
+{
+    struct AvrSnapshot* snap = calloc(1, sizeof(*snap));
+    struct SnapState* s;
+    const struct AvrGpio* g = &avr->gpio;
+
+    if (!snap) {
+        return NULL;
+    }
+    s = &snap->state;
+    memcpy(s->data, avr->data, sizeof(s->data));
+    s->pc = avr->pc;
+    s->cycles = avr->cycles;
+    s->instructions = avr->instructions;
+    s->sleeping = avr->sleeping;
+    s->irqHold = avr->irqHold;
+    s->sleepCycles = avr->sleepCycles;
+    s->wakeups = avr->wakeups;
+    s->pendingVector = avr->pendingVector;
+    s->irqCount = avr->irqCount;
+    s->periphCount = avr->periphCount;
+    for (int i = 0; i < avr->periphCount; i++) {
+        s->periphNext[i] = avr->periph[i].next;
+    }
+    memcpy(s->irqTiming, avr->irqTiming, sizeof(s->irqTiming));
+    s->mask = avr->mask;
+    s->irqEnabled = avr->irqEnabled;
+    memcpy(s->isrStack, avr->isrStack, sizeof(s->isrStack));
+    s->isrDepth = avr->isrDepth;
+    memcpy(s->gpioLevel, g->level, sizeof(s->gpioLevel));
+    memcpy(s->gpioDriven, g->driven, sizeof(s->gpioDriven));
+    s->timer0 = avr->timer0;
+    s->timer1 = avr->timer1;
+    s->extint = avr->extint;
+    s->usart = avr->usart;
+    s->usart.out = NULL;
+    memcpy(s->ioWrites, avr->ioWrites, sizeof(s->ioWrites));
+    s->countHits = avr->countHits;
+    s->skips = avr->idle.skips;
+    s->skippedCycles = avr->idle.skippedCycles;
+
+    snap->changeCount = g->changeCount - g->changeNext;
+    if (snap->changeCount) {
+        snap->changes = malloc(snap->changeCount * sizeof(*snap->changes));
+        if (!snap->changes) {
+            free(snap);
+            return NULL;
+        }
+        memcpy(snap->changes, &g->changes[g->changeNext], snap->changeCount * sizeof(*snap->changes));
+    }
+
+    memcpy(snap->flash, avr->flash, sizeof(snap->flash));
+    snap->flashWords = AVR_FLASH_WORDS;
+    while (snap->flashWords > 0 && snap->flash[snap->flashWords - 1] == 0xFFFF) {
+        snap->flashWords--; // Erased flash is not stored
+    }
+    return snap;
+}
+
+// Put a snapshot into 'avr', which must have the peripherals of the snapshotted core attached
+// in the same order. Scheduled input changes of 'avr' are replaced by the snapshot's.
+// Returns -1 when the peripherals do not match or memory runs out.
+int snapRestore(struct AvrCore* avr, const struct AvrSnapshot* snap)
+{
+    const struct SnapState* s = &snap->state;
+    struct AvrGpio* g = &avr->gpio;
+    FILE* out = avr->usart.out;
+
+    if (s->irqCount != avr->irqCount || s->periphCount != avr->periphCount) {
+        return -1;
+    }
+
+    memcpy(avr->flash, snap->flash, sizeof(avr->flash));
+    avrFlashChanged(avr);
+    memcpy(avr->data, s->data, sizeof(avr->data));
+    avr->pc = s->pc;
+    avr->cycles = s->cycles;
+    avr->instructions = s->instructions;
+    avr->sleeping = s->sleeping;
+    avr->irqHold = s->irqHold;
+    avr->stopReason = AVR_STOP_NONE;
+    avr->sleepCycles = s->sleepCycles;
+    avr->wakeups = s->wakeups;
+    avr->pendingVector = s->pendingVector;
+    memcpy(avr->irqTiming, s->irqTiming, sizeof(avr->irqTiming));
+    avr->mask = s->mask;
+    avr->irqEnabled = s->irqEnabled;
+    memcpy(avr->isrStack, s->isrStack, sizeof(avr->isrStack));
+    avr->isrDepth = s->isrDepth;
+    avr->depth = 0; // The profile starts over from here
+    memcpy(g->level, s->gpioLevel, sizeof(g->level));
+    memcpy(g->driven, s->gpioDriven, sizeof(g->driven));
+    avr->timer0 = s->timer0;
+    avr->timer0.version++; // Waveform replay shadows of the old state are stale
+    avr->timer1 = s->timer1;
+    avr->extint = s->extint;
+    avr->usart = s->usart;
+    avr->usart.out = out;
+    memcpy(avr->ioWrites, s->ioWrites, sizeof(avr->ioWrites));
+    avr->countHits = s->countHits;
+    avr->idle.branch = NULL;
+    avr->idle.skips = s->skips;
+    avr->idle.skippedCycles = s->skippedCycles;
+
+    g->changeCount = 0;
+    g->changeNext = 0;
+    for (uint32_t i = 0; i < snap->changeCount; i++) {
+        const struct AvrPinChange* c = &snap->changes[i];
+        if (gpioSchedule(avr, 'A' + c->port, c->bit, c->level, c->cycle) < 0) {
+            return -1;
+        }
+    }
+    for (int n = 0; n < 4; n++) {
+        g->watchLevel[n] = gpioPins(avr, n) & g->watch[n]; // Log changes from the restored levels
+    }
+    avr->nextEvent = UINT64_MAX;
+    for (int i = 0; i < avr->periphCount; i++) {
+        avr->periph[i].next = s->periphNext[i];
+        if (avr->periph[i].next < avr->nextEvent) {
+            avr->nextEvent = avr->periph[i].next;
+        }
+    }
+    return 0;
+}
+
+// Overwrite 'bytes' bytes (1..8, little-endian) of data memory in a snapshot, e.g. a 32-bit
+// millisCounter set just short of its wrap. Returns -1 outside SRAM and the registers.
+int snapPatch(struct AvrSnapshot* snap, uint16_t addr, uint64_t value, int bytes)
+{
+    if (bytes < 1 || bytes > 8 || addr + bytes > AVR_DATA_SIZE
+        || (addr < AVR_SRAM_START && addr + bytes > AVR_IO_BASE)) {
+        return -1; // I/O registers belong to the peripheral models
+    }
+    for (int i = 0; i < bytes; i++) {
+        snap->state.data[addr + i] = (value >> (8 * i)) & 0xFF;
+    }
+    return 0;
+}
+
+// Cycle at which the snapshot was taken
+uint64_t snapCycles(const struct AvrSnapshot* snap)
+{
+    return snap->state.cycles;
+}
+
+int snapSave(const struct AvrSnapshot* snap, const char* path)
+{
+    struct SnapHeader h;
+    FILE* f = fopen(path, "wb");
+    int ok;
+
+    if (!f) {
+        perror(path);
+        return -1;
+    }
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, SNAP_MAGIC, sizeof(h.magic));
+    h.version = SNAP_VERSION;
+    h.stateSize = sizeof(snap->state);
+    h.changeCount = snap->changeCount;
+    h.flashWords = snap->flashWords;
+    ok = fwrite(&h, sizeof(h), 1, f) == 1
+         && fwrite(&snap->state, sizeof(snap->state), 1, f) == 1
+         && fwrite(snap->changes, sizeof(*snap->changes), snap->changeCount, f) == snap->changeCount
+         && fwrite(snap->flash, sizeof(uint16_t), snap->flashWords, f) == snap->flashWords;
+    if (fclose(f) != 0 || !ok) {
+        fprintf(stderr, "%s: write failed\n", path);
+        return -1;
+    }
+    return 0;
+}
+
+// 1 if 'path' starts like a snapshot file
+int snapIsFile(const char* path)
+{
+    char magic[8];
+    FILE* f = fopen(path, "rb");
+    int is;
+
+    if (!f) {
+        return 0;
+    }
+    is = fread(magic, sizeof(magic), 1, f) == 1 && !memcmp(magic, SNAP_MAGIC, sizeof(magic));
+    fclose(f);
+    return is;
+}
+
+// Read a snapshot file; NULL (with a message) if it cannot be used
+struct AvrSnapshot* snapLoad(const char* path)
+{
+    struct SnapHeader h;
+    struct AvrSnapshot* snap;
+    FILE* f = fopen(path, "rb");
+    int ok;
+
+    if (!f) {
+        perror(path);
+        return NULL;
+    }
+    if (fread(&h, sizeof(h), 1, f) != 1 || memcmp(h.magic, SNAP_MAGIC, sizeof(h.magic))
+        || h.version != SNAP_VERSION || h.stateSize != sizeof(snap->state)
+        || h.flashWords > AVR_FLASH_WORDS) {
+        fprintf(stderr, "%s: not a snapshot of this simulator build\n", path);
+        fclose(f);
+        return NULL;
+    }
+    snap = calloc(1, sizeof(*snap));
+    if (!snap || (h.changeCount && !(snap->changes = malloc(h.changeCount * sizeof(*snap->changes))))) {
+        fprintf(stderr, "out of memory\n");
+        free(snap);
+        fclose(f);
+        return NULL;
+    }
+    snap->changeCount = h.changeCount;
+    snap->flashWords = h.flashWords;
+    memset(snap->flash, 0xFF, sizeof(snap->flash));
+    ok = fread(&snap->state, sizeof(snap->state), 1, f) == 1
+         && fread(snap->changes, sizeof(*snap->changes), h.changeCount, f) == h.changeCount
+         && fread(snap->flash, sizeof(uint16_t), h.flashWords, f) == h.flashWords;
+    fclose(f);
+    if (!ok) {
+        fprintf(stderr, "%s: truncated snapshot\n", path);
+        snapFree(snap);
+        return NULL;
+    }
+    return snap;
+}
+
+void snapFree(struct AvrSnapshot* snap)
+{
+    if (snap) {
+        free(snap->changes);
+        free(snap);
+    }
+}
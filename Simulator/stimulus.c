@@ -0,0 +1,203 @@
+//===========================================================================================
+// Project: ATmega32A Host-Side Simulator
+// Compiler: gcc (host, C99)
+// Target microcontroller: ATmega32A (simulated)
+// Description: Stimulus files and generators for the input pins. Everything ends up as
+//              timed changes in the port model (gpioSchedule), so a script costs nothing
+//              while the core runs. One command per line, '#' starts a comment:
+//
+//                  seed 42                               random generator seed
+//                  0.5     D6=0                          plain transition
+//                  1.2     D6=1 bounce 5ms               random burst settling high
+//                  2.0     D6=0 bounce 3ms edges=12 dist=exp
+//                  2.5     D7=1 width 20us               pulse: back to the other level after
+//
+//              Times count from the cycle the script is loaded at (0 after reset, or the
+//              snapshot a run resumes from) and, like durations, take an s, ms or us suffix
+//              (seconds without). A bounce burst starts at the given time, toggles 'edges'
+//              times (default 8) inside the duration and settles on the given level at its
+//              end. dist=uniform spreads the toggles evenly over the burst; dist=exp crowds
+//              them at the start and lets the gaps grow, like a real contact coming to rest.
+// Date created: 2026-10-16
+//===========================================================================================
+
+//============================================Libraries========================================
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "avrsim.h"
+
+//============================================Defines========================================
+#define STIM_MAX_EDGES 256
+
+//============================================Helpers========================================
+// Parse "500ms", "20us", "1.5s" or "1.5" into seconds; returns -1 on garbage
+static double parseTime(const char* text)
+{
+    char* end;
+    double value = strtod(text, &end);
+
+    if (end == text || value < 0) {
+        return -1;
+    }
+    if (!strcmp(end, "ms")) {
+        return value * 1e-3;
+    }
+    if (!strcmp(end, "us")) {
+        return value * 1e-6;
+    }
+    return (!*end || !strcmp(end, "s")) ? value : -1;
+}
+
+// Parse "D6=0" / "d6=z"; level 2 releases the pin
+static int parsePin(const char* text, char* port, uint8_t* bit, uint8_t* level)
+{
+    char p = text[0];
+
+    if (p >= 'a' && p <= 'd') {
+        p -= 'a' - 'A';
+    }
+    if (p < 'A' || p > 'D' || text[1] < '0' || text[1] > '7' || text[2] != '=' || !text[3] || text[4]) {
+        return -1;
+    }
+    *port = p;
+    *bit = text[1] - '0';
+    if (text[3] == 'z' || text[3] == 'Z') {
+        *level = 2;
+    } else if (text[3] == '0' || text[3] == '1') {
+        *level = text[3] - '0';
+    } else {
+        return -1;
+    }
+    return 0;
+}
+
+static int compareCycles(const void* a, const void* b)
+{
+    uint64_t x = *(const uint64_t*)a;
+    uint64_t y = *(const uint64_t*)b;
+    return x < y ? -1 : x > y;
+}
+
+//============================================Functions========================================
+// Uniform random number in [0, 1) (xorshift64*); the state must not be 0
+double stimRandom(uint64_t* rng)
+{
+    uint64_t x = *rng;
+
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *rng = x;
+    return ((x * 0x2545F4914F6CDD1DULL) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+// Schedule a bounce burst: 'edges' random toggles in [start, start + duration), then the
+// pin settles on 'level' at start + duration. The first toggle leaves 'level'.
+int stimBounce(struct AvrCore* avr, char port, uint8_t bit, uint8_t level, uint64_t start,
+               uint64_t duration, int edges, int dist, uint64_t* rng)
+{
+    uint64_t at[STIM_MAX_EDGES];
+
+    if (edges < 0 || edges > STIM_MAX_EDGES || level > 1) {
+        return -1;
+    }
+    for (int i = 0; i < edges; i++) {
+        double u;
+        do {
+            // Exponential offsets with a mean of a quarter burst, redrawn past its end
+            u = dist == STIM_EXP ? -log(1.0 - stimRandom(rng)) / 4 : stimRandom(rng);
+        } while (u >= 1.0);
+        at[i] = start + (uint64_t)(u * duration);
+    }
+    qsort(at, edges, sizeof(at[0]), compareCycles);
+
+    // Even toggles (0, 2, ..) leave the final level, odd ones come back to it
+    if (gpioSchedule(avr, port, bit, level, start) < 0) {
+        return -1;
+    }
+    for (int i = 0; i < edges; i++) {
+        if (gpioSchedule(avr, port, bit, (i & 1) ? level : !level, at[i]) < 0) {
+            return -1;
+        }
+    }
+    return gpioSchedule(avr, port, bit, level, start + duration);
+}
+
+// Load a stimulus file; returns -1 (after printing the offending line) on a syntax error
+int stimLoad(struct AvrCore* avr, const char* path, double fCpu)
+{
+    FILE* in = fopen(path, "r");
+    char line[256];
+    int lineNo = 0;
+    uint64_t rng = 0x9E3779B97F4A7C15ULL;
+
+    if (!in) {
+        perror(path);
+        return -1;
+    }
+    while (fgets(line, sizeof(line), in)) {
+        char* words[8];
+        int count = 0;
+        char* save;
+        char port;
+        uint8_t bit;
+        uint8_t level;
+        double at;
+        int ok = 0;
+
+        lineNo++;
+        if (strchr(line, '#')) {
+            *strchr(line, '#') = '\0';
+        }
+        for (char* w = strtok_r(line, " \t\r\n", &save); w && count < 8; w = strtok_r(NULL, " \t\r\n", &save)) {
+            words[count++] = w;
+        }
+        if (count == 0) {
+            continue;
+        }
+
+        if (!strcmp(words[0], "seed") && count == 2) {
+            rng = strtoull(words[1], NULL, 0) | 1; // xorshift needs a non-zero state
+            ok = 1;
+        } else if (count >= 2 && (at = parseTime(words[0])) >= 0
+                   && parsePin(words[1], &port, &bit, &level) == 0) {
+            uint64_t cycle = avr->cycles + (uint64_t)(at * fCpu);
+
+            if (count == 2) {
+                ok = gpioSchedule(avr, port, bit, level, cycle) == 0;
+            } else if (count >= 4 && !strcmp(words[2], "width") && level < 2) {
+                double width = parseTime(words[3]);
+                ok = count == 4 && width > 0
+                     && gpioSchedule(avr, port, bit, level, cycle) == 0
+                     && gpioSchedule(avr, port, bit, !level, cycle + (uint64_t)(width * fCpu)) == 0;
+            } else if (count >= 4 && !strcmp(words[2], "bounce") && level < 2) {
+                double duration = parseTime(words[3]);
+                int edges = 8;
+                int dist = STIM_UNIFORM;
+
+                ok = duration > 0;
+                for (int i = 4; i < count && ok; i++) {
+                    if (!strncmp(words[i], "edges=", 6)) {
+                        edges = atoi(words[i] + 6);
+                    } else if (!strcmp(words[i], "dist=uniform")) {
+                        dist = STIM_UNIFORM;
+                    } else if (!strcmp(words[i], "dist=exp")) {
+                        dist = STIM_EXP;
+                    } else {
+                        ok = 0;
+                    }
+                }
+                ok = ok && stimBounce(avr, port, bit, level, cycle, (uint64_t)(duration * fCpu),
+                                      edges, dist, &rng) == 0;
+            }
+        }
+        if (!ok) {
+            fprintf(stderr, "%s:%d: bad stimulus line\n", path, lineNo);
+            fclose(in);
+            return -1;
+        }
+    }
+    fclose(in);
+    return 0;
+}
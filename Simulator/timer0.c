@@ -0,0 +1,385 @@
+//===========================================================================================
+// Project: ATmega32A Host-Side Simulator
+// Compiler: gcc (host, C99)
+// Target microcontroller: ATmega32A (simulated)
+// Description: Cycle-exact model of Timer/Counter0 (TCCR0, TCNT0, OCR0, TIFR, TIMSK).
+//              The timer clock is taken from the prescaler shared with Timer1, which runs
+//              from reset (or from the last PSR10 write in SFIOR), so the phase of the first
+//              tick after TCCR0 is written matches the hardware. The counter is not stepped
+//              every cycle: it is brought up to date lazily when the CPU touches one of its
+//              registers, and an event is scheduled at the exact cycle of the next tick that
+//              sets OCF0 or TOV0. As on the hardware, OCF0 is set on the timer clock after the
+//              one that made TCNT0 equal to OCR0, which in CTC mode is the clock that clears
+//              the counter, so an ISR that rewrites OCR0 sets the length of the next period.
+//
+//              Modes: Normal, CTC, Fast PWM and Phase Correct PWM. The external T0 clock
+//              sources (CS0 = 6, 7) are treated as a stopped timer.
+// Date created: 2026-10-16
+//===========================================================================================
+
+//============================================Libraries========================================
+#include "avrsim.h"
+
+//============================================Defines========================================
+// Data-space register addresses
+#define T0_TCNT0 0x52
+#define T0_TCCR0 0x53
+#define T0_OCR0  0x5C
+#define T0_TIFR  0x58
+#define T0_TIMSK 0x59
+#define T0_SFIOR 0x50
+
+// TCCR0 bits
+#define T0_FOC0  7
+#define T0_WGM00 6
+#define T0_WGM01 3
+
+// TIFR / TIMSK bits
+#define T0_OCF0 1
+#define T0_TOV0 0
+
+// Waveform generation modes (WGM01:WGM00)
+#define MODE_NORMAL 0
+#define MODE_PWM_PC 1
+#define MODE_CTC    2
+#define MODE_FAST   3
+
+#define VECTOR_COMP 10
+#define VECTOR_OVF  11
+
+static const uint16_t prescalers[8] = { 0, 1, 8, 64, 256, 1024, 0, 0 };
+
+//============================================Helpers========================================
+static uint8_t mode(const struct AvrCore* avr)
+{
+    uint8_t tccr = avr->data[T0_TCCR0];
+    return (((tccr >> T0_WGM01) & 1) << 1) | ((tccr >> T0_WGM00) & 1);
+}
+
+static uint16_t divider(const struct AvrCore* avr)
+{
+    return prescalers[avr->data[T0_TCCR0] & 7];
+}
+
+// TOP of the current up-counting lap
+static uint8_t top(const struct AvrCore* avr)
+{
+    const struct AvrTimer0* t = &avr->timer0;
+    if (mode(avr) == MODE_CTC && t->tcnt <= t->ocr) {
+        return t->ocr;
+    }
+    return 0xFF; // Normal/Fast PWM, or a CTC counter that already passed OCR0
+}
+
+// Ticks until the next tick that wraps, turns, or leaves OCR0 (always >= 1)
+static uint32_t ticksToEdge(const struct AvrCore* avr)
+{
+    const struct AvrTimer0* t = &avr->timer0;
+    uint32_t n;
+
+    if (mode(avr) == MODE_PWM_PC) {
+        if (!t->countDown) {
+            n = t->tcnt == 0xFF ? 1 : 0xFF - t->tcnt;
+            if (t->ocr >= t->tcnt && (uint32_t)(t->ocr - t->tcnt) + 1 < n) {
+                n = t->ocr - t->tcnt + 1;
+            }
+        } else {
+            n = t->tcnt == 0 ? 1 : t->tcnt;
+            if (t->ocr <= t->tcnt && (uint32_t)(t->tcnt - t->ocr) + 1 < n) {
+                n = t->tcnt - t->ocr + 1;
+            }
+        }
+        return n;
+    }
+
+    n = (uint32_t)top(avr) - t->tcnt + 1;
+    if (t->ocr >= t->tcnt && (uint32_t)(t->ocr - t->tcnt) + 1 < n) {
+        n = t->ocr - t->tcnt + 1;
+    }
+    return n;
+}
+
+// Apply one timer clock and return the TIFR bits it sets
+static uint8_t tickOnce(struct AvrCore* avr)
+{
+    struct AvrTimer0* t = &avr->timer0;
+    uint8_t m = mode(avr);
+    uint8_t flags = 0;
+
+    // The comparator saw TCNT0 == OCR0 during the clock that ends now
+    if (t->tcnt == t->ocr && !t->blockMatch) {
+        flags |= 1 << T0_OCF0;
+    }
+    t->blockMatch = 0;
+
+    if (m == MODE_PWM_PC) {
+        if (!t->countDown) {
+            if (t->tcnt == 0xFF) {
+                t->countDown = 1;
+                t->tcnt--;
+            } else {
+                t->tcnt++;
+            }
+            if (t->tcnt == 0xFF) {
+                t->ocr = t->ocrBuffer; // OCR0 is updated at TOP
+            }
+        } else {
+            if (t->tcnt == 0) {
+                t->countDown = 0;
+                t->tcnt++;
+            } else {
+                t->tcnt--;
+            }
+            if (t->tcnt == 0) {
+                flags |= 1 << T0_TOV0; // TOV0 at BOTTOM
+            }
+        }
+    } else {
+        if (t->tcnt == top(avr)) {
+            if (t->tcnt == 0xFF) {
+                flags |= 1 << T0_TOV0; // TOV0 at MAX
+            }
+            t->tcnt = 0;
+            if (m == MODE_FAST) {
+                t->ocr = t->ocrBuffer; // OCR0 is updated at TOP
+            }
+        } else {
+            t->tcnt++;
+        }
+    }
+    return flags;
+}
+
+// Advance the counter by 'ticks' timer clocks and return the TIFR bits set on the way.
+// Runs of ticks that cannot wrap or match are applied in one step.
+static uint8_t advance(struct AvrCore* avr, uint64_t ticks)
+{
+    struct AvrTimer0* t = &avr->timer0;
+    uint8_t flags = 0;
+
+    while (ticks > 0) {
+        uint32_t n = ticksToEdge(avr);
+        if (ticks < n) {
+            t->tcnt = t->countDown ? t->tcnt - (uint8_t)ticks : t->tcnt + (uint8_t)ticks;
+            t->blockMatch = 0;
+            return flags;
+        }
+        t->tcnt = t->countDown ? t->tcnt - (uint8_t)(n - 1) : t->tcnt + (uint8_t)(n - 1);
+        if (n > 1) {
+            t->blockMatch = 0;
+        }
+        flags |= tickOnce(avr);
+        ticks -= n;
+    }
+    return flags;
+}
+
+// Number of prescaled timer ticks in the cycle interval (from, to]
+static uint64_t ticksBetween(const struct AvrCore* avr, uint64_t from, uint64_t to)
+{
+    uint16_t div = divider(avr);
+    uint64_t base = avr->timer0.psrBase;
+
+    if (div == 0 || to <= from) {
+        return 0;
+    }
+    return (to - base) / div - (from - base) / div;
+}
+
+// Set the flags produced by a tick and record when they were raised
+static void raise(struct AvrCore* avr, uint8_t flags, uint64_t cycle)
+{
+    if (!flags) {
+        return;
+    }
+    avr->data[T0_TIFR] |= flags;
+    if (flags & (1 << T0_OCF0)) {
+        avr->timer0.matches++;
+        avrIrqRaised(avr, VECTOR_COMP, cycle);
+    }
+    if (flags & (1 << T0_TOV0)) {
+        avr->timer0.overflows++;
+        avrIrqRaised(avr, VECTOR_OVF, cycle);
+    }
+    avrUpdateIrq(avr);
+}
+
+// Bring the counter up to date with cycle 'now'
+static void sync(struct AvrCore* avr, uint64_t now)
+{
+    struct AvrTimer0* t = &avr->timer0;
+
+    if (now <= t->lastSync) {
+        return;
+    }
+    uint8_t flags = advance(avr, ticksBetween(avr, t->lastSync, now));
+    t->lastSync = now;
+    raise(avr, flags, now);
+}
+
+// Absolute cycle of the next tick that sets a flag, UINT64_MAX when stopped
+static uint64_t nextFlagCycle(struct AvrCore* avr)
+{
+    struct AvrTimer0 saved = avr->timer0;
+    uint16_t div = divider(avr);
+    uint64_t ticks = 0;
+
+    if (div == 0) {
+        return UINT64_MAX;
+    }
+    // A flag is set at the latest on the second edge (wrap, then match); probe a few to be safe
+    for (int i = 0; i < 4; i++) {
+        uint32_t n = ticksToEdge(avr);
+        ticks += n;
+        if (advance(avr, n)) {
+            break;
+        }
+    }
+    avr->timer0 = saved;
+
+    // Cycle of the ticks-th tick after lastSync
+    uint64_t phase = (saved.lastSync - saved.psrBase) % div;
+    return saved.lastSync + (div - phase) + (ticks - 1) * div;
+}
+
+static void reschedule(struct AvrCore* avr)
+{
+    avrReschedule(avr, &avr->timer0, nextFlagCycle(avr));
+}
+
+//============================================Register hooks========================================
+static uint8_t readReg(struct AvrCore* avr, uint16_t addr, void* ctx)
+{
+    struct AvrTimer0* t = ctx;
+
+    switch (addr) {
+    case T0_TCNT0:
+        sync(avr, avr->cycles);
+        return t->tcnt;
+    case T0_OCR0:
+        return t->ocrBuffer;
+    default:
+        return avr->data[addr];
+    }
+}
+
+static void writeReg(struct AvrCore* avr, uint16_t addr, uint8_t value, void* ctx)
+{
+    struct AvrTimer0* t = ctx;
+
+    sync(avr, avr->cycles);
+    t->version++;
+    switch (addr) {
+    case T0_TCCR0:
+        avr->data[addr] = value & ~(1 << T0_FOC0); // FOC0 is a strobe and reads as zero
+        if (mode(avr) == MODE_NORMAL || mode(avr) == MODE_CTC) {
+            t->ocr = t->ocrBuffer;
+        }
+        if (mode(avr) != MODE_PWM_PC) {
+            t->countDown = 0;
+        }
+        break;
+    case T0_TCNT0:
+        t->tcnt = value;
+        t->blockMatch = 1;
+        break;
+    case T0_OCR0:
+        t->ocrBuffer = value;
+        if (mode(avr) == MODE_NORMAL || mode(avr) == MODE_CTC) {
+            t->ocr = value; // Only the PWM modes double buffer OCR0
+        }
+        break;
+    case T0_TIFR:
+        avr->data[addr] &= ~value; // Flags are cleared by writing a logic one
+        break;
+    case T0_SFIOR:
+        if (value & 1) { // PSR10 resets the Timer1/Timer0 prescaler
+            timer1Sync(avr, avr->cycles); // Timer1's ticks so far still use the old phase
+            t->psrBase = avr->cycles;
+        }
+        avr->data[addr] = value & ~1;
+        break;
+    }
+    reschedule(avr);
+}
+
+// Event: the tick that sets a flag has been reached
+static uint64_t onEvent(struct AvrCore* avr, void* ctx)
+{
+    struct AvrTimer0* t = ctx;
+    uint64_t due = nextFlagCycle(avr);
+
+    sync(avr, due);
+    (void)t;
+    return nextFlagCycle(avr);
+}
+
+//============================================Functions========================================
+// Install the Timer0 model on a core
+void timer0Attach(struct AvrCore* avr)
+{
+    static const struct AvrIrqSource comp = { VECTOR_COMP, T0_TIFR, 1 << T0_OCF0, T0_TIMSK, 1 << T0_OCF0, 1 };
+    static const struct AvrIrqSource ovf = { VECTOR_OVF, T0_TIFR, 1 << T0_TOV0, T0_TIMSK, 1 << T0_TOV0, 1 };
+    struct AvrTimer0* t = &avr->timer0;
+
+    t->tcnt = 0;
+    t->ocr = 0;
+    t->ocrBuffer = 0;
+    t->countDown = 0;
+    t->blockMatch = 0;
+    t->lastSync = avr->cycles;
+    t->psrBase = avr->cycles;
+    t->matches = 0;
+    t->overflows = 0;
+    t->version++;
+
+    avrSetIoHook(avr, T0_TCCR0, readReg, writeReg, t);
+    avrSetIoHook(avr, T0_TCNT0, readReg, writeReg, t);
+    avr->ioClocked[T0_TCNT0 - AVR_IO_BASE] = 1; // Counts between events: no idle skip over a read
+    avrSetIoHook(avr, T0_OCR0, readReg, writeReg, t);
+    avrSetIoHook(avr, T0_TIFR, readReg, writeReg, t);
+    avrSetIoHook(avr, T0_SFIOR, readReg, writeReg, t);
+    avrAddIrq(avr, &comp);
+    avrAddIrq(avr, &ovf);
+    avrAddPeriph(avr, onEvent, t, UINT64_MAX);
+}
+
+// Cycles between two compare matches in CTC mode (0 when the timer is not in CTC)
+uint32_t timer0Period(struct AvrCore* avr)
+{
+    if (mode(avr) != MODE_CTC || divider(avr) == 0) {
+        return 0;
+    }
+    return (uint32_t)(avr->timer0.ocr + 1) * divider(avr);
+}
+
+// Step a private copy of the counter up to cycle 'to' and report every tick, for waveform
+// output. The model itself is not touched, so its lazy evaluation and flag timing stay the
+// same. The copy restarts from the model whenever the CPU wrote a Timer0 register.
+void timer0Replay(struct AvrCore* avr, struct AvrTimer0Shadow* shadow, uint64_t to,
+                  AvrCountHook emit, void* ctx)
+{
+    struct AvrTimer0 saved = avr->timer0;
+    uint16_t div = divider(avr);
+
+    if (!shadow->valid || shadow->version != saved.version) {
+        shadow->state = saved;
+        shadow->version = saved.version;
+        shadow->valid = 1;
+        emit(ctx, saved.lastSync, saved.tcnt);
+    }
+    if (div && to > shadow->state.lastSync) {
+        struct AvrTimer0* t = &avr->timer0;
+        uint64_t phase = (shadow->state.lastSync - shadow->state.psrBase) % div;
+        uint64_t cycle = shadow->state.lastSync + (div - phase);
+
+        *t = shadow->state; // tickOnce() works on avr->timer0, as in nextFlagCycle()
+        for (; cycle <= to; cycle += div) {
+            tickOnce(avr);
+            emit(ctx, cycle, t->tcnt);
+        }
+        shadow->state = *t;
+        avr->timer0 = saved;
+    }
+    shadow->state.lastSync = to;
+}
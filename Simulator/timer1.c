@@ -0,0 +1,94 @@
+//===========================================================================================
+// Project: ATmega32A Host-Side Simulator
+// Compiler: gcc (host, C99)
+// Target microcontroller: ATmega32A (simulated)
+// Description: Timer/Counter1 as a free-running 16-bit counter (TCCR1B clock select, TCNT1H,
+//              TCNT1L), as Library/irqstats.h uses it for a time reference. It counts on the
+//              prescaler it shares with Timer0, whose phase (reset and PSR10) timer0.c keeps,
+//              and like Timer0 it is brought up to date lazily when the CPU touches it.
+//
+//              16-bit access goes through the TEMP byte as on the hardware: reading TCNT1L
+//              latches the high byte into TEMP, which a following TCNT1H read returns, and a
+//              TCNT1H write only lands in TEMP until TCNT1L is written. The modes, compare
+//              units, input capture and interrupts of Timer1 are not modelled.
+// Date created: 2026-10-16
+//===========================================================================================
+
+//============================================Libraries========================================
+#include "avrsim.h"
+
+//============================================Defines========================================
+// Data-space register addresses
+#define T1_TCNT1L 0x4C
+#define T1_TCNT1H 0x4D
+#define T1_TCCR1B 0x4E
+
+static const uint16_t prescalers[8] = { 0, 1, 8, 64, 256, 1024, 0, 0 };
+
+//============================================Register hooks========================================
+static uint8_t readReg(struct AvrCore* avr, uint16_t addr, void* ctx)
+{
+    struct AvrTimer1* t = ctx;
+
+    switch (addr) {
+    case T1_TCNT1L: // Reading the low byte latches the high byte into TEMP
+        timer1Sync(avr, avr->cycles);
+        t->temp = (uint8_t)(t->tcnt >> 8);
+        return (uint8_t)t->tcnt;
+    case T1_TCNT1H:
+        return t->temp;
+    default:
+        return avr->data[addr];
+    }
+}
+
+static void writeReg(struct AvrCore* avr, uint16_t addr, uint8_t value, void* ctx)
+{
+    struct AvrTimer1* t = ctx;
+
+    timer1Sync(avr, avr->cycles);
+    switch (addr) {
+    case T1_TCNT1H: // Written to TEMP, stored with the low byte
+        t->temp = value;
+        break;
+    case T1_TCNT1L:
+        t->tcnt = (uint16_t)((t->temp << 8) | value);
+        break;
+    case T1_TCCR1B:
+        avr->data[addr] = value;
+        break;
+    }
+}
+
+//============================================Functions========================================
+// Bring the counter up to date with cycle 'now'. timer0.c calls it before the shared
+// prescaler is reset, so the ticks up to then are counted with the old phase.
+void timer1Sync(struct AvrCore* avr, uint64_t now)
+{
+    struct AvrTimer1* t = &avr->timer1;
+    uint16_t div = prescalers[avr->data[T1_TCCR1B] & 7];
+    uint64_t base = avr->timer0.psrBase;
+
+    if (now <= t->lastSync) {
+        return;
+    }
+    if (div) {
+        t->tcnt += (uint16_t)((now - base) / div - (t->lastSync - base) / div);
+    }
+    t->lastSync = now;
+}
+
+// Install the Timer1 model on a core
+void timer1Attach(struct AvrCore* avr)
+{
+    struct AvrTimer1* t = &avr->timer1;
+
+    t->tcnt = 0;
+    t->temp = 0;
+    t->lastSync = avr->cycles;
+
+    avrSetIoHook(avr, T1_TCNT1L, readReg, writeReg, t);
+    avrSetIoHook(avr, T1_TCNT1H, readReg, writeReg, t);
+    avrSetIoHook(avr, T1_TCCR1B, readReg, writeReg, t);
+    avr->ioClocked[T1_TCNT1L - AVR_IO_BASE] = 1; // Counts between events: no idle skip over a read
+}
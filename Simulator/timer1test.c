@@ -0,0 +1,110 @@
+//===========================================================================================
+// Project: ATmega32A Host-Side Simulator
+// Compiler: gcc (host, C99)
+// Target microcontroller: ATmega32A (simulated)
+// Description: Checks the Timer1 model (timer1.c) on its own, through the same data-space
+//              accesses the CPU makes: counting on each prescaler tap, the TEMP byte of 16-bit
+//              reads and writes, and the shared prescaler reset (PSR10 in SFIOR). The core's
+//              cycle counter is set directly between accesses, no code runs.
+// Usage:   ./timer1test   (make check); exit status 1 on any mismatch
+// Date created: 2026-10-16
+//===========================================================================================
+
+//============================================Libraries========================================
+#include <stdio.h>
+#include "avrsim.h"
+
+//============================================Defines========================================
+#define TCNT1L 0x4C
+#define TCNT1H 0x4D
+#define TCCR1B 0x4E
+#define SFIOR  0x50
+
+static int failures;
+
+//============================================Functions========================================
+static void expect(const char* what, unsigned got, unsigned want)
+{
+    if (got != want) {
+        printf("FAIL %s: got 0x%04x, expected 0x%04x\n", what, got, want);
+        failures++;
+    }
+}
+
+// 16-bit read as the compiler emits it: low byte first
+static uint16_t readTcnt1(struct AvrCore* avr)
+{
+    uint8_t low = avrReadData(avr, TCNT1L);
+    return (uint16_t)((avrReadData(avr, TCNT1H) << 8) | low);
+}
+
+// 16-bit write as the compiler emits it: high byte first
+static void writeTcnt1(struct AvrCore* avr, uint16_t value)
+{
+    avrWriteData(avr, TCNT1H, (uint8_t)(value >> 8));
+    avrWriteData(avr, TCNT1L, (uint8_t)value);
+}
+
+int main(void)
+{
+    static struct AvrCore avr;
+
+    avrInit(&avr);
+    timer0Attach(&avr);
+    timer1Attach(&avr);
+
+    // Stopped until a clock is selected
+    avr.cycles = 1000;
+    expect("stopped", readTcnt1(&avr), 0);
+
+    // CPU clock: one count per cycle from the write on
+    avrWriteData(&avr, TCCR1B, 1);
+    writeTcnt1(&avr, 0x12F0);
+    avr.cycles += 15;
+    expect("clk/1", readTcnt1(&avr), 0x12FF);
+
+    // TEMP: the high byte is latched by the low byte read, even if the counter carries before
+    // the high byte is read
+    avr.cycles += 0x10;
+    expect("low byte", avrReadData(&avr, TCNT1L), 0x0F);
+    avr.cycles += 0x100;
+    expect("latched high byte", avrReadData(&avr, TCNT1H), 0x13);
+    expect("after the carry", readTcnt1(&avr), 0x140F);
+
+    // TEMP: a high byte write alone does not reach the counter, the low byte write stores both
+    avrWriteData(&avr, TCNT1H, 0xAB);
+    expect("high byte write alone", readTcnt1(&avr), 0x140F);
+    avrWriteData(&avr, TCNT1H, 0xAB);
+    avrWriteData(&avr, TCNT1L, 0xCD);
+    expect("high then low write", readTcnt1(&avr), 0xABCD);
+
+    // clk/64 counts on the prescaler phase, which runs from reset
+    avrWriteData(&avr, TCCR1B, 3);
+    writeTcnt1(&avr, 0);
+    avr.cycles = 64 * 100 + 63;
+    expect("clk/64 before a tap", readTcnt1(&avr), 100 - (1000 + 15 + 0x10 + 0x100) / 64);
+    avr.cycles++;
+    expect("clk/64 on a tap", readTcnt1(&avr), 101 - (1000 + 15 + 0x10 + 0x100) / 64);
+
+    // PSR10 restarts the prescaler: the next count comes a whole period after the write
+    avr.cycles += 10;
+    writeTcnt1(&avr, 0);
+    avrWriteData(&avr, SFIOR, 1);
+    avr.cycles += 63;
+    expect("clk/64 after PSR10", readTcnt1(&avr), 0);
+    avr.cycles++;
+    expect("first tap after PSR10", readTcnt1(&avr), 1);
+
+    // Wraps at 16 bits
+    avrWriteData(&avr, TCCR1B, 1);
+    writeTcnt1(&avr, 0xFFFE);
+    avr.cycles += 3;
+    expect("wrap", readTcnt1(&avr), 0x0001);
+
+    if (failures) {
+        printf("%d Timer1 checks failed\n", failures);
+        return 1;
+    }
+    printf("ok   timer1\n");
+    return 0;
+}
@@ -0,0 +1,79 @@
+//===========================================================================================
+// Project: ATmega32A Host-Side Simulator
+// Compiler: gcc (host, C99)
+// Target microcontroller: ATmega32A (decodes its trace.h output)
+// Description: Decoder for the binary trace records of Library/trace.h. Reads the byte
+//              stream captured from the USART (avrsim -u, or a serial port dump) and prints
+//              one line per record: absolute time, delta to the previous record, event name
+//              and argument. Times are relative to 0 until the first TRACE_SYNC record, which
+//              sets the absolute clock.
+// Usage:   ./tracedump [file]   (standard input when no file is given)
+// Date created: 2026-10-16
+//===========================================================================================
+
+//============================================Libraries========================================
+#include <stdint.h>
+#include <stdio.h>
+#include "../Library/traceformat.h"
+
+//============================================Global Variables========================================
+#define TRACE_NAME(id, name) [id] = #name,
+static const char* const eventNames[TRACE_ID_MASK + 1] = { TRACE_EVENTS(TRACE_NAME) };
+#undef TRACE_NAME
+
+//============================================Functions========================================
+// Read a little-endian field of 'code' size; returns -1 at end of input
+static int readField(FILE* in, uint8_t code, uint32_t* value)
+{
+    *value = 0;
+    for (int i = 0; i < TRACE_SIZE(code); i++) {
+        int c = fgetc(in);
+        if (c == EOF) {
+            return -1;
+        }
+        *value |= (uint32_t)c << (8 * i);
+    }
+    return 0;
+}
+
+int main(int argc, char** argv)
+{
+    FILE* in = stdin;
+    uint32_t now = 0;
+    unsigned long records = 0;
+    int header;
+
+    if (argc > 2) {
+        fprintf(stderr, "usage: %s [file]\n", argv[0]);
+        return 2;
+    }
+    if (argc == 2 && !(in = fopen(argv[1], "rb"))) {
+        perror(argv[1]);
+        return 1;
+    }
+
+    while ((header = fgetc(in)) != EOF) {
+        uint8_t id = header & TRACE_ID_MASK;
+        uint32_t delta;
+        uint32_t arg;
+
+        if (readField(in, (header >> TRACE_DELTA_SHIFT) & 3, &delta) < 0
+            || readField(in, (header >> TRACE_ARG_SHIFT) & 3, &arg) < 0) {
+            fprintf(stderr, "truncated record after %lu records\n", records);
+            return 1;
+        }
+        now = id == TRACE_SYNC ? arg : now + delta;
+        records++;
+
+        printf("%10lu ms  +%-6lu ", (unsigned long)now, (unsigned long)delta);
+        if (id == TRACE_LAT_BIN) {
+            printf("%-8s %lu.. cycles: %lu\n", eventNames[id], (unsigned long)(arg >> 16),
+                   (unsigned long)(arg & 0xFFFF));
+        } else if (eventNames[id]) {
+            printf("%-8s %lu\n", eventNames[id], (unsigned long)arg);
+        } else {
+            printf("event%-3u %lu\n", id, (unsigned long)arg);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,184 @@
+//===========================================================================================
+// Project: ATmega32A Host-Side Simulator
+// Compiler: gcc (host, C99)
+// Target microcontroller: ATmega32A (simulated)
+// Description: USART transmitter model (UDR, UCSRA, UCSRB, UCSRC/UBRRH, UBRRL). A byte written
+//              to UDR goes straight to the shift register when the line is idle, otherwise it
+//              waits in the one-byte transmit buffer with UDRE cleared, exactly like the
+//              hardware double buffer. Each frame lasts start + data + parity + stop bits at
+//              (U2X ? 8 : 16) * (UBRR + 1) cycles per bit; at its end the byte is written to
+//              usart.out, the buffered byte (if any) starts and UDRE is set again, or TXC is
+//              set when nothing is left. Writes to UDR while UDRE is clear are ignored.
+//
+//              The receiver is not modelled: RXC never sets and UDR reads as 0.
+// Date created: 2026-10-16
+//===========================================================================================
+
+//============================================Libraries========================================
+#include <string.h>
+#include "avrsim.h"
+
+//============================================Defines========================================
+// Data-space register addresses
+#define US_UBRRL 0x29
+#define US_UCSRB 0x2A
+#define US_UCSRA 0x2B
+#define US_UDR   0x2C
+#define US_UCSRC 0x40 // Shared with UBRRH, URSEL (bit 7) selects UCSRC on write
+
+// UCSRA bits
+#define US_RXC  7
+#define US_TXC  6
+#define US_UDRE 5
+#define US_U2X  1
+#define US_MPCM 0
+
+// UCSRB bits
+#define US_RXCIE 7
+#define US_TXCIE 6
+#define US_UDRIE 5
+#define US_TXEN  3
+#define US_UCSZ2 2
+
+// UCSRC bits
+#define US_URSEL 7
+#define US_UPM1  5
+#define US_USBS  3
+
+#define VECTOR_RXC  13
+#define VECTOR_UDRE 14
+#define VECTOR_TXC  15
+
+//============================================Helpers========================================
+// Cycles of one frame with the current format and baud rate
+uint32_t usartFrameCycles(const struct AvrCore* avr)
+{
+    const struct AvrUsart* u = &avr->usart;
+    uint32_t ubrr = ((uint32_t)(u->ubrrh & 0x0F) << 8) | avr->data[US_UBRRL];
+    uint32_t bitCycles = ((avr->data[US_UCSRA] >> US_U2X) & 1 ? 8 : 16) * (ubrr + 1);
+    uint32_t bits = 1 + 5 + ((u->ucsrc >> 1) & 3);     // Start bit + UCSZ1:0 data bits
+
+    if (avr->data[US_UCSRB] & (1 << US_UCSZ2)) {
+        bits = 1 + 9;                                  // UCSZ = 7: 9 data bits
+    }
+    bits += (u->ucsrc >> US_UPM1) & 1;                 // Parity bit
+    bits += (u->ucsrc >> US_USBS) & 1 ? 2 : 1;         // Stop bits
+    return bits * bitCycles;
+}
+
+static void setFlag(struct AvrCore* avr, uint8_t bit, uint8_t vector)
+{
+    avr->data[US_UCSRA] |= 1 << bit;
+    avrIrqRaised(avr, vector, avr->cycles);
+    avrUpdateIrq(avr);
+}
+
+// Put a byte into the shift register
+static void startFrame(struct AvrCore* avr, uint8_t value)
+{
+    struct AvrUsart* u = &avr->usart;
+
+    u->shifter = value;
+    u->busy = 1;
+    u->txDone = avr->cycles + usartFrameCycles(avr);
+    avrReschedule(avr, u, u->txDone);
+}
+
+//============================================Register hooks========================================
+static uint8_t readReg(struct AvrCore* avr, uint16_t addr, void* ctx)
+{
+    struct AvrUsart* u = ctx;
+
+    switch (addr) {
+    case US_UDR:
+        return 0; // No receiver
+    case US_UCSRC:
+        return u->ubrrh;
+    default:
+        return avr->data[addr];
+    }
+}
+
+static void writeReg(struct AvrCore* avr, uint16_t addr, uint8_t value, void* ctx)
+{
+    struct AvrUsart* u = ctx;
+
+    switch (addr) {
+    case US_UDR:
+        if (!(avr->data[US_UCSRB] & (1 << US_TXEN)) || !(avr->data[US_UCSRA] & (1 << US_UDRE))) {
+            break; // Transmitter off, or buffer full: the write is ignored
+        }
+        if (!u->busy) {
+            startFrame(avr, value);
+        } else {
+            u->buffer = value;
+            u->bufferFull = 1;
+            avr->data[US_UCSRA] &= ~(1 << US_UDRE);
+            avrUpdateIrq(avr); // UDR is not a flag register, the core does not recheck
+        }
+        break;
+    case US_UCSRA:
+        avr->data[addr] &= ~(value & (1 << US_TXC));          // TXC is cleared by writing one
+        avr->data[addr] = (avr->data[addr] & ~((1 << US_U2X) | (1 << US_MPCM)))
+                          | (value & ((1 << US_U2X) | (1 << US_MPCM)));
+        break;
+    case US_UCSRC:
+        if (value & (1 << US_URSEL)) {
+            u->ucsrc = value;
+        } else {
+            u->ubrrh = value;
+        }
+        break;
+    default:
+        avr->data[addr] = value;
+        break;
+    }
+}
+
+// Event: the frame in the shift register has left the pin
+static uint64_t onEvent(struct AvrCore* avr, void* ctx)
+{
+    struct AvrUsart* u = ctx;
+
+    if (!u->busy) {
+        return UINT64_MAX;
+    }
+    u->busy = 0;
+    u->txBytes++;
+    if (u->out) {
+        fputc(u->shifter, u->out);
+    }
+    if (u->bufferFull) {
+        u->bufferFull = 0;
+        startFrame(avr, u->buffer);
+        setFlag(avr, US_UDRE, VECTOR_UDRE);
+        return u->txDone;
+    }
+    setFlag(avr, US_TXC, VECTOR_TXC);
+    return UINT64_MAX;
+}
+
+//============================================Functions========================================
+// Install the USART model on a core
+void usartAttach(struct AvrCore* avr)
+{
+    static const struct AvrIrqSource rxc = { VECTOR_RXC, US_UCSRA, 1 << US_RXC, US_UCSRB, 1 << US_RXCIE, 0 };
+    static const struct AvrIrqSource udre = { VECTOR_UDRE, US_UCSRA, 1 << US_UDRE, US_UCSRB, 1 << US_UDRIE, 0 };
+    static const struct AvrIrqSource txc = { VECTOR_TXC, US_UCSRA, 1 << US_TXC, US_UCSRB, 1 << US_TXCIE, 1 };
+    struct AvrUsart* u = &avr->usart;
+    FILE* out = u->out;
+
+    memset(u, 0, sizeof(*u));
+    u->out = out;
+    u->ucsrc = 0x86; // Reset value: 8N1, asynchronous
+    avr->data[US_UCSRA] = 1 << US_UDRE;
+
+    avrSetIoHook(avr, US_UDR, readReg, writeReg, u);
+    avrSetIoHook(avr, US_UCSRA, readReg, writeReg, u);
+    avrSetIoHook(avr, US_UCSRB, readReg, writeReg, u);
+    avrSetIoHook(avr, US_UCSRC, readReg, writeReg, u);
+    avrAddIrq(avr, &rxc);
+    avrAddIrq(avr, &udre);
+    avrAddIrq(avr, &txc);
+    avrAddPeriph(avr, onEvent, u, UINT64_MAX);
+}
@@ -0,0 +1,299 @@
+//===========================================================================================
+// Project: ATmega32A Host-Side Simulator
+// Compiler: gcc (host, C99)
+// Target microcontroller: ATmega32A (simulated)
+// Description: Value Change Dump (IEEE 1364) waveform output, for GTKWave and similar viewers.
+//              The core calls vcdSample() before every instruction, interrupt response and
+//              sleep jump; each selected signal is compared with its last value and only
+//              changes are written, so the file stays small and a disabled dump costs one
+//              pointer test per step. Times are written in picoseconds from the cycle count.
+//
+//              Signals (comma separated, -V):
+//                PD6        one pin, as read from PINx        PORTB PINB DDRB   8-bit port
+//                TCNT0      Timer0 counter, replayed so every tick shows, even in sleep
+//                TIFR.1     one bit of an I/O register          TIFR  0x58       8-bit register
+//                irq        vector being serviced (0 = main)   I  sleep  pc
+//              I/O registers can be named (TIFR, GIFR, UCSRA, ...) or given as an address.
+// Date created: 2026-10-16
+//===========================================================================================
+
+//============================================Libraries========================================
+#include <stdlib.h>
+#include <string.h>
+#include "avrsim.h"
+
+//============================================Defines========================================
+#define VCD_MAX_SIGNALS 64
+#define VCD_DEFAULT "PINA,PINB,PINC,PIND,TCNT0,TIFR,irq,I,sleep"
+
+enum
+{
+    SIG_PIN,    // One bit of a port's pin levels
+    SIG_PINS,   // Pin levels of a whole port
+    SIG_REG,    // Raw I/O register (PORTx, DDRx, TIFR, ...), optionally one bit
+    SIG_TCNT0,  // Timer0 counter
+    SIG_IRQ,    // Innermost vector being serviced
+    SIG_I,      // Global interrupt enable
+    SIG_SLEEP,  // Core asleep
+    SIG_PC      // Program counter (byte address)
+};
+
+struct VcdSignal
+{
+    uint8_t kind;
+    uint8_t width;     // Bits in the dump
+    uint16_t addr;     // Register address, or port index for SIG_PIN(S)
+    int8_t bit;        // Bit of the register or port, -1 for the whole byte
+    char id[4];        // VCD identifier code
+    char name[16];
+    uint32_t last;     // Value written last
+};
+
+struct AvrVcd
+{
+    FILE* out;
+    double psPerCycle;
+    uint64_t time;     // Cycle of the last #time line
+    int signalCount;
+    struct VcdSignal signals[VCD_MAX_SIGNALS];
+    struct VcdSignal* tcnt0;  // The TCNT0 signal, NULL if not selected
+    struct AvrTimer0Shadow shadow;
+};
+
+// I/O registers that can be selected by name
+static const struct
+{
+    const char* name;
+    uint16_t addr;
+} registers[] = {
+    { "SREG", 0x5F }, { "GICR", 0x5B }, { "GIFR", 0x5A }, { "TIMSK", 0x59 }, { "TIFR", 0x58 },
+    { "MCUCR", 0x55 }, { "MCUCSR", 0x54 }, { "TCCR0", 0x53 }, { "OCR0", 0x5C },
+    { "UDR", 0x2C }, { "UCSRA", 0x2B }, { "UCSRB", 0x2A },
+    { "PORTA", 0x3B }, { "DDRA", 0x3A }, { "PORTB", 0x38 }, { "DDRB", 0x37 },
+    { "PORTC", 0x35 }, { "DDRC", 0x34 }, { "PORTD", 0x32 }, { "DDRD", 0x31 },
+};
+
+//============================================Helpers========================================
+// Parse one signal name into 's'; returns -1 if it is unknown
+static int parseSignal(struct VcdSignal* s, const char* text)
+{
+    char name[16];
+    const char* dot = strchr(text, '.');
+    size_t len = dot ? (size_t)(dot - text) : strlen(text);
+
+    if (len == 0 || len >= sizeof(name)) {
+        return -1;
+    }
+    memcpy(name, text, len);
+    name[len] = '\0';
+    snprintf(s->name, sizeof(s->name), "%s", text);
+    s->bit = -1;
+    s->width = 8;
+
+    if (!strcmp(name, "TCNT0")) {
+        s->kind = SIG_TCNT0;
+    } else if (!strcmp(name, "irq")) {
+        s->kind = SIG_IRQ;
+        s->width = 5;
+    } else if (!strcmp(name, "I")) {
+        s->kind = SIG_I;
+        s->width = 1;
+    } else if (!strcmp(name, "sleep")) {
+        s->kind = SIG_SLEEP;
+        s->width = 1;
+    } else if (!strcmp(name, "pc")) {
+        s->kind = SIG_PC;
+        s->width = 16;
+    } else if (len == 4 && !strncmp(name, "PIN", 3) && name[3] >= 'A' && name[3] <= 'D') {
+        s->kind = SIG_PINS;
+        s->addr = name[3] - 'A';
+    } else if (len == 3 && name[0] == 'P' && name[1] >= 'A' && name[1] <= 'D'
+               && name[2] >= '0' && name[2] <= '7') {
+        s->kind = SIG_PIN;
+        s->addr = name[1] - 'A';
+        s->bit = name[2] - '0';
+        s->width = 1;
+        return dot ? -1 : 0;
+    } else {
+        char* end;
+        s->kind = SIG_REG;
+        s->addr = (uint16_t)strtoul(name, &end, 0);
+        if (*end) {
+            s->addr = 0;
+            for (size_t i = 0; i < sizeof(registers) / sizeof(registers[0]); i++) {
+                if (!strcmp(name, registers[i].name)) {
+                    s->addr = registers[i].addr;
+                }
+            }
+        }
+        if (s->addr < AVR_IO_BASE || s->addr >= AVR_SRAM_START) {
+            return -1;
+        }
+    }
+    if (dot) {
+        if (s->kind != SIG_REG && s->kind != SIG_PINS) {
+            return -1;
+        }
+        if (dot[1] < '0' || dot[1] > '7' || dot[2]) {
+            return -1;
+        }
+        s->bit = dot[1] - '0';
+        s->width = 1;
+        s->kind = s->kind == SIG_PINS ? SIG_PIN : SIG_REG;
+    }
+    return 0;
+}
+
+// Current value of a signal (TCNT0 is handled by the replay)
+static uint32_t readSignal(struct AvrCore* avr, const struct VcdSignal* s)
+{
+    uint32_t value;
+
+    switch (s->kind) {
+    case SIG_PIN:
+    case SIG_PINS:
+        value = gpioPins(avr, s->addr);
+        break;
+    case SIG_REG:
+        value = avr->data[s->addr];
+        break;
+    case SIG_IRQ:
+        return avr->isrDepth ? avr->isrStack[avr->isrDepth - 1] : 0;
+    case SIG_I:
+        return (avr->data[AVR_SREG] >> SREG_I) & 1;
+    case SIG_SLEEP:
+        return avr->sleeping;
+    case SIG_PC:
+        return avr->pc * 2u;
+    default:
+        return 0;
+    }
+    return s->bit < 0 ? value : (value >> s->bit) & 1;
+}
+
+// Advance the dump time to 'cycle' (never backwards)
+static void setTime(struct AvrVcd* v, uint64_t cycle)
+{
+    if (cycle > v->time) {
+        v->time = cycle;
+        fprintf(v->out, "#%llu\n", (unsigned long long)(cycle * v->psPerCycle + 0.5));
+    }
+}
+
+static void writeValue(struct AvrVcd* v, struct VcdSignal* s, uint32_t value)
+{
+    if (s->width == 1) {
+        fprintf(v->out, "%u%s\n", value & 1, s->id);
+        return;
+    }
+    fputc('b', v->out);
+    for (int i = s->width - 1; i >= 0; i--) {
+        fputc('0' + ((value >> i) & 1), v->out);
+    }
+    fprintf(v->out, " %s\n", s->id);
+}
+
+// Timer0 replay callback
+static void onCount(void* ctx, uint64_t cycle, uint8_t tcnt)
+{
+    struct AvrVcd* v = ctx;
+
+    if (tcnt != v->tcnt0->last) {
+        setTime(v, cycle);
+        writeValue(v, v->tcnt0, tcnt);
+        v->tcnt0->last = tcnt;
+    }
+}
+
+//============================================Functions========================================
+// Create the dump and attach it to the core. 'signals' is a comma separated list, NULL for
+// the default set. Returns NULL (after printing why) on a bad signal or an unwritable file.
+struct AvrVcd* vcdOpen(struct AvrCore* avr, const char* path, const char* signals, double fCpu)
+{
+    struct AvrVcd* v = calloc(1, sizeof(*v));
+    char list[512];
+    char* save;
+
+    if (!v) {
+        return NULL;
+    }
+    snprintf(list, sizeof(list), "%s", signals ? signals : VCD_DEFAULT);
+    for (char* tok = strtok_r(list, ",", &save); tok; tok = strtok_r(NULL, ",", &save)) {
+        struct VcdSignal* s = &v->signals[v->signalCount];
+        if (v->signalCount == VCD_MAX_SIGNALS || parseSignal(s, tok) < 0) {
+            fprintf(stderr, "vcd: unknown signal '%s'\n", tok);
+            free(v);
+            return NULL;
+        }
+        // Identifier codes: printable ASCII from '!' on, two characters past 94 signals
+        s->id[0] = '!' + v->signalCount % 94;
+        s->id[1] = v->signalCount >= 94 ? '!' + v->signalCount / 94 : '\0';
+        if (s->kind == SIG_TCNT0) {
+            v->tcnt0 = s;
+        }
+        v->signalCount++;
+    }
+
+    v->out = fopen(path, "w");
+    if (!v->out) {
+        perror(path);
+        free(v);
+        return NULL;
+    }
+    v->psPerCycle = 1e12 / fCpu;
+
+    fprintf(v->out, "$version avrsim $end\n$timescale 1ps $end\n$scope module atmega32a $end\n");
+    for (int i = 0; i < v->signalCount; i++) {
+        const struct VcdSignal* s = &v->signals[i];
+        fprintf(v->out, "$var wire %u %s %s $end\n", s->width, s->id, s->name);
+    }
+    fprintf(v->out, "$upscope $end\n$enddefinitions $end\n#0\n$dumpvars\n");
+    for (int i = 0; i < v->signalCount; i++) {
+        struct VcdSignal* s = &v->signals[i];
+        s->last = s->kind == SIG_TCNT0 ? avr->timer0.tcnt : readSignal(avr, s);
+        writeValue(v, s, s->last);
+    }
+    fprintf(v->out, "$end\n");
+    v->time = avr->cycles;
+    avr->vcd = v;
+    return v;
+}
+
+// Record every signal change up to the current cycle
+void vcdSample(struct AvrCore* avr)
+{
+    struct AvrVcd* v = avr->vcd;
+
+    if (v->tcnt0) {
+        timer0Replay(avr, &v->shadow, avr->cycles, onCount, v);
+    }
+    for (int i = 0; i < v->signalCount; i++) {
+        struct VcdSignal* s = &v->signals[i];
+        uint32_t value;
+
+        if (s->kind == SIG_TCNT0) {
+            continue;
+        }
+        value = readSignal(avr, s);
+        if (value != s->last) {
+            setTime(v, avr->cycles);
+            writeValue(v, s, value);
+            s->last = value;
+        }
+    }
+}
+
+// Write the final time stamp and close the dump
+void vcdClose(struct AvrCore* avr)
+{
+    struct AvrVcd* v = avr->vcd;
+
+    if (!v) {
+        return;
+    }
+    vcdSample(avr);
+    setTime(v, avr->cycles);
+    fclose(v->out);
+    free(v);
+    avr->vcd = NULL;
+}
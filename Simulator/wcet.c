@@ -0,0 +1,1453 @@
+//===========================================================================================
+// Project: ATmega32A Host-Side Simulator
+// Compiler: gcc (host, C99)
+// Target microcontroller: ATmega32A (simulated)
+// Description: Static worst-case execution time. Reads an image (the a.out ELF for names,
+//              or a .hex), builds the control flow graph of each function from the machine
+//              code and bounds the cycles of its longest path, including everything it calls.
+//              The simulator measures what did happen; this gives what cannot be exceeded.
+//
+//              Functions are split into basic blocks. Every edge costs the cycles of the block
+//              when it is left that way (taken branch 2, skip 2 or 3, ...), with the same
+//              instruction timings as avr_core.c. A call costs the CALL plus the callee's bound,
+//              and a JMP or RJMP to the start of another function is a tail call. Loops are the
+//              natural loops of the graph. Each one needs a bound: the most times its header
+//              runs per entry. It then folds, innermost first, into a single node costing
+//              (bound - 1) x its longest iteration plus the longest way out. Countdown loops
+//              (DEC, SBIW, SUBI/SBCI + BRNE) with their counter set by LDI right before the
+//              loop bound themselves. A loop left without a bound, recursion, IJMP or ICALL
+//              makes the function unbounded, with the reason. The CALL itself is charged to
+//              the caller, so the -p table shows a function 3 or 4 cycles longer.
+//
+//              An interrupt vector (TIMER0_COMP_vect) is timed as the simulator's -p table
+//              does: from the 4-cycle response through the vector's JMP to the end of the
+//              RETI. Waking from sleep adds 4 more. Interrupts that preempt a function are not
+//              counted in its bound.
+//
+//              A loop is named by its header: symbol+byte offset, byte address, or a label
+//              prefix (name*). The prefix matches every local label in the header block whose
+//              name starts with it, so a label written into the loop's source with a %=
+//              suffix (see millis() in timebase.h) names every inlined copy at once and does
+//              not move when the code around it changes.
+//
+//              Budget files hold loop bounds and assertions, one per line ('#' comments):
+//                  bound updateButton+0x2a=8      header at symbol+byte offset (or 0x1ca)
+//                  bound timebase_millis_retry*=2 every loop whose header holds such a label
+//                  assert TIMER0_COMP_vect<=100   fails the run (exit status 1) if exceeded
+//
+// Usage:   ./wcet [-F hz] [-b loc=n] [-a func<=cycles] [-B budget] [-j report.json] [-v]
+//                 image [function...]
+// Date created: 2026-10-16
+//===========================================================================================
+
+//============================================Libraries========================================
+#include <getopt.h>
+#include <stdlib.h>
+#include <string.h>
+#include "avrsim.h"
+
+//============================================Defines========================================
+#define WCET_MAX_FUNCS   512
+#define WCET_MAX_BOUNDS  256
+#define WCET_MAX_ASSERTS 64
+#define WCET_MAX_LOOPS   32  // Reported per function
+#define WCET_EXIT        UINT32_MAX // Edge target: the function returns
+#define WORD_MASK        (AVR_FLASH_WORDS - 1)
+
+// Instruction kinds that matter to control flow
+enum
+{
+    OP_PLAIN,  // Falls through
+    OP_BRANCH, // Conditional: 1 cycle on, 2 to the target
+    OP_SKIP,   // CPSE/SBRC/SBRS/SBIC/SBIS: 1 on, 2 or 3 over the next instruction
+    OP_JUMP,   // RJMP/JMP
+    OP_CALL,   // RCALL/CALL
+    OP_RET,    // RET/RETI
+    OP_IJMP,   // Indirect: target unknown
+    OP_ICALL,
+    OP_STOP    // BREAK or undecodable
+};
+
+struct Insn
+{
+    uint8_t kind;
+    uint8_t words;
+    uint8_t cycles;  // Falling through (or jumping, calling, returning)
+    uint16_t target; // Word address for branches, skips, jumps and calls
+};
+
+// Loop bound given by the user or derived from a countdown
+struct Bound
+{
+    uint16_t header;  // Word address, when no label is given
+    char label[48];   // Label prefix, empty for an address location
+    uint32_t count;   // Most executions of the header per entry into the loop
+    uint8_t used;
+    char text[64];    // As written, for messages
+};
+
+struct Assert
+{
+    char name[64];
+    uint64_t limit;
+};
+
+struct LoopInfo
+{
+    uint16_t header;
+    uint32_t bound;   // 0 if missing
+    uint8_t automatic;
+    uint64_t iteration; // Longest single pass
+};
+
+struct Func
+{
+    uint16_t entry;   // Word address
+    int vector;       // Interrupt vector timed from its response, -1 for a function
+    uint8_t state;    // 0 new, 1 being analysed, 2 done
+    uint8_t bounded;
+    uint64_t wcet;
+    uint32_t blocks;
+    char reason[192];
+    struct LoopInfo loops[WCET_MAX_LOOPS];
+    int loopCount;
+    uint16_t callees[32]; // Indices into the function table
+    int calleeCount;
+};
+
+struct Edge
+{
+    uint32_t from;
+    uint32_t to;      // Node, or WCET_EXIT
+    uint64_t cost;
+    uint8_t alive;
+};
+
+// Control flow graph of one function; nodes are blocks, then folded loops
+struct Graph
+{
+    uint8_t visited[AVR_FLASH_WORDS];
+    uint8_t leader[AVR_FLASH_WORDS];
+    uint32_t blockOf[AVR_FLASH_WORDS];
+    uint16_t* start;    // First word per block
+    uint32_t blockCount;
+    uint32_t nodeCount; // Blocks and folded loops
+    uint32_t nodeSize;
+    uint32_t* rep;      // Node a block is part of now
+    struct Edge* edges;
+    uint32_t edgeCount;
+    uint32_t edgeSize;
+};
+
+struct Wcet
+{
+    struct AvrCore* avr;
+    struct AvrSymbols syms;
+    struct Func funcs[WCET_MAX_FUNCS];
+    int funcCount;
+    struct Bound bounds[WCET_MAX_BOUNDS];
+    int boundCount;
+    struct Assert asserts[WCET_MAX_ASSERTS];
+    int assertCount;
+    int verbose;
+};
+
+//============================================Instructions========================================
+// Kind, size and cycles of the instruction at 'pc'; timings as returned by avr_core.c
+static void classify(const uint16_t* flash, uint16_t pc, struct Insn* in)
+{
+    uint16_t op = flash[pc];
+    uint16_t next = (pc + 1) & WORD_MASK;
+
+    in->kind = OP_PLAIN;
+    in->words = (uint8_t)avrOpcodeWords(op);
+    in->cycles = 1;
+    in->target = 0;
+    switch (op >> 12) {
+    case 0x0:
+        if ((op & 0xFF00) == 0x0000 && op != 0x0000) {
+            in->kind = OP_STOP;
+        } else if ((op & 0xFE00) == 0x0200 || (op & 0xFF00) == 0x0300) {
+            in->cycles = 2; // MULS, MULSU, FMUL*
+        }
+        break;
+    case 0x1:
+        if ((op & 0x0C00) == 0) {
+            in->kind = OP_SKIP; // CPSE
+        }
+        break;
+    case 0x8:
+    case 0xA:
+        in->cycles = 2; // LDD / STD
+        break;
+    case 0x9:
+        if ((op & 0x0C00) == 0x0000) {
+            switch (op & 0x0F) {
+            case 0x0: case 0xF: case 0x1: case 0x2: case 0x9: case 0xA: case 0xC: case 0xD: case 0xE:
+                in->cycles = 2; // LDS/STS, PUSH/POP, LD/ST
+                break;
+            case 0x4: case 0x5:
+                if (op & 0x0200) {
+                    in->kind = OP_STOP;
+                } else {
+                    in->cycles = 3; // LPM
+                }
+                break;
+            default:
+                in->kind = OP_STOP;
+            }
+        } else if ((op & 0x0E00) == 0x0400) {
+            switch (op & 0x0F) {
+            case 0x8:
+                if ((op & 0xFF0F) == 0x9408 || op == 0x9588 || op == 0x95A8 || op == 0x95E8) {
+                    break; // BSET/BCLR, SLEEP, WDR, SPM
+                }
+                if (op == 0x9508 || op == 0x9518) {
+                    in->kind = OP_RET;
+                    in->cycles = 4;
+                } else if (op == 0x95C8) {
+                    in->cycles = 3;
+                } else {
+                    in->kind = OP_STOP; // BREAK and the rest
+                }
+                break;
+            case 0x9:
+                if (op == 0x9409) {
+                    in->kind = OP_IJMP;
+                    in->cycles = 2;
+                } else if (op == 0x9509) {
+                    in->kind = OP_ICALL;
+                    in->cycles = 3;
+                } else {
+                    in->kind = OP_STOP;
+                }
+                break;
+            case 0xC: case 0xD: case 0xE: case 0xF:
+                in->kind = (op & 2) ? OP_CALL : OP_JUMP;
+                in->cycles = (op & 2) ? 4 : 3;
+                in->target = flash[next] & WORD_MASK;
+                break;
+            case 0x4: case 0xB:
+                in->kind = OP_STOP;
+                break;
+            default:
+                break; // COM, NEG, SWAP, INC, ASR, LSR, ROR, DEC
+            }
+        } else if ((op & 0x0C00) == 0x0800 && (op & 0x0100)) {
+            in->kind = OP_SKIP; // SBIC / SBIS
+        } else {
+            in->cycles = 2; // ADIW/SBIW, CBI/SBI, MUL
+        }
+        break;
+    case 0xC:
+        in->kind = OP_JUMP;
+        in->cycles = 2;
+        in->target = (next + ((int16_t)(op << 4) >> 4)) & WORD_MASK;
+        break;
+    case 0xD:
+        in->kind = OP_CALL;
+        in->cycles = 3;
+        in->target = (next + ((int16_t)(op << 4) >> 4)) & WORD_MASK;
+        break;
+    case 0xF:
+        if ((op & 0x0800) == 0) {
+            in->kind = OP_BRANCH;
+            in->target = (next + ((int8_t)((op >> 2) & 0xFE) >> 1)) & WORD_MASK;
+        } else if (op & 0x0008) {
+            in->kind = OP_STOP;
+        } else if (op & 0x0400) {
+            in->kind = OP_SKIP; // SBRC / SBRS
+        }
+        break;
+    default:
+        break;
+    }
+    if (in->kind == OP_CALL && in->target == next) {
+        in->kind = OP_PLAIN; // "rcall .+0": avr-gcc reserving two bytes of stack
+    }
+    if (in->kind == OP_SKIP) {
+        in->target = (next + avrOpcodeWords(flash[next])) & WORD_MASK;
+    }
+}
+
+//============================================Names========================================
+// Symbol that starts exactly at word 'w', NULL if none
+static const struct AvrSymbol* symAt(const struct Wcet* w, uint16_t word)
+{
+    const struct AvrSymbol* s = symFind(&w->syms, word * 2u);
+    return s && s->addr == word * 2u ? s : NULL;
+}
+
+static void locName(const struct Wcet* w, uint16_t word, char* buf, size_t len)
+{
+    const struct AvrSymbol* s = symFind(&w->syms, word * 2u);
+
+    if (s && s->addr == word * 2u) {
+        snprintf(buf, len, "%s", s->name);
+    } else if (s) {
+        snprintf(buf, len, "%s+0x%x", s->name, word * 2u - s->addr);
+    } else {
+        snprintf(buf, len, "0x%04x", word * 2u);
+    }
+}
+
+static void funcName(const struct Wcet* w, const struct Func* f, char* buf, size_t len)
+{
+    if (f->vector >= 0) {
+        snprintf(buf, len, "%s_vect", avrVectorName((uint8_t)f->vector));
+    } else {
+        locName(w, f->entry, buf, len);
+    }
+}
+
+// "updateButton", "updateButton+0x26", "0x1c6" or "TIMER0_COMP_vect" to a word address;
+// 'vector' (if not NULL) receives the vector number for the last form, -1 otherwise
+static int parseLoc(const struct Wcet* w, const char* text, uint16_t* word, int* vector)
+{
+    char name[64];
+    const char* plus = strchr(text, '+');
+    size_t len = plus ? (size_t)(plus - text) : strlen(text);
+    unsigned long offset = plus ? strtoul(plus + 1, NULL, 0) : 0;
+    char* end;
+
+    if (vector) {
+        *vector = -1;
+    }
+    if (len == 0 || len >= sizeof(name)) {
+        return -1;
+    }
+    memcpy(name, text, len);
+    name[len] = '\0';
+    unsigned long addr = strtoul(name, &end, 0);
+    if (*end == '\0') {
+        *word = (uint16_t)(((addr + offset) / 2) & WORD_MASK);
+        return 0;
+    }
+    for (int v = 1; v < AVR_VECTOR_COUNT && !plus; v++) {
+        char vect[32];
+        snprintf(vect, sizeof(vect), "%s_vect", avrVectorName((uint8_t)v));
+        if (!strcmp(name, vect)) {
+            *word = (uint16_t)(v * 2); // Two words per vector (JMP)
+            if (vector) {
+                *vector = v;
+            }
+            return 0;
+        }
+    }
+    for (uint32_t i = 0; i < w->syms.count; i++) {
+        if (!strcmp(w->syms.syms[i].name, name)) {
+            *word = (uint16_t)(((w->syms.syms[i].addr + offset) / 2) & WORD_MASK);
+            return 0;
+        }
+    }
+    return -1;
+}
+
+// Append to a function's list of reasons it has no bound
+static void unbounded(struct Func* f, const char* fmt, const char* what)
+{
+    size_t used = strlen(f->reason);
+
+    f->bounded = 0;
+    if (used + 3 < sizeof(f->reason)) {
+        if (used) {
+            strcat(f->reason, "; ");
+            used += 2;
+        }
+        snprintf(f->reason + used, sizeof(f->reason) - used, fmt, what);
+    }
+}
+
+//============================================Graph========================================
+static int addEdge(struct Graph* g, uint32_t from, uint32_t to, uint64_t cost)
+{
+    if (g->edgeCount == g->edgeSize) {
+        uint32_t size = g->edgeSize ? g->edgeSize * 2 : 64;
+        struct Edge* grown = realloc(g->edges, size * sizeof(*grown));
+        if (!grown) {
+            return -1;
+        }
+        g->edges = grown;
+        g->edgeSize = size;
+    }
+    g->edges[g->edgeCount].from = from;
+    g->edges[g->edgeCount].to = to;
+    g->edges[g->edgeCount].cost = cost;
+    g->edges[g->edgeCount].alive = 1;
+    g->edgeCount++;
+    return 0;
+}
+
+// Longest path from 'head' to every node of 'inside' (edges back to 'head' left out).
+// 'dist' gets UINT64_MAX for nodes not reached; returns -1 if the region has another cycle.
+static int longest(const struct Graph* g, const uint8_t* inside, uint32_t head, uint64_t* dist)
+{
+    uint32_t* order = malloc(g->nodeCount * sizeof(*order));
+    uint32_t* stack = malloc(g->nodeCount * sizeof(*stack));
+    uint32_t* edgeAt = malloc(g->nodeCount * sizeof(*edgeAt));
+    uint8_t* mark = calloc(g->nodeCount, 1); // 1 on the DFS stack, 2 finished
+    uint32_t count = 0;
+    uint32_t depth = 0;
+    int ok = order && stack && edgeAt && mark;
+
+    // Depth-first postorder over alive edges inside the region
+    if (ok) {
+        stack[depth] = head;
+        edgeAt[depth++] = 0;
+        mark[head] = 1;
+    }
+    while (ok && depth) {
+        uint32_t n = stack[depth - 1];
+        uint32_t e = edgeAt[depth - 1];
+
+        for (; e < g->edgeCount; e++) {
+            const struct Edge* x = &g->edges[e];
+            if (x->alive && x->from == n && x->to != WCET_EXIT && x->to != head && inside[x->to]
+                && mark[x->to] != 2) {
+                break;
+            }
+        }
+        if (e == g->edgeCount) {
+            mark[n] = 2;
+            order[count++] = n;
+            depth--;
+            continue;
+        }
+        edgeAt[depth - 1] = e + 1;
+        if (mark[g->edges[e].to] == 1) {
+            ok = 0; // A cycle that is not a loop of this region
+            break;
+        }
+        mark[g->edges[e].to] = 1;
+        stack[depth] = g->edges[e].to;
+        edgeAt[depth++] = 0;
+    }
+
+    // Reverse postorder is a topological order
+    for (uint32_t i = 0; ok && i < g->nodeCount; i++) {
+        dist[i] = UINT64_MAX;
+    }
+    if (ok) {
+        dist[head] = 0;
+    }
+    for (uint32_t i = count; ok && i-- > 0;) {
+        uint32_t n = order[i];
+        if (dist[n] == UINT64_MAX) {
+            continue;
+        }
+        for (uint32_t e = 0; e < g->edgeCount; e++) {
+            const struct Edge* x = &g->edges[e];
+            if (x->alive && x->from == n && x->to != WCET_EXIT && x->to != head && inside[x->to]
+                && (dist[x->to] == UINT64_MAX || dist[n] + x->cost > dist[x->to])) {
+                dist[x->to] = dist[n] + x->cost;
+            }
+        }
+    }
+    free(order);
+    free(stack);
+    free(edgeAt);
+    free(mark);
+    return ok ? 0 : -1;
+}
+
+// Immediate dominators of the blocks (Cooper, Harvey and Kennedy); entry is block 0
+static int dominators(const struct Graph* g, uint32_t* idom)
+{
+    uint32_t n = g->blockCount;
+    uint32_t* rpo = malloc(n * sizeof(*rpo));
+    uint32_t* index = malloc(n * sizeof(*index));
+    uint8_t* seen = calloc(n, 1);
+    uint32_t* stack = malloc(n * sizeof(*stack));
+    uint32_t* edgeAt = malloc(n * sizeof(*edgeAt));
+    uint32_t count = 0;
+    uint32_t depth = 0;
+    int changed = 1;
+
+    if (!rpo || !index || !seen || !stack || !edgeAt) {
+        free(rpo); free(index); free(seen); free(stack); free(edgeAt);
+        return -1;
+    }
+    stack[depth] = 0;
+    edgeAt[depth++] = 0;
+    seen[0] = 1;
+    while (depth) {
+        uint32_t b = stack[depth - 1];
+        uint32_t e = edgeAt[depth - 1];
+        for (; e < g->edgeCount; e++) {
+            if (g->edges[e].from == b && g->edges[e].to != WCET_EXIT && !seen[g->edges[e].to]) {
+                break;
+            }
+        }
+        if (e == g->edgeCount) {
+            rpo[count++] = b; // Postorder for now
+            depth--;
+            continue;
+        }
+        edgeAt[depth - 1] = e + 1;
+        seen[g->edges[e].to] = 1;
+        stack[depth] = g->edges[e].to;
+        edgeAt[depth++] = 0;
+    }
+    for (uint32_t i = 0; i < count / 2; i++) {
+        uint32_t t = rpo[i];
+        rpo[i] = rpo[count - 1 - i];
+        rpo[count - 1 - i] = t;
+    }
+    for (uint32_t i = 0; i < n; i++) {
+        idom[i] = WCET_EXIT;
+        index[i] = WCET_EXIT;
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        index[rpo[i]] = i;
+    }
+    idom[0] = 0;
+    while (changed) {
+        changed = 0;
+        for (uint32_t i = 1; i < count; i++) {
+            uint32_t b = rpo[i];
+            uint32_t best = WCET_EXIT;
+            for (uint32_t e = 0; e < g->edgeCount; e++) {
+                uint32_t p = g->edges[e].from;
+                if (g->edges[e].to != b || idom[p] == WCET_EXIT) {
+                    continue;
+                }
+                if (best == WCET_EXIT) {
+                    best = p;
+                    continue;
+                }
+                uint32_t x = p, y = best; // Intersect
+                while (x != y) {
+                    while (index[x] > index[y]) {
+                        x = idom[x];
+                    }
+                    while (index[y] > index[x]) {
+                        y = idom[y];
+                    }
+                }
+                best = x;
+            }
+            if (best != WCET_EXIT && idom[b] != best) {
+                idom[b] = best;
+                changed = 1;
+            }
+        }
+    }
+    free(rpo); free(index); free(seen); free(stack); free(edgeAt);
+    return 0;
+}
+
+static int dominates(const uint32_t* idom, uint32_t a, uint32_t b)
+{
+    while (b != a && b != 0 && idom[b] != WCET_EXIT) {
+        b = idom[b];
+    }
+    return b == a;
+}
+
+// Bound of a countdown loop whose counter is loaded by the LDIs that end the block before it
+static uint32_t countdownBound(const struct Wcet* w, const struct Graph* g, uint32_t head,
+                               uint16_t branch)
+{
+    const uint16_t* flash = w->avr->flash;
+    uint16_t h = g->start[head];
+    uint8_t reg;
+    int bytes = idleCountdownBytes(flash, h, branch, &reg);
+    uint32_t pred = WCET_EXIT;
+    int seen[4] = { -1, -1, -1, -1 };
+    uint64_t value = 0;
+
+    if (bytes == 0) {
+        return 0;
+    }
+    // The only way in must be falling through from the block right before
+    for (uint32_t e = 0; e < g->edgeCount; e++) {
+        const struct Edge* x = &g->edges[e];
+        if (x->to == head && !(g->start[x->from] >= h && g->start[x->from] <= branch)) {
+            if (pred != WCET_EXIT && pred != x->from) {
+                return 0;
+            }
+            pred = x->from;
+        }
+    }
+    if (pred == WCET_EXIT) {
+        return 0;
+    }
+    // Trailing run of LDIs in that block
+    for (uint16_t pc = g->start[pred]; pc < h;) {
+        struct Insn in;
+        uint16_t op = flash[pc];
+        classify(flash, pc, &in);
+        if ((op & 0xF000) == 0xE000) {
+            int r = 16 + ((op >> 4) & 0x0F);
+            if (r >= reg && r < reg + bytes) {
+                seen[r - reg] = ((op >> 4) & 0xF0) | (op & 0x0F);
+            }
+        } else {
+            seen[0] = seen[1] = seen[2] = seen[3] = -1;
+        }
+        pc += in.words;
+    }
+    for (int i = bytes - 1; i >= 0; i--) {
+        if (seen[i] < 0) {
+            return 0;
+        }
+        value = (value << 8) | (uint64_t)seen[i];
+    }
+    if (value == 0) {
+        value = (uint64_t)1 << (8 * bytes); // Counts down through zero
+    }
+    return value > UINT32_MAX ? 0 : (uint32_t)value;
+}
+
+// Does bound 'b' name the loop whose header starts at word 'head'?
+static int boundMatches(const struct Wcet* w, const struct Bound* b, uint16_t head)
+{
+    uint16_t pc = head;
+
+    if (!b->label[0]) {
+        return b->header == head;
+    }
+    // A label on any instruction of the header block, up to the first one that leaves it
+    for (;;) {
+        struct Insn in;
+
+        for (uint32_t i = 0; i < w->syms.labelCount; i++) {
+            const struct AvrSymbol* l = &w->syms.labels[i];
+            if (l->addr == pc * 2u && !strncmp(l->name, b->label, strlen(b->label))) {
+                return 1;
+            }
+        }
+        classify(w->avr->flash, pc, &in);
+        if (in.kind != OP_PLAIN && in.kind != OP_CALL) {
+            return 0;
+        }
+        pc = (pc + in.words) & WORD_MASK;
+        if (pc == head) {
+            return 0;
+        }
+    }
+}
+
+//============================================Analysis========================================
+static struct Func* analyse(struct Wcet* w, int index);
+
+static int funcIndex(struct Wcet* w, uint16_t entry, int vector)
+{
+    for (int i = 0; i < w->funcCount; i++) {
+        if (w->funcs[i].entry == entry && w->funcs[i].vector == vector) {
+            return i;
+        }
+    }
+    if (w->funcCount == WCET_MAX_FUNCS) {
+        return -1;
+    }
+    memset(&w->funcs[w->funcCount], 0, sizeof(w->funcs[0]));
+    w->funcs[w->funcCount].entry = entry;
+    w->funcs[w->funcCount].vector = vector;
+    return w->funcCount++;
+}
+
+// A JMP/RJMP to the start of another function hands over to it
+static int isTailCall(const struct Wcet* w, const struct Func* f, uint16_t target)
+{
+    const struct AvrSymbol* s = symAt(w, target);
+    return target != f->entry && s && s->rank == 3; // SYM_RANK_FUNC in elf.c
+}
+
+// Cost of calling 'target' from 'f' (its bound), with the callee recorded
+static uint64_t callCost(struct Wcet* w, int self, uint16_t target)
+{
+    int callee = funcIndex(w, target, -1);
+    struct Func* f = &w->funcs[self];
+    char name[64];
+
+    if (callee < 0) {
+        unbounded(f, "%s", "too many functions");
+        return 0;
+    }
+    if (f->calleeCount < 32) {
+        int known = 0;
+        for (int i = 0; i < f->calleeCount; i++) {
+            known |= f->callees[i] == callee;
+        }
+        if (!known) {
+            f->callees[f->calleeCount++] = (uint16_t)callee;
+        }
+    }
+    struct Func* c = analyse(w, callee);
+    f = &w->funcs[self];
+    if (!c->bounded) {
+        funcName(w, c, name, sizeof(name));
+        unbounded(f, c->state == 1 ? "recursion through %s" : "calls unbounded %s", name);
+        return 0;
+    }
+    return c->wcet;
+}
+
+// Find every instruction of the function and mark block leaders
+static void explore(struct Wcet* w, int self, struct Graph* g)
+{
+    const uint16_t* flash = w->avr->flash;
+    uint16_t* work = malloc(AVR_FLASH_WORDS * sizeof(*work));
+    int top = 0;
+    char where[64];
+
+    if (!work) {
+        unbounded(&w->funcs[self], "%s", "out of memory");
+        return;
+    }
+    work[top++] = w->funcs[self].entry;
+    g->leader[w->funcs[self].entry] = 1;
+    g->visited[w->funcs[self].entry] = 1;
+    while (top) {
+        uint16_t pc = work[--top];
+        struct Insn in;
+        uint16_t succ[2];
+        int n = 0;
+
+        classify(flash, pc, &in);
+        switch (in.kind) {
+        case OP_PLAIN:
+        case OP_CALL:
+        case OP_ICALL:
+            succ[n++] = (pc + in.words) & WORD_MASK;
+            if (in.kind == OP_ICALL) {
+                locName(w, pc, where, sizeof(where));
+                unbounded(&w->funcs[self], "indirect call at %s", where);
+            }
+            break;
+        case OP_BRANCH:
+        case OP_SKIP:
+            succ[n++] = (pc + in.words) & WORD_MASK;
+            succ[n++] = in.target;
+            g->leader[succ[0]] = 1;
+            g->leader[succ[1]] = 1;
+            break;
+        case OP_JUMP:
+            if (!isTailCall(w, &w->funcs[self], in.target)) {
+                succ[n++] = in.target;
+                g->leader[in.target] = 1;
+            }
+            break;
+        case OP_IJMP:
+            locName(w, pc, where, sizeof(where));
+            unbounded(&w->funcs[self], "indirect jump at %s", where);
+            break;
+        default:
+            break; // RET/RETI, BREAK
+        }
+        for (int i = 0; i < n; i++) {
+            if (!g->visited[succ[i]]) {
+                g->visited[succ[i]] = 1;
+                work[top++] = succ[i];
+            }
+        }
+    }
+    free(work);
+}
+
+// Blocks and their edges; calls are analysed (and costed) on the way
+static int buildGraph(struct Wcet* w, int self, struct Graph* g)
+{
+    const uint16_t* flash = w->avr->flash;
+
+    g->blockCount = 0;
+    for (uint32_t pc = 0; pc < AVR_FLASH_WORDS; pc++) {
+        if (g->visited[pc] && g->leader[pc]) {
+            g->blockOf[pc] = g->blockCount++;
+        }
+    }
+    g->nodeSize = g->blockCount * 2 + 1;
+    g->start = malloc(g->nodeSize * sizeof(*g->start));
+    g->rep = malloc(g->nodeSize * sizeof(*g->rep));
+    if (!g->start || !g->rep) {
+        return -1;
+    }
+    // Block 0 must be the entry for the dominator pass: swap it in
+    uint32_t entryBlock = g->blockOf[w->funcs[self].entry];
+    for (uint32_t pc = 0; pc < AVR_FLASH_WORDS; pc++) {
+        if (g->visited[pc] && g->leader[pc]) {
+            uint32_t b = g->blockOf[pc];
+            b = b == entryBlock ? 0 : b == 0 ? entryBlock : b;
+            g->blockOf[pc] = b;
+            g->start[b] = (uint16_t)pc;
+        }
+    }
+    for (uint32_t b = 0; b < g->blockCount; b++) {
+        uint16_t pc = g->start[b];
+        uint64_t cost = 0;
+        g->rep[b] = b;
+
+        for (;;) {
+            struct Insn in;
+            uint16_t next;
+
+            classify(flash, pc, &in);
+            next = (pc + in.words) & WORD_MASK;
+            switch (in.kind) {
+            case OP_BRANCH:
+            case OP_SKIP:
+                if (addEdge(g, b, g->blockOf[next], cost + 1) < 0
+                    || addEdge(g, b, g->blockOf[in.target], cost + (in.kind == OP_BRANCH ? 2 : 1 + avrOpcodeWords(flash[next]))) < 0) {
+                    return -1;
+                }
+                break;
+            case OP_JUMP:
+                if (isTailCall(w, &w->funcs[self], in.target)) {
+                    uint64_t callee = callCost(w, self, in.target);
+                    if (addEdge(g, b, WCET_EXIT, cost + in.cycles + callee) < 0) {
+                        return -1;
+                    }
+                } else if (addEdge(g, b, g->blockOf[in.target], cost + in.cycles) < 0) {
+                    return -1;
+                }
+                break;
+            case OP_RET:
+                if (addEdge(g, b, WCET_EXIT, cost + in.cycles) < 0) {
+                    return -1;
+                }
+                break;
+            case OP_IJMP:
+            case OP_STOP:
+                break; // No way on that can be followed
+            default:
+                cost += in.cycles;
+                if (in.kind == OP_CALL) {
+                    cost += callCost(w, self, in.target);
+                }
+                if (!g->leader[next]) {
+                    pc = next;
+                    continue;
+                }
+                if (addEdge(g, b, g->blockOf[next], cost) < 0) {
+                    return -1;
+                }
+                break;
+            }
+            break;
+        }
+    }
+    g->nodeCount = g->blockCount;
+    return 0;
+}
+
+// Fold every loop, innermost first, then take the longest path to a return
+static void solve(struct Wcet* w, int self, struct Graph* g)
+{
+    struct Func* f = &w->funcs[self];
+    uint32_t n = g->blockCount;
+    uint32_t* idom = malloc(n * sizeof(*idom));
+    uint8_t* isHeader = calloc(n, 1);
+    uint8_t* inside = NULL;
+    uint32_t* size = calloc(n, sizeof(*size));
+    uint64_t* dist = NULL;
+    char where[64];
+
+    if (!idom || !isHeader || !size || dominators(g, idom) < 0) {
+        unbounded(f, "%s", "out of memory");
+        goto done;
+    }
+    // Back edges point at a dominator; any other retreat makes the graph irreducible
+    for (uint32_t e = 0; e < g->edgeCount; e++) {
+        const struct Edge* x = &g->edges[e];
+        if (x->to == WCET_EXIT || idom[x->from] == WCET_EXIT) {
+            continue;
+        }
+        if (dominates(idom, x->to, x->from)) {
+            isHeader[x->to] = 1;
+        }
+    }
+
+    // Natural loop bodies, as block sets, one per header
+    uint8_t** body = calloc(n, sizeof(*body));
+    if (!body) {
+        unbounded(f, "%s", "out of memory");
+        goto done;
+    }
+    for (uint32_t h = 0; h < n; h++) {
+        uint32_t* work;
+        uint32_t top = 0;
+
+        if (!isHeader[h]) {
+            continue;
+        }
+        body[h] = calloc(n, 1);
+        work = malloc(n * sizeof(*work));
+        if (!body[h] || !work) {
+            free(work);
+            unbounded(f, "%s", "out of memory");
+            goto freeBodies;
+        }
+        body[h][h] = 1;
+        size[h] = 1;
+        for (uint32_t e = 0; e < g->edgeCount; e++) {
+            const struct Edge* x = &g->edges[e];
+            if (x->to == h && idom[x->from] != WCET_EXIT && dominates(idom, h, x->from) && !body[h][x->from]) {
+                body[h][x->from] = 1;
+                size[h]++;
+                work[top++] = x->from;
+            }
+        }
+        while (top) {
+            uint32_t b = work[--top];
+            for (uint32_t e = 0; e < g->edgeCount; e++) {
+                const struct Edge* x = &g->edges[e];
+                if (x->to == b && idom[x->from] != WCET_EXIT && !body[h][x->from]) {
+                    body[h][x->from] = 1;
+                    size[h]++;
+                    work[top++] = x->from;
+                }
+            }
+        }
+        free(work);
+    }
+
+    inside = malloc(g->nodeSize);
+    dist = malloc(g->nodeSize * sizeof(*dist));
+    if (!inside || !dist) {
+        unbounded(f, "%s", "out of memory");
+        goto freeBodies;
+    }
+    for (;;) {
+        uint32_t h = WCET_EXIT;
+        uint64_t iteration = 0;
+        uint32_t bound = 0;
+        int automatic = 0;
+        uint32_t node;
+
+        for (uint32_t b = 0; b < n; b++) { // Smallest body left: innermost
+            if (body[b] && (h == WCET_EXIT || size[b] < size[h])) {
+                h = b;
+            }
+        }
+        if (h == WCET_EXIT) {
+            break;
+        }
+
+        // Nodes of the body as it stands, inner loops already folded
+        memset(inside, 0, g->nodeSize);
+        for (uint32_t b = 0; b < n; b++) {
+            if (body[h][b]) {
+                inside[g->rep[b]] = 1;
+            }
+        }
+        if (longest(g, inside, h, dist) < 0) {
+            locName(w, g->start[h], where, sizeof(where));
+            unbounded(f, "irreducible loop at %s", where);
+            free(body[h]);
+            body[h] = NULL;
+            continue;
+        }
+        uint16_t branch = g->start[h];
+        for (uint32_t e = 0; e < g->edgeCount; e++) {
+            const struct Edge* x = &g->edges[e];
+            if (x->alive && x->to == h && inside[x->from] && dist[x->from] != UINT64_MAX) {
+                if (dist[x->from] + x->cost > iteration) {
+                    iteration = dist[x->from] + x->cost;
+                }
+                if (x->from < n) { // Last instruction of a plain block: the back branch
+                    uint16_t pc = g->start[x->from];
+                    struct Insn in;
+                    for (;;) {
+                        classify(w->avr->flash, pc, &in);
+                        if (in.kind != OP_PLAIN && in.kind != OP_CALL) {
+                            break;
+                        }
+                        pc = (pc + in.words) & WORD_MASK;
+                    }
+                    branch = pc;
+                }
+            }
+        }
+
+        // Bound: given, else a countdown
+        for (int i = 0; i < w->boundCount; i++) {
+            if (boundMatches(w, &w->bounds[i], g->start[h])) {
+                bound = w->bounds[i].count;
+                w->bounds[i].used = 1;
+            }
+        }
+        if (!bound && (bound = countdownBound(w, g, h, branch)) != 0) {
+            automatic = 1;
+        }
+        if (f->loopCount < WCET_MAX_LOOPS) {
+            struct LoopInfo* l = &f->loops[f->loopCount++];
+            l->header = g->start[h];
+            l->bound = bound;
+            l->automatic = (uint8_t)automatic;
+            l->iteration = iteration;
+        }
+        if (!bound) {
+            locName(w, g->start[h], where, sizeof(where));
+            unbounded(f, "loop at %s has no bound", where);
+        }
+
+        // Fold: one node whose exits cost (bound - 1) iterations plus the way out
+        node = g->nodeCount++;
+        g->start[node] = g->start[h];
+        for (uint32_t e = 0, count = g->edgeCount; e < count; e++) {
+            struct Edge* x = &g->edges[e];
+            if (!x->alive) {
+                continue;
+            }
+            if (inside[x->from]) {
+                if ((x->to == WCET_EXIT || !inside[x->to]) && dist[x->from] != UINT64_MAX) {
+                    uint64_t cost = (bound ? bound - 1 : 0) * iteration + dist[x->from] + x->cost;
+                    if (addEdge(g, node, x->to, cost) < 0) {
+                        unbounded(f, "%s", "out of memory");
+                        goto freeBodies;
+                    }
+                    x = &g->edges[e];
+                }
+                x->alive = 0;
+            } else if (x->to == h) {
+                x->to = node;
+            }
+        }
+        for (uint32_t b = 0; b < n; b++) {
+            if (body[h][b]) {
+                g->rep[b] = node;
+            }
+        }
+        free(body[h]);
+        body[h] = NULL;
+    }
+
+    // What is left is acyclic: longest path from the entry to a return
+    memset(inside, 1, g->nodeSize);
+    if (longest(g, inside, g->rep[0], dist) < 0) {
+        unbounded(f, "%s", "cycle left after folding loops");
+    } else {
+        uint64_t best = 0;
+        int returns = 0;
+        for (uint32_t e = 0; e < g->edgeCount; e++) {
+            const struct Edge* x = &g->edges[e];
+            if (x->alive && x->to == WCET_EXIT && dist[x->from] != UINT64_MAX) {
+                returns = 1;
+                if (dist[x->from] + x->cost > best) {
+                    best = dist[x->from] + x->cost;
+                }
+            }
+        }
+        if (!returns) {
+            unbounded(f, "%s", "never returns");
+        }
+        f->wcet = best + (f->vector >= 0 ? AVR_IRQ_CYCLES : 0);
+    }
+
+freeBodies:
+    for (uint32_t b = 0; b < n; b++) {
+        free(body[b]);
+    }
+    free(body);
+done:
+    free(idom);
+    free(isHeader);
+    free(size);
+    free(inside);
+    free(dist);
+}
+
+static void printBlocks(const struct Wcet* w, const struct Func* f, const struct Graph* g)
+{
+    char name[64];
+    char where[64];
+
+    funcName(w, f, name, sizeof(name));
+    printf("%s: %u blocks\n", name, g->blockCount);
+    for (uint32_t b = 0; b < g->blockCount; b++) {
+        locName(w, g->start[b], where, sizeof(where));
+        printf("  %-24s", where);
+        for (uint32_t e = 0; e < g->edgeCount; e++) {
+            const struct Edge* x = &g->edges[e];
+            if (x->from != b) {
+                continue;
+            }
+            if (x->to == WCET_EXIT) {
+                printf("  return %llu", (unsigned long long)x->cost);
+            } else {
+                locName(w, g->start[x->to], where, sizeof(where));
+                printf("  %s %llu", where, (unsigned long long)x->cost);
+            }
+        }
+        printf("\n");
+    }
+}
+
+// Bound of function 'index' (memoised); recursion shows up as state 1
+static struct Func* analyse(struct Wcet* w, int index)
+{
+    struct Func* f = &w->funcs[index];
+    struct Graph* g;
+
+    if (f->state != 0) {
+        return f;
+    }
+    f->state = 1;
+    f->bounded = 1;
+    g = calloc(1, sizeof(*g));
+    if (!g) {
+        unbounded(f, "%s", "out of memory");
+    } else {
+        explore(w, index, g);
+        if (buildGraph(w, index, g) < 0) {
+            unbounded(&w->funcs[index], "%s", "out of memory");
+        } else {
+            if (w->verbose) {
+                printBlocks(w, &w->funcs[index], g);
+            }
+            w->funcs[index].blocks = g->blockCount;
+            solve(w, index, g);
+        }
+        free(g->start);
+        free(g->rep);
+        free(g->edges);
+        free(g);
+    }
+    f = &w->funcs[index];
+    f->state = 2;
+    return f;
+}
+
+//============================================Options========================================
+static int addBound(struct Wcet* w, const char* text)
+{
+    const char* eq = strrchr(text, '=');
+    char loc[64];
+    struct Bound* b;
+
+    if (!eq || eq == text || (size_t)(eq - text) >= sizeof(loc) || w->boundCount == WCET_MAX_BOUNDS) {
+        return -1;
+    }
+    memcpy(loc, text, eq - text);
+    loc[eq - text] = '\0';
+    b = &w->bounds[w->boundCount];
+    memset(b, 0, sizeof(*b));
+    if ((b->count = (uint32_t)strtoul(eq + 1, NULL, 0)) == 0) {
+        return -1;
+    }
+    if (loc[strlen(loc) - 1] == '*') { // Label prefix
+        loc[strlen(loc) - 1] = '\0';
+        if (loc[0] == '\0' || strlen(loc) >= sizeof(b->label)) {
+            return -1;
+        }
+        snprintf(b->label, sizeof(b->label), "%s", loc);
+    } else if (parseLoc(w, loc, &b->header, NULL) < 0) {
+        return -1;
+    }
+    snprintf(b->text, sizeof(b->text), "%s", text);
+    w->boundCount++;
+    return 0;
+}
+
+static int addAssert(struct Wcet* w, const char* text)
+{
+    const char* le = strstr(text, "<=");
+    struct Assert* a;
+
+    if (!le || le == text || (size_t)(le - text) >= sizeof(a->name) || w->assertCount == WCET_MAX_ASSERTS) {
+        return -1;
+    }
+    a = &w->asserts[w->assertCount++];
+    memcpy(a->name, text, le - text);
+    a->name[le - text] = '\0';
+    a->limit = strtoull(le + 2, NULL, 0);
+    return 0;
+}
+
+// Budget file: "bound loc=n" and "assert func<=cycles" lines; blanks are ignored
+static int loadBudget(struct Wcet* w, const char* path)
+{
+    FILE* in = fopen(path, "r");
+    char line[256];
+    int lineNo = 0;
+
+    if (!in) {
+        perror(path);
+        return -1;
+    }
+    while (fgets(line, sizeof(line), in)) {
+        char text[256];
+        size_t n = 0;
+        int ok;
+
+        lineNo++;
+        if (strchr(line, '#')) {
+            *strchr(line, '#') = '\0';
+        }
+        for (char* c = line; *c; c++) { // "bound" / "assert", then the rest without spaces
+            if (*c != ' ' && *c != '\t' && *c != '\r' && *c != '\n') {
+                text[n++] = *c;
+            }
+        }
+        text[n] = '\0';
+        if (n == 0) {
+            continue;
+        }
+        if (!strncmp(text, "bound", 5)) {
+            ok = addBound(w, text + 5) == 0;
+        } else if (!strncmp(text, "assert", 6)) {
+            ok = addAssert(w, text + 6) == 0;
+        } else {
+            ok = 0;
+        }
+        if (!ok) {
+            fprintf(stderr, "%s:%d: expected 'bound loc=n' or 'assert func<=cycles'\n", path, lineNo);
+            fclose(in);
+            return -1;
+        }
+    }
+    fclose(in);
+    return 0;
+}
+
+static void usage(const char* prog)
+{
+    fprintf(stderr, "usage: %s [-F hz] [-b loc=n] [-a func<=cycles] [-B budget] [-j report.json] [-v]\n"
+                    "          image [function...]\n"
+                    "loc: symbol, symbol+offset, byte address or label* (label prefix) of a loop header;\n"
+                    "functions default to every function symbol and every vector in use\n", prog);
+    exit(2);
+}
+
+// Function named by the user (symbol, vector or address); -1 if unknown
+static int lookup(struct Wcet* w, const char* name)
+{
+    uint16_t word;
+    int vector;
+
+    if (parseLoc(w, name, &word, &vector) < 0) {
+        return -1;
+    }
+    return funcIndex(w, word, vector);
+}
+
+// Default set: function symbols, and vectors that do not lead to the shared bad-interrupt stub
+static void addDefaults(struct Wcet* w)
+{
+    const uint16_t* flash = w->avr->flash;
+    uint16_t targets[AVR_VECTOR_COUNT];
+    uint16_t common = 0;
+    int best = 0;
+
+    for (int v = 1; v < AVR_VECTOR_COUNT; v++) {
+        struct Insn in;
+        classify(flash, (uint16_t)(v * 2), &in);
+        targets[v] = in.kind == OP_JUMP ? in.target : 0xFFFF;
+    }
+    for (int v = 1; v < AVR_VECTOR_COUNT; v++) {
+        int count = 0;
+        for (int u = 1; u < AVR_VECTOR_COUNT; u++) {
+            count += targets[u] == targets[v];
+        }
+        if (count > best) {
+            best = count;
+            common = targets[v];
+        }
+    }
+    for (int v = 1; v < AVR_VECTOR_COUNT; v++) {
+        if (targets[v] != 0xFFFF && (targets[v] != common || best == 1)) {
+            funcIndex(w, (uint16_t)(v * 2), v);
+        }
+    }
+    for (uint32_t i = 0; i < w->syms.count; i++) {
+        if (w->syms.syms[i].rank == 3) { // SYM_RANK_FUNC in elf.c
+            funcIndex(w, (uint16_t)(w->syms.syms[i].addr / 2), -1);
+        }
+    }
+}
+
+static void writeJson(struct Wcet* w, const char* path, const char* image, double fCpu)
+{
+    FILE* out = fopen(path, "w");
+    char name[64];
+    char where[64];
+
+    if (!out) {
+        perror(path);
+        return;
+    }
+    fprintf(out, "{\n  \"image\": \"%s\",\n  \"fCpu\": %.0f,\n  \"functions\": [", image, fCpu);
+    for (int i = 0; i < w->funcCount; i++) {
+        const struct Func* f = &w->funcs[i];
+
+        funcName(w, f, name, sizeof(name));
+        fprintf(out, "%s\n    {\"name\": \"%s\", \"address\": %u, \"vector\": %d, ", i ? "," : "",
+                name, f->entry * 2u, f->vector);
+        if (f->bounded) {
+            fprintf(out, "\"wcet\": %llu, \"us\": %.3f, ", (unsigned long long)f->wcet, f->wcet * 1e6 / fCpu);
+        } else {
+            fprintf(out, "\"wcet\": null, \"reason\": \"%s\", ", f->reason);
+        }
+        fprintf(out, "\"blocks\": %u, \"loops\": [", f->blocks);
+        for (int l = 0; l < f->loopCount; l++) {
+            locName(w, f->loops[l].header, where, sizeof(where));
+            fprintf(out, "%s{\"header\": \"%s\", \"bound\": %u, \"source\": \"%s\", \"iteration\": %llu}",
+                    l ? ", " : "", where, f->loops[l].bound,
+                    !f->loops[l].bound ? "missing" : f->loops[l].automatic ? "countdown" : "user",
+                    (unsigned long long)f->loops[l].iteration);
+        }
+        fprintf(out, "], \"calls\": [");
+        for (int c = 0; c < f->calleeCount; c++) {
+            funcName(w, &w->funcs[f->callees[c]], name, sizeof(name));
+            fprintf(out, "%s\"%s\"", c ? ", " : "", name);
+        }
+        fprintf(out, "]}");
+    }
+    fprintf(out, "\n  ],\n  \"assertions\": [");
+    for (int i = 0; i < w->assertCount; i++) {
+        const struct Assert* a = &w->asserts[i];
+        int index = lookup(w, a->name);
+        const struct Func* f = index >= 0 ? &w->funcs[index] : NULL;
+
+        fprintf(out, "%s\n    {\"function\": \"%s\", \"limit\": %llu, ", i ? "," : "", a->name,
+                (unsigned long long)a->limit);
+        if (f && f->bounded) {
+            fprintf(out, "\"wcet\": %llu, \"pass\": %s}", (unsigned long long)f->wcet,
+                    f->wcet <= a->limit ? "true" : "false");
+        } else {
+            fprintf(out, "\"wcet\": null, \"pass\": false}");
+        }
+    }
+    fprintf(out, "\n  ]\n}\n");
+    fclose(out);
+}
+
+//============================================Main Code========================================
+int main(int argc, char** argv)
+{
+    static struct AvrCore avr; // Only its flash is used
+    static struct Wcet w;
+    const char* budgets[16];
+    int budgetCount = 0;
+    const char* bounds[WCET_MAX_BOUNDS];
+    int boundCount = 0;
+    const char* asserts[WCET_MAX_ASSERTS];
+    int assertCount = 0;
+    const char* jsonPath = NULL;
+    double fCpu = 8000000.0;
+    int failed = 0;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "F:b:a:B:j:v")) != -1) {
+        switch (opt) {
+        case 'F': fCpu = atof(optarg); break;
+        case 'b':
+            if (boundCount == WCET_MAX_BOUNDS) {
+                usage(argv[0]);
+            }
+            bounds[boundCount++] = optarg;
+            break;
+        case 'a':
+            if (assertCount == WCET_MAX_ASSERTS) {
+                usage(argv[0]);
+            }
+            asserts[assertCount++] = optarg;
+            break;
+        case 'B':
+            if (budgetCount == 16) {
+                usage(argv[0]);
+            }
+            budgets[budgetCount++] = optarg;
+            break;
+        case 'j': jsonPath = optarg; break;
+        case 'v': w.verbose = 1; break;
+        default: usage(argv[0]);
+        }
+    }
+    if (optind >= argc || fCpu <= 0) {
+        usage(argv[0]);
+    }
+
+    avrInit(&avr);
+    w.avr = &avr;
+    if (elfIsFile(argv[optind])) {
+        if (elfLoad(&avr, argv[optind], &w.syms) < 0) {
+            return 1;
+        }
+    } else if (avrLoadHex(&avr, argv[optind]) < 0) {
+        return 1;
+    }
+
+    // Symbols are known now, so locations can be resolved
+    for (int i = 0; i < budgetCount; i++) {
+        if (loadBudget(&w, budgets[i]) < 0) {
+            return 2;
+        }
+    }
+    for (int i = 0; i < boundCount; i++) {
+        if (addBound(&w, bounds[i]) < 0) {
+            fprintf(stderr, "bad loop bound '%s'\n", bounds[i]);
+            return 2;
+        }
+    }
+    for (int i = 0; i < assertCount; i++) {
+        if (addAssert(&w, asserts[i]) < 0) {
+            fprintf(stderr, "bad assertion '%s'\n", asserts[i]);
+            return 2;
+        }
+    }
+    if (optind + 1 < argc) {
+        for (int i = optind + 1; i < argc; i++) {
+            if (lookup(&w, argv[i]) < 0) {
+                fprintf(stderr, "unknown function '%s'\n", argv[i]);
+                return 2;
+            }
+        }
+    } else {
+        addDefaults(&w);
+    }
+    for (int i = 0; i < w.assertCount; i++) {
+        if (lookup(&w, w.asserts[i].name) < 0) {
+            fprintf(stderr, "unknown function '%s' in assertion\n", w.asserts[i].name);
+            return 2;
+        }
+    }
+    for (int i = 0; i < w.funcCount; i++) { // Callees are appended as they are found
+        analyse(&w, i);
+    }
+
+    printf("%s: worst-case cycles at %.0f Hz\n", argv[optind], fCpu);
+    printf("  %-24s %8s %10s %12s  %s\n", "function", "address", "cycles", "us", "loops / reason");
+    for (int i = 0; i < w.funcCount; i++) {
+        const struct Func* f = &w.funcs[i];
+        char name[64];
+        char where[64];
+
+        funcName(&w, f, name, sizeof(name));
+        if (f->bounded) {
+            printf("  %-24s   0x%04x %10llu %12.3f ", name, f->entry * 2u,
+                   (unsigned long long)f->wcet, f->wcet * 1e6 / fCpu);
+            for (int l = 0; l < f->loopCount; l++) {
+                locName(&w, f->loops[l].header, where, sizeof(where));
+                printf(" %s x%u%s", where, f->loops[l].bound, f->loops[l].automatic ? " (countdown)" : "");
+            }
+            printf("\n");
+        } else {
+            printf("  %-24s   0x%04x %10s %12s  %s\n", name, f->entry * 2u, "unbounded", "-", f->reason);
+        }
+    }
+    for (int i = 0; i < w.boundCount; i++) {
+        if (!w.bounds[i].used) {
+            printf("  bound %s matches no loop header\n", w.bounds[i].text);
+        }
+    }
+    for (int i = 0; i < w.assertCount; i++) {
+        const struct Assert* a = &w.asserts[i];
+        const struct Func* f = &w.funcs[lookup(&w, a->name)];
+        int pass = f->bounded && f->wcet <= a->limit;
+
+        if (f->bounded) {
+            printf("  %s %s <= %llu: %llu cycles\n", pass ? "PASS" : "FAIL", a->name,
+                   (unsigned long long)a->limit, (unsigned long long)f->wcet);
+        } else {
+            printf("  FAIL %s <= %llu: unbounded\n", a->name, (unsigned long long)a->limit);
+        }
+        failed |= !pass;
+    }
+    if (jsonPath) {
+        writeJson(&w, jsonPath, argv[optind], fCpu);
+    }
+    symFree(&w.syms);
+    return failed ? 1 : 0;
+}
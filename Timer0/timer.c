@@ -9,15 +9,15 @@
 
 //TCCR0- timer/counter control register
 //    7      6      5        4       3       2       1      0
-//  FOC0 | WGM00 | WGM01 | COM00 | COM01 | CS02  | CS01  | CS00 |      addres 0x53
+//  FOC0 | WGM00 | COM01 | COM00 | WGM01 | CS02  | CS01  | CS00 |      addres 0x53
 
 
 //WGM0[1:0] - Waveform Generation Mode
 //             |  WGM01 | WGM00 |
 // Normal mode:      0  |   0 
-// CTC mode:         0  |   1
-// Fast PWM mode:    1  |   0
-// PWM:              1  |   1
+// PWM (phase corr): 0  |   1
+// CTC mode:         1  |   0
+// Fast PWM mode:    1  |   1
 
 
 // COM0[1:0] - Compare Output Mode
@@ -46,12 +46,13 @@
 
 //TIMSK - Timer/Counter Interrupt Mask Register
 //    7      6         5        4       3       2       1       0
-//  OCIE2 | TOIE2 | OCIE1B | OCIE1A | TOIE1 | OCIE0 | TOIE0 | TOIE2 |      address 0x59
+//  OCIE2 | TOIE2 | TICIE1 | OCIE1A | OCIE1B | TOIE1 | OCIE0 | TOIE0 |      address 0x59
 
 //OCIE0  - Output Compare Match Interrupt Enable for Timer/Counter0
 //TOIE0  - Timer/Counter0 Overflow Interrupt Enable
 //OCIE1A - Output Compare Match A Interrupt Enable for Timer/Counter1
 //OCIE1B - Output Compare Match B Interrupt Enable for Timer/Counter1
+//TICIE1 - Timer/Counter1 Input Capture Interrupt Enable
 //TOIE1  - Timer/Counter1 Overflow Interrupt Enable
 //OCIE2  - Output Compare Match Interrupt Enable for Timer/Counter2
 //TOIE2  - Timer/Counter2 Overflow Interrupt Enable
@@ -60,12 +61,13 @@
 
 //TIFR - Timer/Counter Interrupt Flag Register
 //    7      6      5      4      3      2      1      0       
-//  OCF2 | TOV2 | OCF1B | OCF1A | TOV1 | OCF0 | TOV0 | TOV2 |      address 0x58
+//  OCF2 | TOV2 | ICF1 | OCF1A | OCF1B | TOV1 | OCF0 | TOV0 |      address 0x58
 
 //OCF0  - Output Compare Flag for Timer/Counter0
 //TOV0  - Timer/Counter0 Overflow Flag
 //OCF1A - Output Compare Flag A for Timer/Counter1  
 //OCF1B - Output Compare Flag B for Timer/Counter1
+//ICF1  - Input Capture Flag for Timer/Counter1
 //TOV1  - Timer/Counter1 Overflow Flag
 //OCF2  - Output Compare Flag for Timer/Counter2
 //TOV2  - Timer/Counter2 Overflow Flag
@@ -76,59 +78,46 @@
 
 //============================================Defines========================================
 #define F_CPU 8000000UL // Define CPU frequency as 8 MHz
-#define TIMER0_PRESCALER 64 // Define prescaler for Timer0
 #define delayTime 1000 // Define delay time in milliseconds
 // This will toggle an LED every 1000 milliseconds (1 second)
 
+#include "../Library/timebase.h"  // Timer0 CTC tick and lock-free millis()
+#include "../Library/softtimer.h" // Periodic callbacks dispatched from the main loop
+
 //============================================global variables========================================
 
-unsigned long previous = 0;
-unsigned long millisCounter = 0;
+struct SoftTimer blinkTimer; // Toggles PB1 every delayTime milliseconds
 
 
 //============================================ISRs========================================
-// Timer0 overflow interrupt service routine
+// Timer0 compare match interrupt service routine, fires every 1 ms
 ISR(TIMER0_COMP_vect) {
-    millisCounter++;
+    timebaseTick();
 }
 
 //============================================functions========================================
 // Timer0 initialization function
-// This function sets up Timer0 in CTC mode with a prescaler of 64
+// This function sets up Timer0 in CTC mode for a 1 ms tick (TIMER0_PRESCALER and TIMER0_OCR0
+// from timer0config.h)
 void initTimer0(void)
 { 
-    //set output compare mode to CTC (Clear Timer on Compare Match) 
-    TCCR0 |= (1<<WGM01);
-    TCCR0 &= ~(1<<WGM00); // CTC mode
-
-    //set the prescaler to 64
-    TCCR0 |= (1<<CS01) | (1<<CS00); // Set CS02 and CS01 to 1, CS00 remains 0
-
-    //enable the timer overflow interrupt
-    TIMSK |= (1<<OCIE0); // Enable Output Compare Match Interrupt for Timer0
-
-
-    //set the output compare register to 125
-    OCR0 = 124;
-    TCNT0 = 0; 
-    // This will generate an interrupt every 1 ms with a 16 MHz clock and prescaler of 64
-    //OCR0 = 1-(interrupt_CPU*time)/prescaler
-    //125 = 1 - (8000000 * 0.001) / 64
+    // CTC mode and compare match interrupt enabled. The prescaler and OCR0 are picked
+    // at compile time by timer0config.h from F_CPU:
+    // OCR0 = (F_CPU / (prescaler * 1000)) - 1
+    // 124 = (8000000 / (64 * 1000)) - 1
+    timebaseInit();
 
 }
 
-//millis function
-unsigned long millis(void){
-
-    unsigned long ms;
-
-    // Disable interrupts to ensure atomic access to millisCounter
-    cli();
-    ms = millisCounter;
-    sei(); // Re-enable interrupts
-
-    return ms;
+// millis() comes from timebase.h: it reads millisCounter twice until both reads agree,
+// so the main loop never disables interrupts and never delays TIMER0_COMP_vect.
+// softtimer.h keeps the deadlines, so main() no longer compares millis() against 'previous'.
 
+// Soft-timer callback, runs from softTimerPoll() in the main loop
+void blink(struct SoftTimer* timer)
+{
+    (void)timer;
+    PORTB ^= (1 << 1); // Toggle PB1
 }
 
 
@@ -144,13 +133,12 @@ int main(void){
 
     sei(); // Enable global interrupts
 
-    previous = millis(); // Initialize previous time
+    softTimerInit();
+    softTimerStart(&blinkTimer, delayTime, delayTime, blink); // Periodic, phase kept by the wheel
     while (1)
     {
-        if(millis() - previous >= delayTime){
-            PORTB ^= (1 << 1); // Toggle PB1
-            previous = millis(); // Update previous time
-        }
+        softTimerPoll(); // Run every callback that came due
+        softTimerIdle(); // Sleep (SLEEP_MODE_IDLE) until the next 1 ms tick
     }
     
 }
\ No newline at end of file
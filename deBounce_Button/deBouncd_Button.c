@@ -4,7 +4,13 @@
 // Target microcontroller: ATmega32A
 // Description: This code manages a button connected to pin PD6 (active-low with pull-up resistor)
 //              and toggles an LED on pin PB1 when the button is pressed. The button is active-low
-//              (pressed = 0, released = 1). Debouncing is handled using Timer0 interrupts.
+//              (pressed = 0, released = 1). Debouncing is handled using Timer0 interrupts:
+//              the 1 ms tick samples the button, feeds the debouncer's press/release edges
+//              to the gesture engine and posts press/release/click/long-press events to a
+//              lock-free queue. The main loop sleeps in idle mode until an interrupt and only
+//              drains the queue. Button gestures and a once-per-second count of main loop
+//              passes (wake-ups) are sent as binary trace records on the USART (TXD, PD1),
+//              together with the tick interrupt latency statistics of that second.
 // Author: [Mobin Alijani]
 // Date created: 2023-10-01
 // Date modified: 2025-06-04
@@ -18,18 +24,33 @@
 //============================================Defines========================================
 // Constants for hardware configuration and program logic
 #define F_CPU 8000000UL      // CPU frequency set to 8 MHz
-#define TIMER0_PRESCALER 64  // Prescaler for Timer0
 #define delayTime 50         // Debounce delay time in milliseconds
-#define LED_Toggle() PORTB ^= (1 << PB1) // Macro to toggle LED on pin PB1
+#define reportPeriod 1000    // Milliseconds between two LOOPS trace records
+#define IRQ_STATS 1          // Measure tick latency and interrupts-off windows (irqstats.h)
+#define LED_Toggle() LedToggle() // Toggle the LED on pin PB1
+
+// Debounced edges returned by updateButton(), in the gesture engine's GESTURE_EDGE_* codes
+#define BUTTON_NONE     GESTURE_EDGE_NONE
+#define BUTTON_PRESSED  GESTURE_EDGE_PRESS
+#define BUTTON_RELEASED GESTURE_EDGE_RELEASE
+
+#include "../Library/timebase.h"   // Timer0 1 ms tick, millisCounter and lock-free millis()
+#include "../Library/eventqueue.h" // ISR -> main loop event queue
+#include "../Library/pin.h"        // Compile-time pins: single sbi/cbi/sbis instructions
+#include "../Library/gesture.h"    // Click, double-click, long-press and repeat detection
+#include "../Library/trace.h"      // Binary event records over the interrupt-driven USART
+
+PIN_DEFINE(Button, D, PD6) // Button on PD6, active-low with pull-up
+PIN_DEFINE(Led, B, PB1)    // LED on PB1
 
 
 //============================================Global Variables========================================
 // Global variables and structures used throughout the program
-volatile unsigned long millisCounter = 0; // Millisecond counter, shared with ISR
-                                         // 'volatile' ensures the compiler doesn't optimize
-                                         // accesses to this variable, as it's modified in an ISR.
+// millisCounter lives in timebase.h; it is volatile and only written by the ISR below.
 
 // Structure to manage a debounced button
+// The pin itself is not stored here: the caller samples it through a PIN_DEFINE accessor,
+// which compiles to one sbis/sbic instead of loading a register pointer and shifting a mask.
 struct DebouncedButton
 {
     unsigned long previous;        // Previous timestamp (milliseconds) for tracking changes
@@ -37,48 +58,63 @@ struct DebouncedButton
     unsigned char lastButtonState; // Previous button state for detecting changes
     unsigned char ButtonState;     // Debounced button state (0 or 1)
     unsigned char debounceDelay;   // Debounce delay in milliseconds
-    volatile unsigned char* port;  // Pointer to PORT register (e.g., &PORTD)
-    volatile unsigned char* pin;   // Pointer to PIN register (e.g., &PIND)
-    volatile unsigned char* DDRx;  // Pointer to DDR register (e.g., &DDRD)
-    unsigned char buttonPin;       // Button pin number (e.g., PD6)
 
 } Button1; // Instance of the structure for the button on PD6
 
+struct EventQueue ButtonEvents; // GESTURE_* bit masks, produced by the ISR, consumed by main()
+
+// Gesture timing in milliseconds: long press, double-click window, repeat start/min/step
+static const struct GestureConfig ButtonTiming = { 600, 250, 400, 50, 50 };
+struct Gesture Button1Gesture; // Gesture state of the button on PD6
+
+unsigned char updateButton(struct DebouncedButton* btn, unsigned char pressed,
+                           unsigned long now); // Defined below
+
 //============================================Interrupt Service Routines (ISRs)========================================
 // Timer0 Compare Match ISR
-// Triggered every 1ms to increment the millisecond counter
+// Triggered every 1ms to increment the millisecond counter and sample the button
 ISR(TIMER0_COMP_vect) {
-    millisCounter++; // Increment the millisecond counter
+    unsigned char edge;
+    unsigned char events;
+
+    irqStatsTickEntry(); // Entry latency from TCNT0, must come first
+    timebaseTick();      // Increment the millisecond counter
+
+    // Interrupts are off inside the ISR, so millisCounter can be read directly.
+    // Active-low: the button is pressed when PD6 reads 0.
+    edge = updateButton(&Button1, !ButtonRead(), millisCounter);
+
+    // The gesture engine times clicks and long presses from the debounced edges
+    events = gestureEdge(&Button1Gesture, edge);
+    if (events) {
+        eventQueuePush(&ButtonEvents, events); // Hand the gestures to the main loop
+    }
+    irqStatsMaskEnd(); // Interrupts come back on with the RETI below
+}
+
+// USART Data Register Empty ISR
+// Moves the next queued trace byte into UDR
+ISR(USART_UDRE_vect) {
+    irqStatsMaskBegin(); // Also delays the tick, so it counts as an interrupts-off window
+    uartUdreIsr();
+    irqStatsMaskEnd();
 }
 
 //============================================Functions========================================
 // Initialize Timer0
-// Configures Timer0 in CTC mode with a prescaler of 64 to generate 1ms interrupts
+// Configures Timer0 in CTC mode to generate 1ms interrupts
 void initTimer0(void)
 {
-    TCCR0 = 0; // Clear Timer0 control register
-
-    // Set CTC mode (Clear Timer on Compare Match)
-    TCCR0 |= (1<<WGM01);  // Enable CTC mode
-    TCCR0 &= ~(1<<WGM00); // Ensure WGM00 is cleared for CTC mode
-
-    // Set prescaler to 64
-    TCCR0 |= (1<<CS01) | (1<<CS00); // CS01 and CS00 set for prescaler 64
-
-    // Enable Output Compare Match Interrupt
-    TIMSK |= (1<<OCIE0); // Enable Timer0 compare match interrupt
-
-    // Set output compare register for 1ms interrupts
+    // CTC mode, compare match interrupt enabled; timer0config.h picks the prescaler
+    // and OCR0 from F_CPU at compile time
     // Formula: OCR0 = (F_CPU / (Prescaler * Desired_Frequency)) - 1
     //          = (8000000 / (64 * 1000)) - 1 = 124
-    OCR0 = 124;
-    TCNT0 = 0; // Initialize Timer0 counter to 0
+    timebaseInit();
 }
 
 // Initialize button configuration
-// Sets up the button pin as input with pull-up and initializes the button structure
-void initButton(struct DebouncedButton* btn, volatile unsigned char* port, volatile unsigned char* pin,
-                volatile unsigned char* DDRx, unsigned char buttonPin, unsigned char debounceDelay)
+// Initializes the button structure; the pin is configured with its PIN_DEFINE accessors
+void initButton(struct DebouncedButton* btn, unsigned char debounceDelay)
 {
     // Initialize button structure fields
     btn->previous = 0;          // Clear previous timestamp
@@ -88,27 +124,11 @@ void initButton(struct DebouncedButton* btn, volatile unsigned char* port, volat
 
     // Assign configuration parameters
     btn->debounceDelay = debounceDelay; // Set debounce delay
-    btn->port = port;                   // Set PORT register pointer
-    btn->pin = pin;                     // Set PIN register pointer
-    btn->DDRx = DDRx;                   // Set DDR register pointer
-    btn->buttonPin = buttonPin;         // Set button pin number
-
-    // Configure button pin as input with pull-up resistor
-    *DDRx &= ~(1 << buttonPin); // Clear DDR bit to set pin as input
-    *port |= (1 << buttonPin);  // Set PORT bit to enable pull-up resistor
-
 }
 
 // Get current time in milliseconds
-// Returns the value of millisCounter with atomic access
-unsigned long millis(void)
-{
-    unsigned long ms;      // Temporary variable to store millisCounter
-    cli();                 // Disable interrupts for atomic access
-    ms = millisCounter;    // Read millisCounter
-    sei();                 // Re-enable interrupts
-    return ms;             // Return millisecond count
-}
+// millis() is provided by timebase.h. It reads millisCounter twice and retries until both
+// reads agree, so main() never disables interrupts or delays the 1 ms tick.
 
 // Check if the specified delay has elapsed
 // Handles timer overflow for reliable timing
@@ -120,33 +140,28 @@ unsigned char isTimeElapsed(unsigned long current, unsigned long previous, unsig
 }
 
 // Update button state with debouncing
-// Reads the button state, applies debouncing, and returns 1 if button is pressed
-unsigned char updateButton(struct DebouncedButton* btn)
+// Called once per 1 ms tick with the sampled level (1 = pressed) and the current time.
+// Restarts the debounce window on every change and returns BUTTON_PRESSED / BUTTON_RELEASED
+// once the new level has been stable for debounceDelay milliseconds, BUTTON_NONE otherwise.
+unsigned char updateButton(struct DebouncedButton* btn, unsigned char pressed, unsigned long now)
 {
-    // Read button state (active-low: 0 = pressed, 1 = released)
-    btn->ReadButtonState = (*(btn->pin) & (1 << btn->buttonPin)) ? 0 : 1;
-    
+    btn->ReadButtonState = pressed; // Current (undebounced) button state
 
-    // Detect button state change
+    // Detect button state change (bounce): restart the debounce window
     if (btn->ReadButtonState != btn->lastButtonState) {
-        btn->previous = millis(); // Record time of state change
+        btn->previous = now;                         // Record time of state change
+        btn->lastButtonState = btn->ReadButtonState; // Update last button state
+        return BUTTON_NONE;
     }
 
-    // Check if debounce delay has passed or timer overflow occurred
-    if (isTimeElapsed(millis(), btn->previous, btn->debounceDelay))
+    // Accept the new level once it has been stable for the debounce delay
+    if (btn->ButtonState != btn->ReadButtonState &&
+        isTimeElapsed(now, btn->previous, btn->debounceDelay))
     {
-        // Update debounced state if changed
-        if (btn->ButtonState != btn->ReadButtonState)
-        {
-            btn->ButtonState = btn->ReadButtonState; // Update debounced state
-            if (btn->ButtonState) { // Button pressed (active-low)
-                return 1; // Signal button press
-            }
-        }
-        btn->previous = millis(); // Update previous time
+        btn->ButtonState = btn->ReadButtonState; // Update debounced state
+        return btn->ButtonState ? BUTTON_PRESSED : BUTTON_RELEASED;
     }
-    btn->lastButtonState = btn->ReadButtonState; // Update last button state
-    return 0; // No button press detected
+    return BUTTON_NONE; // No edge detected
 }
 
 //============================================Main Code========================================
@@ -154,24 +169,59 @@ unsigned char updateButton(struct DebouncedButton* btn)
 int main(void)
 {
     initTimer0(); // Initialize Timer0 for 1ms interrupts
+    irqStatsInit(); // Timer1 runs as the reference for lost ticks (nothing without IRQ_STATS)
 
     // Initialize button on PD6 with pull-up resistor
-    initButton(&Button1, &PORTD, &PIND, &DDRD, PD6, delayTime);
+    ButtonInputPullup(); // cbi DDRD, 6 / sbi PORTD, 6
+    initButton(&Button1, delayTime);
+    gestureInit(&Button1Gesture, &ButtonTiming);
 
     // Configure LED pin as output
-    DDRB |= (1 << 1);  // Set PB1 as output
-    PORTB &= ~(1 << 1); // Initialize LED off
-
-    sei(); // Enable global interrupts
+    LedOutput(); // Set PB1 as output
+    LedLow();    // Initialize LED off
 
     Button1.previous = millis(); // Initialize previous timestamp
 
-    // Main loop
+    traceInit(); // 38400 8N1, starts the stream with a SYNC record
+    sei();       // Enable global interrupts
+
+    unsigned long lastReport = millis();
+    unsigned long loops = 0;
+    uint16_t reportedDrops = 0;
+
+    // Main loop: the ISR does all sampling, here we only drain its events and sleep
     while (1)
     {
-        // Check for button press and toggle LED if pressed
-        if (updateButton(&Button1)) {
-            LED_Toggle();
+        unsigned char events;
+
+        // Sleep until the next interrupt (at most 1 ms). The queue is checked with interrupts
+        // off, so an event posted just before the SLEEP cannot wait a whole tick.
+        cli();
+        if (eventQueueEmpty(&ButtonEvents)) {
+            timebaseIdle(); // Enables interrupts, then sleeps
+        }
+        sei();
+
+        // Toggle the LED on every debounced press; the other GESTURE_* bits
+        // (click, double-click, long press, repeat) are available here as well
+        while (eventQueuePop(&ButtonEvents, &events)) {
+            if (events & GESTURE_PRESS) {
+                LED_Toggle();
+            }
+            traceEvent(TRACE_BUTTON, events);
+        }
+
+        // Once per report period: how many times this loop ran (woke up)
+        loops++;
+        if (millis() - lastReport >= reportPeriod) {
+            lastReport += reportPeriod;
+            traceEvent(TRACE_LOOPS, loops);
+            loops = 0;
+            traceIrqStats(); // Latency min/max/histogram and longest interrupts-off window
+            if (uartDropped != reportedDrops) { // Only when the trace lost records
+                reportedDrops = uartDropped;
+                traceEvent(TRACE_DROPPED, reportedDrops);
+            }
         }
     }
 }